@@ -0,0 +1,94 @@
+#include "common/delta_compression.h"
+#include <gtest/gtest.h>
+#include <random>
+
+static std::vector<u8> MakeRandomData(std::mt19937& rng, u32 size)
+{
+  std::vector<u8> data(size);
+  for (u8& value : data)
+    value = static_cast<u8>(rng());
+  return data;
+}
+
+TEST(DeltaCompression, KeyframeRoundTrip)
+{
+  std::mt19937 rng(1234);
+  std::vector<u8> target = MakeRandomData(rng, DeltaCompression::PAGE_SIZE * 3 + 123);
+  std::fill(target.begin() + 100, target.begin() + 5000, 0);
+
+  std::vector<u8> delta;
+  DeltaCompression::Encode(&delta, nullptr, 0, target.data(), static_cast<u32>(target.size()));
+
+  // a keyframe doesn't depend on the previous contents or size
+  std::vector<u8> result = MakeRandomData(rng, 17);
+  ASSERT_TRUE(DeltaCompression::Apply(&result, delta.data(), static_cast<u32>(delta.size())));
+  ASSERT_EQ(result, target);
+}
+
+TEST(DeltaCompression, IdenticalDataIsEmpty)
+{
+  std::mt19937 rng(5678);
+  const std::vector<u8> base = MakeRandomData(rng, DeltaCompression::PAGE_SIZE * 8);
+
+  std::vector<u8> delta;
+  DeltaCompression::Encode(&delta, base.data(), static_cast<u32>(base.size()), base.data(),
+                           static_cast<u32>(base.size()));
+  ASSERT_LE(delta.size(), 8u);
+
+  std::vector<u8> result = base;
+  ASSERT_TRUE(DeltaCompression::Apply(&result, delta.data(), static_cast<u32>(delta.size())));
+  ASSERT_EQ(result, base);
+}
+
+TEST(DeltaCompression, SparseChangesRoundTrip)
+{
+  std::mt19937 rng(91011);
+  const std::vector<u8> base = MakeRandomData(rng, DeltaCompression::PAGE_SIZE * 16);
+  std::vector<u8> target = base;
+  for (u32 i = 0; i < 64; i++)
+    target[rng() % target.size()] ^= static_cast<u8>(1 + (rng() % 255));
+
+  std::vector<u8> delta;
+  DeltaCompression::Encode(&delta, base.data(), static_cast<u32>(base.size()), target.data(),
+                           static_cast<u32>(target.size()));
+  ASSERT_LT(delta.size(), DeltaCompression::PAGE_SIZE);
+
+  std::vector<u8> result = base;
+  ASSERT_TRUE(DeltaCompression::Apply(&result, delta.data(), static_cast<u32>(delta.size())));
+  ASSERT_EQ(result, target);
+}
+
+TEST(DeltaCompression, SizeChangeRoundTrip)
+{
+  std::mt19937 rng(1213);
+  const std::vector<u8> small_data = MakeRandomData(rng, DeltaCompression::PAGE_SIZE + 10);
+  const std::vector<u8> large_data = MakeRandomData(rng, DeltaCompression::PAGE_SIZE * 4 + 77);
+
+  std::vector<u8> grow_delta;
+  DeltaCompression::Encode(&grow_delta, small_data.data(), static_cast<u32>(small_data.size()), large_data.data(),
+                           static_cast<u32>(large_data.size()));
+  std::vector<u8> result = small_data;
+  ASSERT_TRUE(DeltaCompression::Apply(&result, grow_delta.data(), static_cast<u32>(grow_delta.size())));
+  ASSERT_EQ(result, large_data);
+
+  std::vector<u8> shrink_delta;
+  DeltaCompression::Encode(&shrink_delta, large_data.data(), static_cast<u32>(large_data.size()), small_data.data(),
+                           static_cast<u32>(small_data.size()));
+  result = large_data;
+  ASSERT_TRUE(DeltaCompression::Apply(&result, shrink_delta.data(), static_cast<u32>(shrink_delta.size())));
+  ASSERT_EQ(result, small_data);
+}
+
+TEST(DeltaCompression, TruncatedDeltaFails)
+{
+  std::mt19937 rng(1415);
+  const std::vector<u8> base = MakeRandomData(rng, DeltaCompression::PAGE_SIZE * 2);
+  const std::vector<u8> target = MakeRandomData(rng, DeltaCompression::PAGE_SIZE * 2);
+
+  std::vector<u8> delta;
+  DeltaCompression::Encode(&delta, base.data(), static_cast<u32>(base.size()), target.data(),
+                           static_cast<u32>(target.size()));
+
+  std::vector<u8> result = base;
+  ASSERT_FALSE(DeltaCompression::Apply(&result, delta.data(), static_cast<u32>(delta.size() - 1)));
+}
@@ -0,0 +1,78 @@
+#include "common/dirty_page_tracker.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+static constexpr u32 PAGE_SHIFT = 12;
+static constexpr u32 PAGE_SIZE = 1u << PAGE_SHIFT;
+static constexpr u32 MEMORY_SIZE = PAGE_SIZE * 8;
+
+TEST(DirtyPageTracker, FirstUpdateCopiesEverything)
+{
+  DirtyPageTracker tracker(MEMORY_SIZE, PAGE_SHIFT);
+  std::vector<u8> memory(MEMORY_SIZE, 0x55);
+
+  DirtyPageTracker::Snapshot snapshot;
+  ASSERT_EQ(tracker.UpdateSnapshot(&snapshot, memory.data()), tracker.GetPageCount());
+  ASSERT_EQ(std::memcmp(snapshot.data.get(), memory.data(), MEMORY_SIZE), 0);
+  ASSERT_EQ(tracker.UpdateSnapshot(&snapshot, memory.data()), 0u);
+}
+
+TEST(DirtyPageTracker, UpdateCopiesOnlyDirtyPages)
+{
+  DirtyPageTracker tracker(MEMORY_SIZE, PAGE_SHIFT);
+  std::vector<u8> memory(MEMORY_SIZE, 0);
+
+  DirtyPageTracker::Snapshot snapshot;
+  tracker.UpdateSnapshot(&snapshot, memory.data());
+
+  memory[PAGE_SIZE * 2 + 7] = 1;
+  tracker.MarkDirty(PAGE_SIZE * 2 + 7);
+  memory[PAGE_SIZE * 5 - 1] = 2;
+  memory[PAGE_SIZE * 5] = 3;
+  tracker.MarkRangeDirty(PAGE_SIZE * 5 - 1, 2);
+
+  ASSERT_EQ(tracker.UpdateSnapshot(&snapshot, memory.data()), 3u);
+  ASSERT_EQ(std::memcmp(snapshot.data.get(), memory.data(), MEMORY_SIZE), 0);
+}
+
+TEST(DirtyPageTracker, MultipleSnapshotsRestore)
+{
+  DirtyPageTracker tracker(MEMORY_SIZE, PAGE_SHIFT);
+  std::vector<u8> memory(MEMORY_SIZE, 0);
+
+  DirtyPageTracker::Snapshot first, second;
+  tracker.UpdateSnapshot(&first, memory.data());
+  const std::vector<u8> first_memory = memory;
+
+  memory[10] = 1;
+  tracker.MarkDirty(10);
+  tracker.UpdateSnapshot(&second, memory.data());
+  const std::vector<u8> second_memory = memory;
+
+  memory[PAGE_SIZE * 3] = 2;
+  tracker.MarkDirty(PAGE_SIZE * 3);
+
+  // going back two snapshots has to undo both writes
+  ASSERT_EQ(tracker.RestoreSnapshot(&first, memory.data()), 2u);
+  ASSERT_EQ(memory, first_memory);
+  ASSERT_EQ(tracker.RestoreSnapshot(&first, memory.data()), 0u);
+
+  // and the restore counts as a write as far as the other snapshot is concerned
+  ASSERT_EQ(tracker.RestoreSnapshot(&second, memory.data()), 2u);
+  ASSERT_EQ(memory, second_memory);
+}
+
+TEST(DirtyPageTracker, MarkAllDirty)
+{
+  DirtyPageTracker tracker(MEMORY_SIZE, PAGE_SHIFT);
+  std::vector<u8> memory(MEMORY_SIZE, 0);
+
+  DirtyPageTracker::Snapshot snapshot;
+  tracker.UpdateSnapshot(&snapshot, memory.data());
+
+  std::fill(memory.begin(), memory.end(), static_cast<u8>(0xAA));
+  tracker.MarkAllDirty();
+  ASSERT_EQ(tracker.UpdateSnapshot(&snapshot, memory.data()), tracker.GetPageCount());
+  ASSERT_EQ(std::memcmp(snapshot.data.get(), memory.data(), MEMORY_SIZE), 0);
+}
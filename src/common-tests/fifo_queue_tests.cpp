@@ -0,0 +1,54 @@
+#include "common/fifo_queue.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <numeric>
+
+TEST(FIFOQueue, PushRangeAndPopRangeWrapAround)
+{
+  InlineFIFOQueue<u32, 16> queue;
+
+  // move the head and tail near the end so the ranges wrap
+  for (u32 i = 0; i < 12; i++)
+    queue.Push(i);
+  queue.Remove(12);
+  ASSERT_TRUE(queue.IsEmpty());
+
+  std::array<u32, 10> in;
+  std::iota(in.begin(), in.end(), 100u);
+  queue.PushRange(in.data(), static_cast<u32>(in.size()));
+  ASSERT_EQ(queue.GetSize(), 10u);
+  for (u32 i = 0; i < 10; i++)
+    ASSERT_EQ(queue.Peek(i), 100u + i);
+
+  std::array<u32, 10> out = {};
+  queue.PopRange(out.data(), 3);
+  queue.PopRange(out.data() + 3, 7);
+  ASSERT_EQ(in, out);
+  ASSERT_TRUE(queue.IsEmpty());
+}
+
+TEST(FIFOQueue, PopRangeMatchesPop)
+{
+  HeapFIFOQueue<u16, 64> range_queue;
+  HeapFIFOQueue<u16, 64> single_queue;
+
+  u16 next_value = 0;
+  for (u32 iteration = 0; iteration < 100; iteration++)
+  {
+    const u32 push_count = (iteration * 7) % range_queue.GetSpace() + 1;
+    for (u32 i = 0; i < push_count && !range_queue.IsFull(); i++)
+    {
+      range_queue.Push(next_value);
+      single_queue.Push(next_value);
+      next_value++;
+    }
+
+    const u32 pop_count = (iteration * 5) % range_queue.GetSize() + 1;
+    std::array<u16, 64> range_values;
+    range_queue.PopRange(range_values.data(), pop_count);
+    for (u32 i = 0; i < pop_count; i++)
+      ASSERT_EQ(range_values[i], single_queue.Pop());
+
+    ASSERT_EQ(range_queue.GetSize(), single_queue.GetSize());
+  }
+}
@@ -0,0 +1,275 @@
+#include "core/gpu_sw_backend.h"
+#include "core/settings.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Renders the same random command streams with one render thread and with several, and checks that VRAM ends up
+// identical. Any draw which reads pixels written by another band, or writes pixels read by one, will show up here.
+
+static constexpr u32 NUM_RENDER_THREADS = 4;
+static constexpr u32 NUM_DRAWING_AREAS = 8;
+static constexpr u32 COMMANDS_PER_DRAWING_AREA = 250;
+static constexpr u32 MAX_PRIMITIVE_SIZE = 96;
+
+namespace {
+struct PrimitiveOptions
+{
+  bool textured;
+  bool semi_transparent;
+  bool mask_bit;
+
+  // Places texture pages and palettes over the drawing area, so draws sample the output of earlier ones, or their own.
+  bool sample_drawing_area;
+};
+} // namespace
+
+class GPUSWBackendTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_old_use_thread = g_settings.gpu_use_thread;
+    m_old_render_threads = g_settings.gpu_sw_render_threads;
+    g_settings.gpu_use_thread = false;
+  }
+
+  void TearDown() override
+  {
+    g_settings.gpu_use_thread = m_old_use_thread;
+    g_settings.gpu_sw_render_threads = m_old_render_threads;
+  }
+
+  static std::vector<u16> Render(u32 render_threads, u32 seed, const PrimitiveOptions& options)
+  {
+    g_settings.gpu_sw_render_threads = render_threads;
+
+    // too large for the stack
+    std::unique_ptr<GPU_SW_Backend> backend = std::make_unique<GPU_SW_Backend>();
+    EXPECT_TRUE(backend->Initialize());
+
+    std::mt19937 rng(seed);
+    UploadRandomVRAM(backend.get(), rng);
+    for (u32 i = 0; i < NUM_DRAWING_AREAS; i++)
+    {
+      const Common::Rectangle<u32> area = SetRandomDrawingArea(backend.get(), rng);
+      for (u32 j = 0; j < COMMANDS_PER_DRAWING_AREA; j++)
+        PushRandomCommand(backend.get(), rng, area, options);
+    }
+
+    backend->Sync();
+
+    std::vector<u16> vram(backend->GetVRAM(), backend->GetVRAM() + VRAM_WIDTH * VRAM_HEIGHT);
+    backend->Shutdown();
+    return vram;
+  }
+
+  static void TestOptions(const PrimitiveOptions& options)
+  {
+    for (const u32 seed : {1u, 2u, 3u})
+    {
+      SCOPED_TRACE(testing::Message() << "seed " << seed);
+
+      const std::vector<u16> expected = Render(1, seed, options);
+      const std::vector<u16> actual = Render(NUM_RENDER_THREADS, seed, options);
+      if (std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(u16)) == 0)
+        continue;
+
+      const u32 index = static_cast<u32>(
+        std::mismatch(expected.begin(), expected.end(), actual.begin()).first - expected.begin());
+      FAIL() << "first mismatch at " << (index % VRAM_WIDTH) << "," << (index / VRAM_WIDTH) << ": expected 0x"
+             << std::hex << expected[index] << ", got 0x" << actual[index];
+    }
+  }
+
+private:
+  static void UploadRandomVRAM(GPU_SW_Backend* backend, std::mt19937& rng)
+  {
+    // random mask bits too, so mask checks pass and fail
+    GPUBackendUpdateVRAMCommand* cmd = backend->NewUpdateVRAMCommand(VRAM_WIDTH * VRAM_HEIGHT);
+    cmd->params.bits = 0;
+    cmd->x = 0;
+    cmd->y = 0;
+    cmd->width = VRAM_WIDTH;
+    cmd->height = VRAM_HEIGHT;
+    for (u32 i = 0; i < VRAM_WIDTH * VRAM_HEIGHT; i++)
+      cmd->data[i] = static_cast<u16>(rng());
+    backend->PushCommand(cmd);
+  }
+
+  static Common::Rectangle<u32> SetRandomDrawingArea(GPU_SW_Backend* backend, std::mt19937& rng)
+  {
+    // tall enough to be split into several bands
+    const u32 width = 128 + (rng() % (VRAM_WIDTH - 128));
+    const u32 height = 128 + (rng() % (VRAM_HEIGHT - 128));
+    const u32 left = rng() % (VRAM_WIDTH - width + 1);
+    const u32 top = rng() % (VRAM_HEIGHT - height + 1);
+
+    // the drawing area is inclusive
+    GPUBackendSetDrawingAreaCommand* cmd = backend->NewSetDrawingAreaCommand();
+    cmd->params.bits = 0;
+    cmd->new_area = Common::Rectangle<u32>(left, top, left + width - 1, top + height - 1);
+    backend->PushCommand(cmd);
+    return cmd->new_area;
+  }
+
+  static s32 RandomCoordinate(std::mt19937& rng, u32 min, u32 max)
+  {
+    // a little outside the drawing area, so primitives get clipped
+    return static_cast<s32>(min + (rng() % (max - min + 1))) - 16 + static_cast<s32>(rng() % 33);
+  }
+
+  static void FillRandomDrawCommand(GPUBackendDrawCommand* cmd, std::mt19937& rng, GPUPrimitive primitive,
+                                    const Common::Rectangle<u32>& area, const PrimitiveOptions& options)
+  {
+    const u32 bits = static_cast<u32>(rng());
+
+    cmd->params.bits = 0;
+    if (options.mask_bit)
+    {
+      cmd->params.set_mask_while_drawing = (bits & 1) != 0;
+      cmd->params.check_mask_before_draw = (bits & 2) != 0;
+    }
+
+    // interlaced rendering skips every other line, which the band edges mustn't shift
+    if ((bits & 0x1C) == 0)
+    {
+      cmd->params.interlaced_rendering = true;
+      cmd->params.active_line_lsb = static_cast<u8>((bits >> 5) & 1);
+    }
+
+    cmd->rc.bits = 0;
+    cmd->rc.primitive = primitive;
+    cmd->rc.shading_enable = (bits & 0x40) != 0;
+    cmd->rc.transparency_enable = options.semi_transparent && (bits & 0x80) != 0;
+    if (options.textured && primitive != GPUPrimitive::Line)
+    {
+      cmd->rc.texture_enable = (bits & 0x300) != 0;
+      cmd->rc.raw_texture_enable = (bits & 0x400) != 0;
+    }
+
+    cmd->draw_mode.bits = static_cast<u16>(rng()) & GPUDrawModeReg::MASK;
+    cmd->palette.bits = static_cast<u16>(rng()) & GPUTexturePaletteReg::MASK;
+    if (options.sample_drawing_area)
+    {
+      // somewhere in the drawing area, so the batch or the primitive itself writes what is sampled
+      const u32 x = area.left + (rng() % area.GetWidth());
+      const u32 y = area.top + (rng() % area.GetHeight());
+      cmd->draw_mode.texture_page_x_base = static_cast<u8>(x / 64);
+      cmd->draw_mode.texture_page_y_base = static_cast<u8>(y / 256);
+      cmd->palette.x = static_cast<u16>(x / 16);
+      cmd->palette.y = static_cast<u16>(y);
+    }
+
+    // usually no texture window, since it shrinks the area sampled
+    const u32 window_bits = static_cast<u32>(rng());
+    const u8 mask_x = ((window_bits & 3) == 0) ? static_cast<u8>((window_bits >> 2) & 0x1F) : 0;
+    const u8 mask_y = ((window_bits & 3) == 0) ? static_cast<u8>((window_bits >> 7) & 0x1F) : 0;
+    cmd->window.and_x = static_cast<u8>(~(mask_x * 8));
+    cmd->window.and_y = static_cast<u8>(~(mask_y * 8));
+    cmd->window.or_x = static_cast<u8>(((window_bits >> 12) & mask_x) * 8);
+    cmd->window.or_y = static_cast<u8>(((window_bits >> 17) & mask_y) * 8);
+  }
+
+  static void PushRandomCommand(GPU_SW_Backend* backend, std::mt19937& rng, const Common::Rectangle<u32>& area,
+                                const PrimitiveOptions& options)
+  {
+    const u32 type = rng() % 8;
+    if (type < 4)
+    {
+      const u32 num_vertices = (type & 1) ? 4 : 3;
+      GPUBackendDrawPolygonCommand* cmd = backend->NewDrawPolygonCommand(num_vertices);
+      FillRandomDrawCommand(cmd, rng, GPUPrimitive::Polygon, area, options);
+      cmd->rc.quad_polygon = (num_vertices == 4);
+
+      const s32 x = RandomCoordinate(rng, area.left, area.right);
+      const s32 y = RandomCoordinate(rng, area.top, area.bottom);
+      for (u32 i = 0; i < num_vertices; i++)
+      {
+        GPUBackendDrawPolygonCommand::Vertex* vert = &cmd->vertices[i];
+        vert->x = x + static_cast<s32>(rng() % MAX_PRIMITIVE_SIZE);
+        vert->y = y + static_cast<s32>(rng() % MAX_PRIMITIVE_SIZE);
+        vert->color = static_cast<u32>(rng()) & UINT32_C(0x00FFFFFF);
+        vert->texcoord = static_cast<u16>(rng());
+      }
+
+      backend->PushCommand(cmd);
+    }
+    else if (type < 6)
+    {
+      GPUBackendDrawRectangleCommand* cmd = backend->NewDrawRectangleCommand();
+      FillRandomDrawCommand(cmd, rng, GPUPrimitive::Rectangle, area, options);
+      cmd->rc.shading_enable = false;
+      cmd->x = RandomCoordinate(rng, area.left, area.right);
+      cmd->y = RandomCoordinate(rng, area.top, area.bottom);
+      cmd->width = static_cast<u16>(1 + (rng() % MAX_PRIMITIVE_SIZE));
+      cmd->height = static_cast<u16>(1 + (rng() % MAX_PRIMITIVE_SIZE));
+      cmd->texcoord = static_cast<u16>(rng());
+      cmd->color = static_cast<u32>(rng()) & UINT32_C(0x00FFFFFF);
+      backend->PushCommand(cmd);
+    }
+    else if (type < 7)
+    {
+      const u32 num_vertices = 2 + (rng() % 3);
+      GPUBackendDrawLineCommand* cmd = backend->NewDrawLineCommand(num_vertices);
+      FillRandomDrawCommand(cmd, rng, GPUPrimitive::Line, area, options);
+      cmd->rc.polyline = (num_vertices > 2);
+      for (u32 i = 0; i < num_vertices; i++)
+      {
+        GPUBackendDrawLineCommand::Vertex* vert = &cmd->vertices[i];
+        vert->x = RandomCoordinate(rng, area.left, area.right);
+        vert->y = RandomCoordinate(rng, area.top, area.bottom);
+        vert->color = static_cast<u32>(rng()) & UINT32_C(0x00FFFFFF);
+      }
+
+      backend->PushCommand(cmd);
+    }
+    else
+    {
+      // transfers flush the batch
+      const u32 width = 1 + (rng() % 64);
+      const u32 height = 1 + (rng() % 64);
+      GPUBackendCopyVRAMCommand* cmd = backend->NewCopyVRAMCommand();
+      cmd->params.bits = 0;
+      cmd->src_x = static_cast<u16>(rng() % (VRAM_WIDTH - width));
+      cmd->src_y = static_cast<u16>(rng() % (VRAM_HEIGHT - height));
+      cmd->dst_x = static_cast<u16>(area.left + (rng() % (area.GetWidth() - width)));
+      cmd->dst_y = static_cast<u16>(area.top + (rng() % (area.GetHeight() - height)));
+      cmd->width = static_cast<u16>(width);
+      cmd->height = static_cast<u16>(height);
+      backend->PushCommand(cmd);
+    }
+  }
+
+  bool m_old_use_thread = false;
+  u32 m_old_render_threads = 1;
+};
+
+TEST_F(GPUSWBackendTest, UntexturedMatchesSingleThread)
+{
+  TestOptions(PrimitiveOptions{false, false, false, false});
+}
+
+TEST_F(GPUSWBackendTest, TexturedMatchesSingleThread)
+{
+  TestOptions(PrimitiveOptions{true, false, false, false});
+}
+
+TEST_F(GPUSWBackendTest, SemiTransparentMatchesSingleThread)
+{
+  TestOptions(PrimitiveOptions{true, true, false, false});
+}
+
+TEST_F(GPUSWBackendTest, MaskBitMatchesSingleThread)
+{
+  TestOptions(PrimitiveOptions{true, true, true, false});
+}
+
+TEST_F(GPUSWBackendTest, SamplingDrawingAreaMatchesSingleThread)
+{
+  TestOptions(PrimitiveOptions{true, false, false, true});
+  TestOptions(PrimitiveOptions{true, true, true, true});
+}
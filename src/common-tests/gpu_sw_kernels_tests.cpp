@@ -0,0 +1,91 @@
+#include "core/gpu_sw_kernels.h"
+#include "kernel_test_helpers.h"
+#include <gtest/gtest.h>
+#include <random>
+
+#if defined(GPU_SW_KERNELS_SSE2) || defined(GPU_SW_KERNELS_NEON)
+
+using Span16 = std::array<u16, GPUSWKernels::SPAN_PIXELS>;
+
+template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
+static void TestShadeSpan()
+{
+  std::uniform_int_distribution<u32> dist32(0, 0xFFFFFFFFu);
+  std::uniform_int_distribution<u32> dist16(0, 0xFFFF);
+  std::uniform_int_distribution<u32> dist4(0, 3);
+
+  KernelTests::RunRandomized(KernelTests::NUM_ITERATIONS, [&](std::mt19937& rng, u32 i) {
+    Span16 bg, texels;
+    std::array<s16, GPUSWKernels::SPAN_PIXELS> dither;
+    const u32 dither_row = dist4(rng);
+    for (u32 j = 0; j < GPUSWKernels::SPAN_PIXELS; j++)
+    {
+      bg[j] = static_cast<u16>(dist16(rng));
+
+      // make sure fully transparent texels turn up
+      texels[j] = (dist4(rng) == 0) ? 0 : static_cast<u16>(dist16(rng));
+      dither[j] = static_cast<s16>(DITHER_MATRIX[dither_row][j & 3]);
+    }
+
+    // alternate between flat and gouraud shading, with steps which wrap around
+    const bool shaded = (i & 1) != 0;
+    const u32 r = dist32(rng), dr = shaded ? dist32(rng) : 0;
+    const u32 g = dist32(rng), dg = shaded ? dist32(rng) : 0;
+    const u32 b = dist32(rng), db = shaded ? dist32(rng) : 0;
+
+    const GPUTransparencyMode transparency_mode = static_cast<GPUTransparencyMode>(dist4(rng));
+    const u16 mask_and = (dist4(rng) & 1) ? 0x8000 : 0;
+    const u16 mask_or = (dist4(rng) & 1) ? 0x8000 : 0;
+
+    Span16 reference = bg;
+    Span16 vectorized = bg;
+    GPUSWKernels::ShadeSpan_Reference<texture_enable, raw_texture_enable, transparency_enable>(
+      reference.data(), texels.data(), r, dr, g, dg, b, db, dither.data(), transparency_mode, mask_and, mask_or);
+    GPUSWKernels::VECTORIZED_KERNEL(ShadeSpan)<texture_enable, raw_texture_enable, transparency_enable>(
+      vectorized.data(), texels.data(), r, dr, g, dg, b, db, dither.data(), transparency_mode, mask_and, mask_or);
+    ASSERT_EQ(reference, vectorized) << "transparency mode " << static_cast<u32>(transparency_mode);
+  });
+}
+
+TEST(GPUSWKernels, ShadeSpanUntexturedMatchesReference)
+{
+  TestShadeSpan<false, false, false>();
+  TestShadeSpan<false, false, true>();
+}
+
+TEST(GPUSWKernels, ShadeSpanTexturedMatchesReference)
+{
+  TestShadeSpan<true, false, false>();
+  TestShadeSpan<true, false, true>();
+}
+
+TEST(GPUSWKernels, ShadeSpanRawTexturedMatchesReference)
+{
+  TestShadeSpan<true, true, false>();
+  TestShadeSpan<true, true, true>();
+}
+
+TEST(GPUSWKernels, ShadeSpanDitherSaturates)
+{
+  // the largest modulated values with the largest dither offset, and zero with the smallest
+  Span16 texels;
+  std::array<s16, GPUSWKernels::SPAN_PIXELS> dither;
+  for (const u32 value : {0u, 0xFFu})
+  {
+    const u32 color = value << GPUSWKernels::INTERPOLATION_FRACTION_BITS;
+    texels.fill(static_cast<u16>(value ? 0x7FFF : 0x8000));
+    dither.fill(static_cast<s16>(value ? 4 : -4));
+
+    Span16 reference{};
+    Span16 vectorized{};
+    GPUSWKernels::ShadeSpan_Reference<true, false, false>(reference.data(), texels.data(), color, 0, color, 0, color,
+                                                          0, dither.data(),
+                                                          GPUTransparencyMode::BackgroundPlusForeground, 0, 0);
+    GPUSWKernels::VECTORIZED_KERNEL(ShadeSpan)<true, false, false>(vectorized.data(), texels.data(), color, 0, color,
+                                                                   0, color, 0, dither.data(),
+                                                                   GPUTransparencyMode::BackgroundPlusForeground, 0, 0);
+    ASSERT_EQ(reference, vectorized) << "value " << value;
+  }
+}
+
+#endif
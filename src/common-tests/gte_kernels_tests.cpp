@@ -0,0 +1,87 @@
+#include "core/gte_kernels.h"
+#include "kernel_test_helpers.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <limits>
+#include <random>
+
+#if defined(GTE_KERNELS_SSE2) || defined(GTE_KERNELS_NEON)
+
+// The kernels are cheap, so use more iterations to hit the rarer overflow combinations.
+static constexpr u32 NUM_ITERATIONS = KernelTests::NUM_ITERATIONS * 10;
+
+// Mostly full range values, with enough extremes to hit every overflow and saturation case.
+template<typename T>
+static T RandomValue(std::mt19937& rng)
+{
+  const u32 bits = static_cast<u32>(rng());
+  switch (bits & 7)
+  {
+    case 0:
+      return std::numeric_limits<T>::max();
+    case 1:
+      return std::numeric_limits<T>::min();
+    case 2:
+      return static_cast<T>(static_cast<s32>(bits) >> 20);
+    default:
+      return static_cast<T>(rng());
+  }
+}
+
+TEST(GTEKernels, MulMatVecMatchesReference)
+{
+  KernelTests::RunRandomized(NUM_ITERATIONS, [](std::mt19937& rng, u32 i) {
+    s16 M[3][3];
+    s32 T[3];
+    for (auto& row : M)
+    {
+      for (s16& value : row)
+        value = RandomValue<s16>(rng);
+    }
+    for (s32& value : T)
+      value = (i & 8) ? 0 : RandomValue<s32>(rng);
+
+    const s16 Vx = RandomValue<s16>(rng);
+    const s16 Vy = RandomValue<s16>(rng);
+    const s16 Vz = RandomValue<s16>(rng);
+    const u8 shift = (i & 1) ? 12 : 0;
+    const bool lm = (i & 2) != 0;
+
+    std::array<s32, 3> reference_MAC, reference_IR, vectorized_MAC, vectorized_IR;
+    const u32 reference_flags =
+      GTEKernels::MulMatVec_Reference(M, T, Vx, Vy, Vz, shift, lm, reference_MAC.data(), reference_IR.data());
+    const u32 vectorized_flags = GTEKernels::VECTORIZED_KERNEL(MulMatVec)(M, T, Vx, Vy, Vz, shift, lm,
+                                                                          vectorized_MAC.data(), vectorized_IR.data());
+    ASSERT_EQ(reference_flags, vectorized_flags);
+    ASSERT_EQ(reference_MAC, vectorized_MAC);
+    ASSERT_EQ(reference_IR, vectorized_IR);
+  });
+}
+
+TEST(GTEKernels, InterpolateColorMatchesReference)
+{
+  KernelTests::RunRandomized(NUM_ITERATIONS, [](std::mt19937& rng, u32 i) {
+    s32 in_MAC[3];
+    s32 FC[3];
+    for (u32 j = 0; j < 3; j++)
+    {
+      in_MAC[j] = RandomValue<s32>(rng);
+      FC[j] = RandomValue<s32>(rng);
+    }
+
+    const s16 IR0 = RandomValue<s16>(rng);
+    const u8 shift = (i & 1) ? 12 : 0;
+    const bool lm = (i & 2) != 0;
+
+    std::array<s32, 3> reference_MAC, reference_IR, vectorized_MAC, vectorized_IR;
+    const u32 reference_flags =
+      GTEKernels::InterpolateColor_Reference(in_MAC, FC, IR0, shift, lm, reference_MAC.data(), reference_IR.data());
+    const u32 vectorized_flags = GTEKernels::VECTORIZED_KERNEL(InterpolateColor)(
+      in_MAC, FC, IR0, shift, lm, vectorized_MAC.data(), vectorized_IR.data());
+    ASSERT_EQ(reference_flags, vectorized_flags);
+    ASSERT_EQ(reference_MAC, vectorized_MAC);
+    ASSERT_EQ(reference_IR, vectorized_IR);
+  });
+}
+
+#endif
@@ -0,0 +1,182 @@
+#include "core/cpu_core.h"
+#include "core/gte.h"
+#include "core/settings.h"
+#include "kernel_test_helpers.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+
+#ifdef WITH_RECOMPILER
+
+#include "core/cpu_recompiler_code_generator.h"
+
+// Runs GTE commands through the recompiler and the interpreter with the same random register values, and checks every
+// GTE register afterwards, including FLAG.
+
+static constexpr u32 CODE_BUFFER_SIZE = 16 * 1024 * 1024;
+
+// COP2 with the command bit set.
+static constexpr u32 COP2_COMMAND_BITS = UINT32_C(0x4A000000);
+
+// Mostly full range halfwords, with enough extremes to hit every overflow and saturation case.
+static u16 RandomHalfword(std::mt19937& rng)
+{
+  const u32 bits = static_cast<u32>(rng());
+  switch (bits & 7)
+  {
+    case 0:
+      return static_cast<u16>(std::numeric_limits<s16>::max());
+    case 1:
+      return static_cast<u16>(std::numeric_limits<s16>::min());
+    case 2:
+      return static_cast<u16>(static_cast<s32>(bits) >> 24);
+    case 3:
+      return static_cast<u16>(bits >> 20);
+    default:
+      return static_cast<u16>(rng());
+  }
+}
+
+static void RandomizeGTERegisters(std::mt19937& rng)
+{
+  for (u32& reg : CPU::g_state.gte_regs.r32)
+    reg = ZeroExtend32(RandomHalfword(rng)) | (ZeroExtend32(RandomHalfword(rng)) << 16);
+
+  // IR0-3 are always sign-extended, and the SZ FIFO zero-extended, otherwise the interpreter wouldn't match itself.
+  for (u32 i = 8; i < 12; i++)
+    CPU::g_state.gte_regs.dr32[i] = SignExtend32(static_cast<u16>(CPU::g_state.gte_regs.dr32[i]));
+  for (u32 i = 16; i < 20; i++)
+    CPU::g_state.gte_regs.dr32[i] = ZeroExtend32(static_cast<u16>(CPU::g_state.gte_regs.dr32[i]));
+
+  CPU::g_state.gte_regs.FLAG.bits = static_cast<u32>(rng()) & GTE::FLAGS::WRITE_MASK;
+}
+
+using GTERegisterValues = std::array<u32, GTE::NUM_REGS>;
+
+static GTERegisterValues GetGTERegisters()
+{
+  GTERegisterValues values;
+  std::copy(std::begin(CPU::g_state.gte_regs.r32), std::end(CPU::g_state.gte_regs.r32), values.begin());
+  return values;
+}
+
+static void SetGTERegisters(const GTERegisterValues& values)
+{
+  std::copy(values.begin(), values.end(), std::begin(CPU::g_state.gte_regs.r32));
+}
+
+class GTERecompilerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_TRUE(m_code_buffer.Allocate(CODE_BUFFER_SIZE));
+
+    CPU::Recompiler::CodeGenerator codegen(&m_code_buffer);
+    m_dispatcher = codegen.CompileSingleBlockDispatcher();
+  }
+
+  CPU::CodeBlock::HostCodePointer CompileCommand(u32 gte_bits)
+  {
+    CPU::CodeBlockInstruction cbi = {};
+    cbi.instruction.bits = COP2_COMMAND_BITS | gte_bits;
+    cbi.is_last_instruction = true;
+
+    CPU::CodeBlock block(CPU::CodeBlockKey{});
+    block.instructions.push_back(cbi);
+
+    CPU::CodeBlock::HostCodePointer host_code = nullptr;
+    u32 host_code_size = 0;
+    CPU::Recompiler::CodeGenerator codegen(&m_code_buffer);
+    EXPECT_TRUE(codegen.CompileBlock(&block, &host_code, &host_code_size));
+    return host_code;
+  }
+
+  void TestCommand(u32 gte_bits, u32 iterations = KernelTests::NUM_ITERATIONS)
+  {
+    // one failing command is enough
+    if (HasFatalFailure())
+      return;
+
+    SCOPED_TRACE(testing::Message() << "command 0x" << std::hex << gte_bits);
+
+    const CPU::CodeBlock::HostCodePointer host_code = CompileCommand(gte_bits);
+    ASSERT_NE(host_code, nullptr);
+
+    KernelTests::RunRandomized(iterations, [&](std::mt19937& rng, u32) {
+      RandomizeGTERegisters(rng);
+      const GTERegisterValues input = GetGTERegisters();
+
+      GTE::ExecuteInstruction(gte_bits);
+      const GTERegisterValues expected = GetGTERegisters();
+
+      SetGTERegisters(input);
+      m_dispatcher(host_code);
+
+      const GTERegisterValues actual = GetGTERegisters();
+      if (actual == expected)
+        return;
+
+      for (u32 i = 0; i < GTE::NUM_REGS; i++)
+        ASSERT_EQ(expected[i], actual[i]) << "register " << i;
+    });
+  }
+
+  // sf and lm are bits 19 and 10
+  void TestCommandWithShiftAndLimit(u32 gte_bits, u32 iterations = KernelTests::NUM_ITERATIONS)
+  {
+    for (const u32 sf : {0u, 1u})
+    {
+      for (const u32 lm : {0u, 1u})
+        TestCommand(gte_bits | (sf << 19) | (lm << 10), iterations);
+    }
+  }
+
+  JitCodeBuffer m_code_buffer;
+  CPU::CodeCache::SingleBlockDispatcherFunction m_dispatcher = nullptr;
+};
+
+TEST_F(GTERecompilerTest, NCLIPMatchesInterpreter)
+{
+  TestCommand(0x06);
+}
+
+TEST_F(GTERecompilerTest, AVSZMatchesInterpreter)
+{
+  TestCommand(0x2D);
+  TestCommand(0x2E);
+}
+
+TEST_F(GTERecompilerTest, MVMVAMatchesInterpreter)
+{
+  // every matrix, vector and translation vector combination, which is compiled differently for each
+  for (u32 mx = 0; mx < 4; mx++)
+  {
+    for (u32 v = 0; v < 4; v++)
+    {
+      for (u32 cv = 0; cv < 4; cv++)
+        TestCommandWithShiftAndLimit(0x12 | (mx << 17) | (v << 15) | (cv << 13), KernelTests::NUM_ITERATIONS / 10);
+    }
+  }
+}
+
+TEST_F(GTERecompilerTest, RTPSMatchesInterpreter)
+{
+  TestCommandWithShiftAndLimit(0x01);
+  TestCommandWithShiftAndLimit(0x30);
+}
+
+TEST_F(GTERecompilerTest, RTPSWidescreenMatchesInterpreter)
+{
+  // the projection is shared with the interpreter, but the settings are read when the code runs
+  g_settings.gpu_widescreen_hack = true;
+  g_settings.display_aspect_ratio = DisplayAspectRatio::R16_9;
+  TestCommandWithShiftAndLimit(0x01);
+  TestCommandWithShiftAndLimit(0x30);
+  g_settings.gpu_widescreen_hack = false;
+  g_settings.display_aspect_ratio = DisplayAspectRatio::Auto;
+}
+
+#endif
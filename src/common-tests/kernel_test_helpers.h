@@ -0,0 +1,39 @@
+#pragma once
+#include "common/cpu_detect.h"
+#include "common/types.h"
+#include <gtest/gtest.h>
+#include <random>
+
+// Shared pieces of the tests comparing the vectorized MDEC, GTE and rasterizer kernels against the reference versions.
+
+// The vectorized version of a kernel for the host, e.g. VECTORIZED_KERNEL(IDCT) is IDCT_SSE2 on x64. Only usable when
+// the kernel header defines its SSE2/NEON macro.
+#if defined(CPU_X64)
+#define VECTORIZED_KERNEL(name) name##_SSE2
+#elif defined(CPU_AARCH64) && defined(WITH_NEON_KERNELS)
+#define VECTORIZED_KERNEL(name) name##_NEON
+#endif
+
+namespace KernelTests {
+
+static constexpr u32 NUM_ITERATIONS = 10000;
+static constexpr u32 RANDOM_SEED = 12345;
+
+/// Calls func(rng, i) for each iteration with the same random sequence every run, stopping at the first fatal failure
+/// and reporting which iteration it happened in.
+template<typename F>
+static void RunRandomized(u32 iterations, const F& func)
+{
+  std::mt19937 rng(RANDOM_SEED);
+  for (u32 i = 0; i < iterations; i++)
+  {
+    func(rng, i);
+    if (testing::Test::HasFatalFailure())
+    {
+      ADD_FAILURE() << "in iteration " << i;
+      return;
+    }
+  }
+}
+
+} // namespace KernelTests
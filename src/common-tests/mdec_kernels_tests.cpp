@@ -0,0 +1,111 @@
+#include "core/mdec_kernels.h"
+#include "kernel_test_helpers.h"
+#include <gtest/gtest.h>
+#include <random>
+
+#if defined(MDEC_KERNELS_SSE2) || defined(MDEC_KERNELS_NEON)
+
+template<typename T>
+static std::array<T, 64> RandomBlock(std::mt19937& rng, s32 min_value, s32 max_value)
+{
+  std::uniform_int_distribution<s32> dist(min_value, max_value);
+  std::array<T, 64> block;
+  for (T& value : block)
+    value = static_cast<T>(dist(rng));
+  return block;
+}
+
+TEST(MDECKernels, IDCTMatchesReference)
+{
+  KernelTests::RunRandomized(KernelTests::NUM_ITERATIONS, [](std::mt19937& rng, u32 i) {
+    // alternate between full range scale tables and the ones games actually use
+    const s32 scale_range = (i & 1) ? 32768 : 0x5A82;
+    const std::array<s16, 64> scale_table = RandomBlock<s16>(rng, -scale_range, scale_range - 1);
+    std::array<s16, 64> reference = RandomBlock<s16>(rng, -0x400, 0x3FF);
+    std::array<s16, 64> vectorized = reference;
+
+    MDECKernels::IDCT_Reference(reference.data(), scale_table.data());
+    MDECKernels::VECTORIZED_KERNEL(IDCT)(vectorized.data(), scale_table.data());
+    ASSERT_EQ(reference, vectorized);
+  });
+}
+
+TEST(MDECKernels, IDCTExtremeCoefficients)
+{
+  std::array<s16, 64> scale_table;
+  for (const s16 scale_value : {static_cast<s16>(-32768), static_cast<s16>(32767)})
+  {
+    scale_table.fill(scale_value);
+    for (const s16 coefficient : {static_cast<s16>(-0x400), static_cast<s16>(0x3FF)})
+    {
+      std::array<s16, 64> reference;
+      reference.fill(coefficient);
+      std::array<s16, 64> vectorized = reference;
+
+      MDECKernels::IDCT_Reference(reference.data(), scale_table.data());
+      MDECKernels::VECTORIZED_KERNEL(IDCT)(vectorized.data(), scale_table.data());
+      ASSERT_EQ(reference, vectorized);
+    }
+  }
+}
+
+TEST(MDECKernels, YUVToRGBMatchesReference)
+{
+  KernelTests::RunRandomized(KernelTests::NUM_ITERATIONS, [](std::mt19937& rng, u32) {
+    const std::array<s16, 64> Cr = RandomBlock<s16>(rng, -128, 127);
+    const std::array<s16, 64> Cb = RandomBlock<s16>(rng, -128, 127);
+    const std::array<s16, 64> Y = RandomBlock<s16>(rng, -128, 127);
+
+    std::array<u32, 256> reference{};
+    std::array<u32, 256> vectorized{};
+    for (u32 quadrant = 0; quadrant < 4; quadrant++)
+    {
+      const u32 xx = (quadrant & 1) * 8;
+      const u32 yy = (quadrant >> 1) * 8;
+      MDECKernels::YUVToRGB_Reference(reference.data(), xx, yy, Cr.data(), Cb.data(), Y.data());
+      MDECKernels::VECTORIZED_KERNEL(YUVToRGB)(vectorized.data(), xx, yy, Cr.data(), Cb.data(), Y.data());
+    }
+
+    ASSERT_EQ(reference, vectorized);
+  });
+}
+
+TEST(MDECKernels, YUVToRGBAllChromaValues)
+{
+  // every Cr/Cb combination, with the luma at the clamping boundaries and in the middle
+  std::array<s16, 64> Cr, Cb, Y;
+  for (s32 Y_value : {-128, 0, 127})
+  {
+    Y.fill(static_cast<s16>(Y_value));
+    for (s32 Cr_value = -128; Cr_value <= 127; Cr_value++)
+    {
+      Cr.fill(static_cast<s16>(Cr_value));
+      for (s32 Cb_value = -128; Cb_value <= 127; Cb_value += 16)
+      {
+        for (u32 j = 0; j < 64; j++)
+          Cb[j] = static_cast<s16>(std::min(Cb_value + static_cast<s32>(j % 16), 127));
+
+        std::array<u32, 256> reference{};
+        std::array<u32, 256> vectorized{};
+        MDECKernels::YUVToRGB_Reference(reference.data(), 0, 0, Cr.data(), Cb.data(), Y.data());
+        MDECKernels::VECTORIZED_KERNEL(YUVToRGB)(vectorized.data(), 0, 0, Cr.data(), Cb.data(), Y.data());
+        ASSERT_EQ(reference, vectorized) << "Y " << Y_value << " Cr " << Cr_value << " Cb " << Cb_value;
+      }
+    }
+  }
+}
+
+TEST(MDECKernels, YToMonoMatchesReference)
+{
+  KernelTests::RunRandomized(KernelTests::NUM_ITERATIONS, [](std::mt19937& rng, u32) {
+    const std::array<s16, 64> Y = RandomBlock<s16>(rng, -32768, 32767);
+
+    std::array<u32, 64> reference;
+    std::array<u32, 64> vectorized;
+    MDECKernels::YToMono_Reference(reference.data(), Y.data());
+    MDECKernels::VECTORIZED_KERNEL(YToMono)(vectorized.data(), Y.data());
+    ASSERT_EQ(reference, vectorized);
+  });
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "common/spsc_ring_buffer.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST(SPSCRingBuffer, WriteAndReadWrapAround)
+{
+  SPSCRingBuffer<u32> buffer(16);
+
+  // move the positions near the end so the ranges wrap
+  std::array<u32, 12> scratch = {};
+  ASSERT_EQ(buffer.Write(scratch.data(), 12), 12u);
+  ASSERT_EQ(buffer.Read(scratch.data(), 12), 12u);
+  ASSERT_TRUE(buffer.IsEmpty());
+
+  std::array<u32, 16> in;
+  std::iota(in.begin(), in.end(), 100u);
+  ASSERT_EQ(buffer.Write(in.data(), static_cast<u32>(in.size())), 16u);
+  ASSERT_EQ(buffer.GetSpace(), 0u);
+  ASSERT_EQ(buffer.Write(in.data(), 1), 0u);
+
+  u32 contiguous_size;
+  const u32* ptr = buffer.GetReadPointer(&contiguous_size);
+  ASSERT_EQ(contiguous_size, 4u);
+  ASSERT_EQ(ptr[0], 100u);
+
+  std::array<u32, 16> out = {};
+  ASSERT_EQ(buffer.Read(out.data(), 3), 3u);
+  ASSERT_EQ(buffer.Read(out.data() + 3, 20), 13u);
+  ASSERT_EQ(in, out);
+  ASSERT_TRUE(buffer.IsEmpty());
+}
+
+TEST(SPSCRingBuffer, DiscardUntilWritePosition)
+{
+  SPSCRingBuffer<u16> buffer(8);
+  const std::array<u16, 5> in = {1, 2, 3, 4, 5};
+  buffer.Write(in.data(), 3);
+  const u32 position = buffer.GetWritePosition();
+  buffer.Write(in.data() + 3, 2);
+
+  buffer.DiscardUntil(position);
+  ASSERT_EQ(buffer.GetSize(), 2u);
+
+  // a stale position must not move the read position backwards
+  buffer.DiscardUntil(position - 1);
+  ASSERT_EQ(buffer.GetSize(), 2u);
+
+  std::array<u16, 2> out = {};
+  ASSERT_EQ(buffer.Read(out.data(), 2), 2u);
+  ASSERT_EQ(out[0], 4u);
+  ASSERT_EQ(out[1], 5u);
+}
+
+TEST(SPSCRingBuffer, ThreadedTransferPreservesOrder)
+{
+  static constexpr u32 TOTAL_VALUES = 1000000;
+  SPSCRingBuffer<u32> buffer(256);
+
+  std::thread producer([&buffer]() {
+    u32 next_value = 0;
+    while (next_value < TOTAL_VALUES)
+    {
+      u32 contiguous_space;
+      u32* ptr = buffer.GetWritePointer(&contiguous_space);
+      const u32 count = std::min(contiguous_space, TOTAL_VALUES - next_value);
+      for (u32 i = 0; i < count; i++)
+        ptr[i] = next_value++;
+      buffer.CommitWrite(count);
+      if (count == 0)
+        std::this_thread::yield();
+    }
+  });
+
+  std::vector<u32> chunk(100);
+  u32 expected_value = 0;
+  while (expected_value < TOTAL_VALUES)
+  {
+    const u32 count = buffer.Read(chunk.data(), static_cast<u32>(chunk.size()));
+    for (u32 i = 0; i < count; i++)
+      ASSERT_EQ(chunk[i], expected_value++);
+    if (count == 0)
+      std::this_thread::yield();
+  }
+
+  producer.join();
+  ASSERT_TRUE(buffer.IsEmpty());
+}
@@ -6,6 +6,12 @@
 #include <cstring>
 Log_SetChannel(AudioStream);
 
+// Dynamic sync adjusts the resampling ratio by up to this fraction, 0.5% is well below what's audible as pitch.
+static constexpr double DYNAMIC_SYNC_MAX_RATIO_ADJUSTMENT = 0.005;
+
+// Weight of each new fill level in the moving average, applied once per device callback.
+static constexpr float DYNAMIC_SYNC_FILL_SMOOTHING = 0.05f;
+
 AudioStream::AudioStream() = default;
 
 AudioStream::~AudioStream()
@@ -17,32 +23,34 @@ bool AudioStream::Reconfigure(u32 input_sample_rate /* = DefaultInputSampleRate
                               u32 output_sample_rate /* = DefaultOutputSampleRate */, u32 channels /* = 1 */,
                               u32 buffer_size /* = DefaultBufferSize */)
 {
-  std::unique_lock<std::mutex> buffer_lock(m_buffer_mutex);
-  std::unique_lock<std::mutex> resampler_Lock(m_resampler_mutex);
-
-  DestroyResampler();
+  // closing the device stops the reader, so everything can be reset directly
   if (IsDeviceOpen())
     CloseDevice();
+  DestroyResampler();
 
   m_output_sample_rate = output_sample_rate;
   m_channels = channels;
   m_buffer_size = buffer_size;
-  m_buffer_filling.store(m_wait_for_buffer_fill);
   m_output_paused = true;
 
   if (!SetBufferSize(buffer_size))
     return false;
 
+  ResetBuffers();
+
   if (!OpenDevice())
   {
-    EmptyBuffers();
+    ResetBuffers();
     m_buffer_size = 0;
     m_output_sample_rate = 0;
     m_channels = 0;
     return false;
   }
 
+  // the device starts paused, so the reader still isn't running
   CreateResampler();
+  m_input_sample_rate = 0;
+  m_requested_input_sample_rate.store(input_sample_rate, std::memory_order_release);
   InternalSetInputSampleRate(input_sample_rate);
 
   return true;
@@ -50,16 +58,12 @@ bool AudioStream::Reconfigure(u32 input_sample_rate /* = DefaultInputSampleRate
 
 void AudioStream::SetInputSampleRate(u32 sample_rate)
 {
-  std::unique_lock<std::mutex> buffer_lock(m_buffer_mutex);
-  std::unique_lock<std::mutex> resampler_lock(m_resampler_mutex);
-
-  InternalSetInputSampleRate(sample_rate);
+  m_requested_input_sample_rate.store(sample_rate, std::memory_order_release);
 }
 
 void AudioStream::SetWaitForBufferFill(bool enabled)
 {
-  std::unique_lock<std::mutex> buffer_lock(m_buffer_mutex);
-  m_wait_for_buffer_fill = enabled;
+  m_wait_for_buffer_fill.store(enabled);
   if (enabled && m_buffer.IsEmpty())
     m_buffer_filling.store(true);
 }
@@ -77,8 +81,7 @@ void AudioStream::InternalSetInputSampleRate(u32 sample_rate)
 
 void AudioStream::SetOutputVolume(u32 volume)
 {
-  std::unique_lock<std::mutex> lock(m_buffer_mutex);
-  m_output_volume = volume;
+  m_output_volume.store(volume, std::memory_order_relaxed);
 }
 
 void AudioStream::PauseOutput(bool paused)
@@ -100,7 +103,7 @@ void AudioStream::Shutdown()
     return;
 
   CloseDevice();
-  EmptyBuffers();
+  ResetBuffers();
   m_buffer_size = 0;
   m_output_sample_rate = 0;
   m_channels = 0;
@@ -109,37 +112,51 @@ void AudioStream::Shutdown()
 
 void AudioStream::BeginWrite(SampleType** buffer_ptr, u32* num_frames)
 {
-  m_buffer_mutex.lock();
-
   const u32 requested_frames = std::min(*num_frames, m_buffer_size);
-  EnsureBuffer(requested_frames * m_channels);
+  if (!EnsureBuffer(requested_frames * m_channels))
+  {
+    // not syncing and there's no space, so let the frames be generated, then drop them
+    m_overflow_buffer.resize(m_buffer_size * m_channels);
+    m_writing_overflow = true;
+    *buffer_ptr = m_overflow_buffer.data();
+    *num_frames = requested_frames;
+    return;
+  }
 
-  *buffer_ptr = m_buffer.GetWritePointer();
-  *num_frames = m_buffer.GetContiguousSpace() / m_channels;
+  u32 contiguous_space;
+  *buffer_ptr = m_buffer.GetWritePointer(&contiguous_space);
+  *num_frames = std::min(contiguous_space, GetBufferSpace()) / m_channels;
 }
 
 void AudioStream::WriteFrames(const SampleType* frames, u32 num_frames)
 {
   Assert(num_frames <= m_buffer_size);
   const u32 num_samples = num_frames * m_channels;
+  if (!EnsureBuffer(num_samples))
   {
-    std::unique_lock<std::mutex> lock(m_buffer_mutex);
-    EnsureBuffer(num_samples);
-    m_buffer.PushRange(frames, num_samples);
+    Log_VerbosePrintf("Audio buffer overflow, dropped %u frames", num_frames);
+    return;
   }
 
+  m_buffer.Write(frames, num_samples);
   FramesAvailable();
 }
 
 void AudioStream::EndWrite(u32 num_frames)
 {
-  m_buffer.AdvanceTail(num_frames * m_channels);
+  if (m_writing_overflow)
+  {
+    Log_VerbosePrintf("Audio buffer overflow, dropped %u frames", num_frames);
+    m_writing_overflow = false;
+    return;
+  }
+
+  m_buffer.CommitWrite(num_frames * m_channels);
   if (m_buffer_filling.load())
   {
     if ((m_buffer.GetSize() / m_channels) >= m_buffer_size)
       m_buffer_filling.store(false);
   }
-  m_buffer_mutex.unlock();
   FramesAvailable();
 }
 
@@ -161,52 +178,33 @@ bool AudioStream::SetBufferSize(u32 buffer_size)
 }
 
 u32 AudioStream::GetSamplesAvailable() const
-{
-  // TODO: Use atomic loads
-  u32 available_samples;
-  {
-    std::unique_lock<std::mutex> lock(m_buffer_mutex);
-    available_samples = m_buffer.GetSize();
-  }
-
-  return available_samples / m_channels;
-}
-
-u32 AudioStream::GetSamplesAvailableLocked() const
 {
   return m_buffer.GetSize() / m_channels;
 }
 
 void AudioStream::ReadFrames(SampleType* samples, u32 num_frames, bool apply_volume)
 {
+  ApplyReaderRequests();
+
   const u32 total_samples = num_frames * m_channels;
   u32 samples_copied = 0;
-  std::unique_lock<std::mutex> buffer_lock(m_buffer_mutex);
   if (!m_buffer_filling.load())
   {
-    if (m_input_sample_rate == m_output_sample_rate)
+    if (m_input_sample_rate == m_output_sample_rate && !m_dynamic_sync_active)
     {
-      samples_copied = std::min(m_buffer.GetSize(), total_samples);
-      if (samples_copied > 0)
-        m_buffer.PopRange(samples, samples_copied);
-
-      ReleaseBufferLock(std::move(buffer_lock));
+      samples_copied = m_buffer.Read(samples, total_samples);
     }
     else
     {
       if (m_resampled_buffer.GetSize() < total_samples)
-        ResampleInput(std::move(buffer_lock));
-      else
-        ReleaseBufferLock(std::move(buffer_lock));
+        ResampleInput();
 
       samples_copied = std::min(m_resampled_buffer.GetSize(), total_samples);
       if (samples_copied > 0)
         m_resampled_buffer.PopRange(samples, samples_copied);
     }
-  }
-  else
-  {
-    ReleaseBufferLock(std::move(buffer_lock));
+
+    SignalBufferDrained();
   }
 
   if (samples_copied < total_samples)
@@ -246,55 +244,106 @@ void AudioStream::ReadFrames(SampleType* samples, u32 num_frames, bool apply_vol
       m_underflow_flag.store(true);
     }
 
-    m_buffer_filling.store(m_wait_for_buffer_fill);
+    m_buffer_filling.store(m_wait_for_buffer_fill.load());
   }
 
-  if (apply_volume && m_output_volume != FullVolume)
+  const u32 output_volume = m_output_volume.load(std::memory_order_relaxed);
+  if (apply_volume && output_volume != FullVolume)
   {
     SampleType* current_ptr = samples;
     const SampleType* end_ptr = samples + (num_frames * m_channels);
     while (current_ptr != end_ptr)
     {
-      *current_ptr = ApplyVolume(*current_ptr, m_output_volume);
+      *current_ptr = ApplyVolume(*current_ptr, output_volume);
       current_ptr++;
     }
   }
 }
 
-void AudioStream::EnsureBuffer(u32 size)
+bool AudioStream::EnsureBuffer(u32 size)
 {
   DebugAssert(size <= (m_buffer_size * m_channels));
   if (GetBufferSpace() >= size)
-    return;
+    return true;
 
-  if (m_sync)
-  {
-    std::unique_lock<std::mutex> lock(m_buffer_mutex, std::adopt_lock);
-    m_buffer_draining_cv.wait(lock, [this, size]() { return GetBufferSpace() >= size; });
-    lock.release();
-  }
-  else
+  if (!m_sync)
+    return false;
+
+  WaitForBufferSpace(size);
+  return true;
+}
+
+void AudioStream::WaitForBufferSpace(u32 size)
+{
+  // The reader frees a whole callback's worth of space at a time, so spinning would only burn CPU. Flag that we're
+  // waiting before the final check, so a read which happens in between always sees the flag and signals.
+  for (;;)
   {
-    m_buffer.Remove(size);
+    m_writer_waiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (GetBufferSpace() >= size)
+      break;
+
+    m_buffer_drained_event.Wait();
   }
+
+  m_writer_waiting.store(false, std::memory_order_relaxed);
+}
+
+void AudioStream::SignalBufferDrained()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_writer_waiting.load(std::memory_order_relaxed))
+    m_buffer_drained_event.Signal();
 }
 
 void AudioStream::DropFrames(u32 count)
 {
-  std::unique_lock<std::mutex> lock(m_buffer_mutex);
-  m_buffer.Remove(count);
+  ApplyReaderRequests();
+  m_buffer.Discard(count);
+  SignalBufferDrained();
 }
 
 void AudioStream::EmptyBuffers()
 {
-  std::unique_lock<std::mutex> lock(m_buffer_mutex);
-  std::unique_lock<std::mutex> resampler_lock(m_resampler_mutex);
+  // the reader owns the read position and resampler, so it does the actual emptying when it next runs
+  m_empty_position.store(m_buffer.GetWritePosition(), std::memory_order_relaxed);
+  m_empty_requested.store(true, std::memory_order_release);
+  m_underflow_flag.store(false);
+  m_buffer_filling.store(m_wait_for_buffer_fill.load());
+}
+
+void AudioStream::ResetBuffers()
+{
   m_buffer.Clear();
+  m_empty_requested.store(false);
   m_underflow_flag.store(false);
-  m_buffer_filling.store(m_wait_for_buffer_fill);
+  m_buffer_filling.store(m_wait_for_buffer_fill.load());
   ResetResampler();
 }
 
+void AudioStream::ApplyReaderRequests()
+{
+  const u32 input_sample_rate = m_requested_input_sample_rate.load(std::memory_order_acquire);
+  if (input_sample_rate != m_input_sample_rate)
+    InternalSetInputSampleRate(input_sample_rate);
+
+  // frames left in the resampler would be skipped when switching to the direct copy path, so start over either way
+  const bool dynamic_sync = m_dynamic_sync.load(std::memory_order_relaxed);
+  if (dynamic_sync != m_dynamic_sync_active)
+  {
+    m_dynamic_sync_active = dynamic_sync;
+    ResetResampler();
+  }
+
+  if (m_empty_requested.exchange(false, std::memory_order_acquire))
+  {
+    m_buffer.DiscardUntil(m_empty_position.load(std::memory_order_relaxed));
+    ResetResampler();
+    SignalBufferDrained();
+  }
+}
+
 void AudioStream::CreateResampler()
 {
   m_resampler_state = src_new(SRC_SINC_MEDIUM_QUALITY, static_cast<int>(m_channels), nullptr);
@@ -317,12 +366,29 @@ void AudioStream::ResetResampler()
   m_resample_in_buffer.clear();
   m_resample_out_buffer.clear();
   src_reset(static_cast<SRC_STATE*>(m_resampler_state));
+  m_dynamic_sync_average_fill = static_cast<float>(m_buffer_size);
 }
 
-void AudioStream::ResampleInput(std::unique_lock<std::mutex> buffer_lock)
+double AudioStream::GetDynamicSyncRatio()
 {
-  std::unique_lock<std::mutex> resampler_lock(m_resampler_mutex);
+  // everything queued ahead of the output, in input frames
+  const float fill =
+    static_cast<float>((m_buffer.GetSize() + static_cast<u32>(m_resample_in_buffer.size())) / m_channels) +
+    static_cast<float>(static_cast<double>(m_resampled_buffer.GetSize() / m_channels) / m_resampler_ratio);
+  m_dynamic_sync_average_fill += (fill - m_dynamic_sync_average_fill) * DYNAMIC_SYNC_FILL_SMOOTHING;
+
+  // Aim for half of the buffer, so there's room for the writer's bursts either way. Above the target, produce fewer
+  // output frames per input frame to drain it; below, stretch the input to build it back up. libsamplerate ramps
+  // between the ratios of consecutive calls, so changes don't click.
+  const float target = static_cast<float>(m_buffer_size);
+  const double error = static_cast<double>((m_dynamic_sync_average_fill - target) / target);
+  const double adjustment = std::clamp(error * DYNAMIC_SYNC_MAX_RATIO_ADJUSTMENT, -DYNAMIC_SYNC_MAX_RATIO_ADJUSTMENT,
+                                       DYNAMIC_SYNC_MAX_RATIO_ADJUSTMENT);
+  return m_resampler_ratio * (1.0 - adjustment);
+}
 
+void AudioStream::ResampleInput()
+{
   const u32 input_space_from_output = (m_resampled_buffer.GetSpace() * m_output_sample_rate) / m_input_sample_rate;
   u32 remaining = std::min(m_buffer.GetSize(), input_space_from_output);
   if (m_resample_in_buffer.size() < remaining)
@@ -331,18 +397,17 @@ void AudioStream::ResampleInput(std::unique_lock<std::mutex> buffer_lock)
     m_resample_in_buffer.reserve(m_resample_in_buffer.size() + remaining);
     while (remaining > 0)
     {
-      const u32 read_len = std::min(m_buffer.GetContiguousSize(), remaining);
+      u32 contiguous_size;
+      const SampleType* read_ptr = m_buffer.GetReadPointer(&contiguous_size);
+      const u32 read_len = std::min(contiguous_size, remaining);
       const size_t old_pos = m_resample_in_buffer.size();
       m_resample_in_buffer.resize(m_resample_in_buffer.size() + read_len);
-      src_short_to_float_array(m_buffer.GetReadPointer(), m_resample_in_buffer.data() + old_pos,
-                               static_cast<int>(read_len));
-      m_buffer.Remove(read_len);
+      src_short_to_float_array(read_ptr, m_resample_in_buffer.data() + old_pos, static_cast<int>(read_len));
+      m_buffer.CommitRead(read_len);
       remaining -= read_len;
     }
   }
 
-  ReleaseBufferLock(std::move(buffer_lock));
-
   const u32 potential_output_size =
     (static_cast<u32>(m_resample_in_buffer.size()) * m_input_sample_rate) / m_output_sample_rate;
   const u32 output_size = std::min(potential_output_size, m_resampled_buffer.GetSpace());
@@ -353,7 +418,7 @@ void AudioStream::ResampleInput(std::unique_lock<std::mutex> buffer_lock)
   sd.data_out = m_resample_out_buffer.data();
   sd.input_frames = static_cast<u32>(m_resample_in_buffer.size()) / m_channels;
   sd.output_frames = output_size / m_channels;
-  sd.src_ratio = m_resampler_ratio;
+  sd.src_ratio = m_dynamic_sync_active ? GetDynamicSyncRatio() : m_resampler_ratio;
 
   const int error = src_process(static_cast<SRC_STATE*>(m_resampler_state), &sd);
   if (error)
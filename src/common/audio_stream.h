@@ -1,13 +1,18 @@
 #pragma once
+#include "event.h"
 #include "fifo_queue.h"
+#include "spsc_ring_buffer.h"
 #include "types.h"
 #include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
 #include <vector>
 
 // Uses signed 16-bits samples.
+//
+// The emulation thread is the only writer, and the device callback the only reader, so samples are passed between them
+// through a lock-free ring buffer. Requests from the writer which affect the reader's state (emptying the buffer,
+// changing the input rate) are picked up by the reader the next time it runs. Neither thread ever takes a lock, except
+// when the writer blocks waiting for space in sync mode.
 
 class AudioStream
 {
@@ -29,13 +34,18 @@ public:
   u32 GetOutputSampleRate() const { return m_output_sample_rate; }
   u32 GetChannels() const { return m_channels; }
   u32 GetBufferSize() const { return m_buffer_size; }
-  s32 GetOutputVolume() const { return m_output_volume; }
+  s32 GetOutputVolume() const { return static_cast<s32>(m_output_volume.load(std::memory_order_relaxed)); }
   bool IsSyncing() const { return m_sync; }
+  bool IsDynamicSyncing() const { return m_dynamic_sync.load(std::memory_order_relaxed); }
 
   bool Reconfigure(u32 input_sample_rate = DefaultInputSampleRate, u32 output_sample_rate = DefaultOutputSampleRate,
                    u32 channels = 1, u32 buffer_size = DefaultBufferSize);
   void SetSync(bool enable) { m_sync = enable; }
 
+  /// Instead of blocking the writer, keeps the buffer around half full by nudging the resampling ratio. Meant to be
+  /// used with sync off, when something else (e.g. vsync) paces the writer close to the input sample rate.
+  void SetDynamicSync(bool enable) { m_dynamic_sync.store(enable, std::memory_order_relaxed); }
+
   void SetInputSampleRate(u32 sample_rate);
   void SetWaitForBufferFill(bool enabled);
 
@@ -75,8 +85,8 @@ protected:
   bool SetBufferSize(u32 buffer_size);
   bool IsDeviceOpen() const { return (m_output_sample_rate > 0); }
 
+  // Reader side, only called from the device callback (or the writer, if the device has no thread of its own).
   u32 GetSamplesAvailable() const;
-  u32 GetSamplesAvailableLocked() const;
   void ReadFrames(SampleType* samples, u32 num_frames, bool apply_volume);
   void DropFrames(u32 count);
 
@@ -86,42 +96,59 @@ protected:
   u32 m_buffer_size = 0;
 
   // volume, 0-100
-  u32 m_output_volume = FullVolume;
+  std::atomic<u32> m_output_volume{FullVolume};
 
 private:
+  // Writer-side view, the space can only grow behind the writer's back.
   ALWAYS_INLINE u32 GetBufferSpace() const { return (m_max_samples - m_buffer.GetSize()); }
-  ALWAYS_INLINE void ReleaseBufferLock(std::unique_lock<std::mutex> lock)
-  {
-    // lock is released implicitly by destruction
-    m_buffer_draining_cv.notify_one();
-  }
 
-  void EnsureBuffer(u32 size);
+  bool EnsureBuffer(u32 size);
+  void WaitForBufferSpace(u32 size);
+  void SignalBufferDrained();
+
+  void ResetBuffers();
+  void ApplyReaderRequests();
 
   void CreateResampler();
   void DestroyResampler();
   void ResetResampler();
   void InternalSetInputSampleRate(u32 sample_rate);
-  void ResampleInput(std::unique_lock<std::mutex> buffer_lock);
+  double GetDynamicSyncRatio();
+  void ResampleInput();
 
-  HeapFIFOQueue<SampleType, MaxSamples> m_buffer;
-  mutable std::mutex m_buffer_mutex;
-  std::condition_variable m_buffer_draining_cv;
+  SPSCRingBuffer<SampleType> m_buffer{MaxSamples};
   std::vector<SampleType> m_resample_buffer;
 
+  // Frames written while the buffer is full and sync is off are dropped here.
+  std::vector<SampleType> m_overflow_buffer;
+  bool m_writing_overflow = false;
+
+  // Set while the writer is blocked for space, so the reader only signals when someone is waiting.
+  std::atomic_bool m_writer_waiting{false};
+  Common::Event m_buffer_drained_event{true};
+
+  // Writer requests, applied by the reader. m_empty_position is the write position the buffer is emptied up to.
+  std::atomic<u32> m_requested_input_sample_rate{0};
+  std::atomic<u32> m_empty_position{0};
+  std::atomic_bool m_empty_requested{false};
+
   std::atomic_bool m_underflow_flag{false};
   std::atomic_bool m_buffer_filling{false};
   u32 m_max_samples = 0;
 
   bool m_output_paused = true;
   bool m_sync = true;
-  bool m_wait_for_buffer_fill = false;
+  std::atomic_bool m_dynamic_sync{false};
+  std::atomic_bool m_wait_for_buffer_fill{false};
 
-  // Resampling
+  // Resampling, owned by the reader.
   double m_resampler_ratio = 1.0;
   void* m_resampler_state = nullptr;
-  std::mutex m_resampler_mutex;
   HeapFIFOQueue<SampleType, MaxSamples> m_resampled_buffer;
   std::vector<float> m_resample_in_buffer;
   std::vector<float> m_resample_out_buffer;
+
+  // Dynamic sync, owned by the reader. The fill level is smoothed, as it jumps by a whole video frame every write.
+  bool m_dynamic_sync_active = false;
+  float m_dynamic_sync_average_fill = 0.0f;
 };
\ No newline at end of file
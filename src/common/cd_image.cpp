@@ -14,7 +14,7 @@ u32 CDImage::GetBytesPerSector(TrackMode mode)
   return sizes[static_cast<u32>(mode)];
 }
 
-std::unique_ptr<CDImage> CDImage::Open(const char* filename)
+std::unique_ptr<CDImage> CDImage::Open(const char* filename, u32 chd_hunk_cache_size)
 {
   const char* extension = std::strrchr(filename, '.');
   if (!extension)
@@ -40,7 +40,7 @@ std::unique_ptr<CDImage> CDImage::Open(const char* filename)
   }
   else if (CASE_COMPARE(extension, ".chd") == 0)
   {
-    return OpenCHDImage(filename);
+    return OpenCHDImage(filename, chd_hunk_cache_size);
   }
 
 #undef CASE_COMPARE
@@ -26,7 +26,8 @@ public:
     SECONDS_PER_MINUTE = 60,
     FRAMES_PER_MINUTE = FRAMES_PER_SECOND * SECONDS_PER_MINUTE,
     SUBCHANNEL_BYTES_PER_FRAME = 12,
-    LEAD_OUT_SECTOR_COUNT = 6750
+    LEAD_OUT_SECTOR_COUNT = 6750,
+    DEFAULT_CHD_HUNK_CACHE_SIZE = 1
   };
 
   enum : u8
@@ -191,10 +192,14 @@ public:
   static u32 GetBytesPerSector(TrackMode mode);
 
   // Opening disc image.
-  static std::unique_ptr<CDImage> Open(const char* filename);
+  // chd_hunk_cache_size is the number of decompressed hunks kept for CHD images. Sizes above one also enable
+  // decompressing the following hunks ahead of time on a worker thread, so only pass them when the image is going to
+  // be played, not just probed.
+  static std::unique_ptr<CDImage> Open(const char* filename, u32 chd_hunk_cache_size = DEFAULT_CHD_HUNK_CACHE_SIZE);
   static std::unique_ptr<CDImage> OpenBinImage(const char* filename);
   static std::unique_ptr<CDImage> OpenCueSheetImage(const char* filename);
-  static std::unique_ptr<CDImage> OpenCHDImage(const char* filename);
+  static std::unique_ptr<CDImage> OpenCHDImage(const char* filename,
+                                               u32 hunk_cache_size = DEFAULT_CHD_HUNK_CACHE_SIZE);
   static std::unique_ptr<CDImage>
   CreateMemoryImage(CDImage* image, ProgressCallback* progress = ProgressCallback::NullProgressCallback);
 
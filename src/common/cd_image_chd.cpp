@@ -12,10 +12,13 @@
 #include "log.h"
 #include <algorithm>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <thread>
 Log_SetChannel(CDImageCHD);
 
 static std::optional<CDImage::TrackMode> ParseTrackModeString(const char* str)
@@ -46,7 +49,7 @@ public:
   CDImageCHD();
   ~CDImageCHD() override;
 
-  bool Open(const char* filename);
+  bool Open(const char* filename, u32 hunk_cache_size);
 
   bool ReadSubChannelQ(SubChannelQ* subq) override;
   bool HasNonStandardSubchannel() const override;
@@ -58,18 +61,54 @@ private:
   enum : u32
   {
     CHD_CD_SECTOR_DATA_SIZE = 2352 + 96,
-    CHD_CD_TRACK_ALIGNMENT = 4
+    CHD_CD_TRACK_ALIGNMENT = 4,
+    MAX_PREFETCH_HUNKS = 4,
+    INVALID_HUNK_INDEX = static_cast<u32>(-1)
+  };
+
+  struct CachedHunk
+  {
+    std::unique_ptr<u8[]> data;
+    u32 hunk_index = INVALID_HUNK_INDEX;
+    u32 last_access = 0;
+
+    // set while the hunk is being decompressed, the data is not valid until it is cleared
+    bool pending = false;
   };
 
   bool ReadHunk(u32 hunk_index);
 
+  // These require m_cache_mutex to be held.
+  CachedHunk* LookupHunk(u32 hunk_index);
+  CachedHunk* GetReplacementHunk(bool allow_current);
+
+  void StartPrefetchThread(const char* filename);
+  void StopPrefetchThread();
+  void PrefetchThreadEntryPoint();
+
   std::FILE* m_fp = nullptr;
   chd_file* m_chd = nullptr;
   u32 m_hunk_size = 0;
+  u32 m_hunk_count = 0;
   u32 m_sectors_per_hunk = 0;
 
-  std::vector<u8> m_hunk_buffer;
-  u32 m_current_hunk_index = static_cast<u32>(-1);
+  // LRU cache of decompressed hunks. The current hunk is only changed by the reading thread, and is never evicted by
+  // the prefetch thread, so sectors can be copied out of it without holding the lock.
+  std::vector<CachedHunk> m_hunk_cache;
+  CachedHunk* m_current_hunk = nullptr;
+  u32 m_access_counter = 0;
+  std::mutex m_cache_mutex;
+  std::condition_variable m_hunk_ready_cv;
+
+  // chd_file isn't thread-safe, so the prefetch thread decompresses from its own handle.
+  std::FILE* m_prefetch_fp = nullptr;
+  chd_file* m_prefetch_chd = nullptr;
+  std::thread m_prefetch_thread;
+  std::condition_variable m_prefetch_cv;
+  u32 m_prefetch_hunk_index = INVALID_HUNK_INDEX;
+  u32 m_prefetch_hunks_remaining = 0;
+  u32 m_prefetch_depth = 0;
+  bool m_prefetch_shutdown = false;
 
   CDSubChannelReplacement m_sbi;
 };
@@ -78,13 +117,15 @@ CDImageCHD::CDImageCHD() = default;
 
 CDImageCHD::~CDImageCHD()
 {
+  StopPrefetchThread();
+
   if (m_chd)
     chd_close(m_chd);
   if (m_fp)
     std::fclose(m_fp);
 }
 
-bool CDImageCHD::Open(const char* filename)
+bool CDImageCHD::Open(const char* filename, u32 hunk_cache_size)
 {
   Assert(!m_fp);
   m_fp = FileSystem::OpenCFile(filename, "rb");
@@ -110,7 +151,10 @@ bool CDImageCHD::Open(const char* filename)
   }
 
   m_sectors_per_hunk = m_hunk_size / CHD_CD_SECTOR_DATA_SIZE;
-  m_hunk_buffer.resize(m_hunk_size);
+  m_hunk_count = header->totalhunks;
+  m_hunk_cache.resize(std::max(hunk_cache_size, 1u));
+  for (CachedHunk& hunk : m_hunk_cache)
+    hunk.data = std::make_unique<u8[]>(m_hunk_size);
   m_filename = filename;
 
   u32 disc_lba = 0;
@@ -250,9 +294,100 @@ bool CDImageCHD::Open(const char* filename)
 
   m_sbi.LoadSBI(FileSystem::ReplaceExtension(filename, "sbi").c_str());
 
+  // keep at least one hunk behind the read position and the current hunk out of the prefetch's way
+  m_prefetch_depth = std::min<u32>(static_cast<u32>(m_hunk_cache.size()) / 2, MAX_PREFETCH_HUNKS);
+  if (m_prefetch_depth > 0)
+    StartPrefetchThread(filename);
+
   return Seek(1, Position{0, 0, 0});
 }
 
+void CDImageCHD::StartPrefetchThread(const char* filename)
+{
+  m_prefetch_fp = FileSystem::OpenCFile(filename, "rb");
+  if (!m_prefetch_fp)
+  {
+    Log_WarningPrintf("Failed to reopen CHD '%s' for prefetching: errno %d", filename, errno);
+    m_prefetch_depth = 0;
+    return;
+  }
+
+  const chd_error err = chd_open_file(m_prefetch_fp, CHD_OPEN_READ, nullptr, &m_prefetch_chd);
+  if (err != CHDERR_NONE)
+  {
+    Log_WarningPrintf("Failed to reopen CHD '%s' for prefetching: %s", filename, chd_error_string(err));
+    std::fclose(m_prefetch_fp);
+    m_prefetch_fp = nullptr;
+    m_prefetch_depth = 0;
+    return;
+  }
+
+  m_prefetch_thread = std::thread(&CDImageCHD::PrefetchThreadEntryPoint, this);
+}
+
+void CDImageCHD::StopPrefetchThread()
+{
+  if (m_prefetch_thread.joinable())
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_cache_mutex);
+      m_prefetch_shutdown = true;
+      m_prefetch_cv.notify_one();
+    }
+
+    m_prefetch_thread.join();
+  }
+
+  if (m_prefetch_chd)
+  {
+    chd_close(m_prefetch_chd);
+    m_prefetch_chd = nullptr;
+  }
+
+  if (m_prefetch_fp)
+  {
+    std::fclose(m_prefetch_fp);
+    m_prefetch_fp = nullptr;
+  }
+}
+
+void CDImageCHD::PrefetchThreadEntryPoint()
+{
+  std::unique_lock<std::mutex> lock(m_cache_mutex);
+  for (;;)
+  {
+    m_prefetch_cv.wait(lock, [this]() { return m_prefetch_shutdown || m_prefetch_hunks_remaining > 0; });
+    if (m_prefetch_shutdown)
+      break;
+
+    const u32 hunk_index = m_prefetch_hunk_index++;
+    m_prefetch_hunks_remaining--;
+    if (hunk_index >= m_hunk_count || LookupHunk(hunk_index))
+      continue;
+
+    CachedHunk* hunk = GetReplacementHunk(false);
+    if (!hunk)
+      continue;
+
+    hunk->hunk_index = hunk_index;
+    hunk->last_access = ++m_access_counter;
+    hunk->pending = true;
+
+    lock.unlock();
+    const chd_error err = chd_read(m_prefetch_chd, hunk_index, hunk->data.get());
+    lock.lock();
+
+    hunk->pending = false;
+    if (err != CHDERR_NONE)
+    {
+      Log_WarningPrintf("Prefetch of hunk %u failed: %s", hunk_index, chd_error_string(err));
+      hunk->hunk_index = INVALID_HUNK_INDEX;
+    }
+
+    m_hunk_ready_cv.notify_all();
+  }
+}
+
 bool CDImageCHD::ReadSubChannelQ(SubChannelQ* subq)
 {
   if (m_sbi.GetReplacementSubChannelQ(m_position_on_disc, subq))
@@ -315,38 +450,103 @@ bool CDImageCHD::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
   const u32 hunk_offset = static_cast<u32>((disc_frame % m_sectors_per_hunk) * CHD_CD_SECTOR_DATA_SIZE);
   DebugAssert((m_hunk_size - hunk_offset) >= CHD_CD_SECTOR_DATA_SIZE);
 
-  if (m_current_hunk_index != hunk_index && !ReadHunk(hunk_index))
+  if ((!m_current_hunk || m_current_hunk->hunk_index != hunk_index) && !ReadHunk(hunk_index))
     return false;
 
   // Audio data is in big-endian, so we have to swap it for little endian hosts...
+  const u8* hunk_data = m_current_hunk->data.get();
   if (index.mode == TrackMode::Audio)
-    CopyAndSwap(buffer, &m_hunk_buffer[hunk_offset], RAW_SECTOR_SIZE);
+    CopyAndSwap(buffer, &hunk_data[hunk_offset], RAW_SECTOR_SIZE);
   else
-    std::memcpy(buffer, &m_hunk_buffer[hunk_offset], RAW_SECTOR_SIZE);
+    std::memcpy(buffer, &hunk_data[hunk_offset], RAW_SECTOR_SIZE);
 
   return true;
 }
 
+CDImageCHD::CachedHunk* CDImageCHD::LookupHunk(u32 hunk_index)
+{
+  for (CachedHunk& hunk : m_hunk_cache)
+  {
+    if (hunk.hunk_index == hunk_index)
+      return &hunk;
+  }
+
+  return nullptr;
+}
+
+CDImageCHD::CachedHunk* CDImageCHD::GetReplacementHunk(bool allow_current)
+{
+  CachedHunk* lru_hunk = nullptr;
+  for (CachedHunk& hunk : m_hunk_cache)
+  {
+    if (hunk.pending || (!allow_current && &hunk == m_current_hunk))
+      continue;
+
+    if (hunk.hunk_index == INVALID_HUNK_INDEX)
+      return &hunk;
+
+    if (!lru_hunk || hunk.last_access < lru_hunk->last_access)
+      lru_hunk = &hunk;
+  }
+
+  return lru_hunk;
+}
+
 bool CDImageCHD::ReadHunk(u32 hunk_index)
 {
-  const chd_error err = chd_read(m_chd, hunk_index, m_hunk_buffer.data());
-  if (err != CHDERR_NONE)
+  std::unique_lock<std::mutex> lock(m_cache_mutex);
+
+  // if the prefetch thread is still decompressing it, wait for it rather than doing it twice
+  CachedHunk* hunk = LookupHunk(hunk_index);
+  if (hunk && hunk->pending)
   {
-    Log_ErrorPrintf("chd_read(%u) failed: %s", hunk_index, chd_error_string(err));
+    m_hunk_ready_cv.wait(lock, [hunk, hunk_index]() { return !hunk->pending || hunk->hunk_index != hunk_index; });
+    if (hunk->hunk_index != hunk_index)
+      hunk = nullptr;
+  }
 
-    // data might have been partially written
-    m_current_hunk_index = static_cast<u32>(-1);
-    return false;
+  if (!hunk)
+  {
+    // only one prefetch can be in flight, so with at least two slots there is always something we can replace
+    m_hunk_ready_cv.wait(lock, [this, &hunk]() { return (hunk = GetReplacementHunk(true)) != nullptr; });
+    hunk->hunk_index = hunk_index;
+    hunk->pending = true;
+    if (hunk == m_current_hunk)
+      m_current_hunk = nullptr;
+
+    lock.unlock();
+    const chd_error err = chd_read(m_chd, hunk_index, hunk->data.get());
+    lock.lock();
+
+    hunk->pending = false;
+    if (err != CHDERR_NONE)
+    {
+      Log_ErrorPrintf("chd_read(%u) failed: %s", hunk_index, chd_error_string(err));
+
+      // data might have been partially written
+      hunk->hunk_index = INVALID_HUNK_INDEX;
+      return false;
+    }
+  }
+
+  hunk->last_access = ++m_access_counter;
+  m_current_hunk = hunk;
+
+  // start decompressing the hunks after this one, replacing any older request
+  if (m_prefetch_depth > 0)
+  {
+    m_prefetch_hunk_index = hunk_index + 1;
+    m_prefetch_hunks_remaining = m_prefetch_depth;
+    m_prefetch_cv.notify_one();
   }
 
-  m_current_hunk_index = hunk_index;
   return true;
 }
 
-std::unique_ptr<CDImage> CDImage::OpenCHDImage(const char* filename)
+std::unique_ptr<CDImage> CDImage::OpenCHDImage(const char* filename, u32 hunk_cache_size)
 {
   std::unique_ptr<CDImageCHD> image = std::make_unique<CDImageCHD>();
-  if (!image->Open(filename))
+  if (!image->Open(filename, hunk_cache_size))
     return {};
 
   return image;
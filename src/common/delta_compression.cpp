@@ -0,0 +1,162 @@
+#include "delta_compression.h"
+#include <algorithm>
+#include <cstring>
+
+namespace DeltaCompression {
+
+enum : u32
+{
+  FLAG_KEYFRAME = (1u << 0),
+
+  // Zero runs shorter than this are folded into the surrounding literal, as the run header costs more.
+  MIN_ZERO_RUN = 4,
+};
+
+#pragma pack(push, 1)
+struct DeltaHeader
+{
+  u32 target_size;
+  u32 flags;
+};
+
+struct RunHeader
+{
+  u16 zero_count;
+  u16 literal_count;
+};
+#pragma pack(pop)
+
+template<typename T>
+static void AppendValue(std::vector<u8>* dst, const T& value)
+{
+  const size_t pos = dst->size();
+  dst->resize(pos + sizeof(T));
+  std::memcpy(dst->data() + pos, &value, sizeof(T));
+}
+
+static void EncodePage(std::vector<u8>* dst, const u8* xor_data, u32 size)
+{
+  u32 pos = 0;
+  while (pos < size)
+  {
+    u32 zero_count = 0;
+    while ((pos + zero_count) < size && xor_data[pos + zero_count] == 0)
+      zero_count++;
+    pos += zero_count;
+
+    const u32 literal_start = pos;
+    while (pos < size)
+    {
+      if (xor_data[pos] != 0)
+      {
+        pos++;
+        continue;
+      }
+
+      // only break the literal when there's a long enough run of zeros
+      u32 run = 0;
+      while ((pos + run) < size && xor_data[pos + run] == 0 && run < MIN_ZERO_RUN)
+        run++;
+      if (run == MIN_ZERO_RUN || (pos + run) == size)
+        break;
+
+      pos += run;
+    }
+
+    const u32 literal_count = pos - literal_start;
+    AppendValue(dst, RunHeader{static_cast<u16>(zero_count), static_cast<u16>(literal_count)});
+    if (literal_count > 0)
+    {
+      const size_t out_pos = dst->size();
+      dst->resize(out_pos + literal_count);
+      std::memcpy(dst->data() + out_pos, xor_data + literal_start, literal_count);
+    }
+  }
+}
+
+void Encode(std::vector<u8>* dst, const void* base_data, u32 base_size, const void* target_data, u32 target_size)
+{
+  const u8* base_ptr = static_cast<const u8*>(base_data);
+  const u8* target_ptr = static_cast<const u8*>(target_data);
+  AppendValue(dst, DeltaHeader{target_size, base_ptr ? 0u : static_cast<u32>(FLAG_KEYFRAME)});
+
+  if (!base_ptr)
+    base_size = 0;
+
+  u8 xor_page[PAGE_SIZE];
+  const u32 num_pages = (target_size + (PAGE_SIZE - 1)) / PAGE_SIZE;
+  for (u32 page = 0; page < num_pages; page++)
+  {
+    const u32 page_start = page * PAGE_SIZE;
+    const u32 page_size = std::min<u32>(target_size - page_start, PAGE_SIZE);
+    const u32 base_page_size = (page_start < base_size) ? std::min<u32>(base_size - page_start, page_size) : 0;
+    if (base_page_size == page_size && std::memcmp(base_ptr + page_start, target_ptr + page_start, page_size) == 0)
+      continue;
+
+    for (u32 i = 0; i < base_page_size; i++)
+      xor_page[i] = base_ptr[page_start + i] ^ target_ptr[page_start + i];
+    std::memcpy(xor_page + base_page_size, target_ptr + page_start + base_page_size, page_size - base_page_size);
+
+    AppendValue(dst, page);
+    EncodePage(dst, xor_page, page_size);
+  }
+}
+
+bool Apply(std::vector<u8>* data, const void* delta, u32 delta_size)
+{
+  const u8* in_ptr = static_cast<const u8*>(delta);
+  const u8* in_end = in_ptr + delta_size;
+  if (delta_size < sizeof(DeltaHeader))
+    return false;
+
+  DeltaHeader header;
+  std::memcpy(&header, in_ptr, sizeof(header));
+  in_ptr += sizeof(header);
+
+  if (header.flags & FLAG_KEYFRAME)
+    data->assign(header.target_size, 0);
+  else
+    data->resize(std::max<size_t>(data->size(), header.target_size), 0);
+
+  // bytes past the base size are implicitly zero in the base, so the XOR produces the target directly
+  u8* out_ptr = data->data();
+  while (in_ptr != in_end)
+  {
+    u32 page;
+    if (static_cast<size_t>(in_end - in_ptr) < sizeof(page))
+      return false;
+    std::memcpy(&page, in_ptr, sizeof(page));
+    in_ptr += sizeof(page);
+
+    const u64 page_start = static_cast<u64>(page) * PAGE_SIZE;
+    if (page_start >= header.target_size)
+      return false;
+
+    const u32 page_size = std::min<u32>(header.target_size - static_cast<u32>(page_start), PAGE_SIZE);
+    u32 pos = 0;
+    while (pos < page_size)
+    {
+      RunHeader run;
+      if (static_cast<size_t>(in_end - in_ptr) < sizeof(run))
+        return false;
+      std::memcpy(&run, in_ptr, sizeof(run));
+      in_ptr += sizeof(run);
+
+      pos += run.zero_count;
+      if ((pos + run.literal_count) > page_size || static_cast<size_t>(in_end - in_ptr) < run.literal_count)
+        return false;
+
+      u8* page_ptr = out_ptr + page_start + pos;
+      for (u32 i = 0; i < run.literal_count; i++)
+        page_ptr[i] ^= in_ptr[i];
+
+      in_ptr += run.literal_count;
+      pos += run.literal_count;
+    }
+  }
+
+  data->resize(header.target_size);
+  return true;
+}
+
+} // namespace DeltaCompression
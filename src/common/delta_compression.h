@@ -0,0 +1,22 @@
+#pragma once
+#include "types.h"
+#include <vector>
+
+// Page-granular XOR/RLE delta encoding, used for compressing memory save states against each other.
+// Pages which are identical between the base and target are skipped entirely, and pages which differ store the
+// XOR of the two pages as runs of zero/literal bytes.
+namespace DeltaCompression {
+
+enum : u32
+{
+  PAGE_SIZE = 4096
+};
+
+/// Appends a delta to dst which transforms base_data into target_data when applied.
+/// If base_data is null, the delta is a keyframe, and can be applied to any buffer.
+void Encode(std::vector<u8>* dst, const void* base_data, u32 base_size, const void* target_data, u32 target_size);
+
+/// Applies a delta produced by Encode() to data in place, resizing it to the target size.
+bool Apply(std::vector<u8>* data, const void* delta, u32 delta_size);
+
+} // namespace DeltaCompression
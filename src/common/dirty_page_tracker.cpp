@@ -0,0 +1,99 @@
+#include "dirty_page_tracker.h"
+#include "assert.h"
+#include <algorithm>
+#include <cstring>
+
+DirtyPageTracker::DirtyPageTracker(u32 memory_size, u32 page_shift)
+  : m_memory_size(memory_size), m_page_shift(page_shift)
+{
+  const u32 page_count = (memory_size + ((1u << page_shift) - 1)) >> page_shift;
+  m_page_dirty.resize(page_count, 0);
+
+  // pages start out newer than any snapshot, so the first update copies everything
+  m_page_generation.resize(page_count, m_generation);
+}
+
+DirtyPageTracker::~DirtyPageTracker() = default;
+
+void DirtyPageTracker::MarkRangeDirty(u32 offset, u32 size)
+{
+  if (size == 0)
+    return;
+
+  const u32 start_page = offset >> m_page_shift;
+  const u32 end_page = std::min<u32>((offset + size - 1) >> m_page_shift, GetPageCount() - 1);
+  for (u32 page = start_page; page <= end_page; page++)
+    m_page_dirty[page] = 1;
+}
+
+void DirtyPageTracker::MarkAllDirty()
+{
+  std::fill(m_page_dirty.begin(), m_page_dirty.end(), static_cast<u8>(1));
+}
+
+void DirtyPageTracker::FoldDirtyPages()
+{
+  const u32 page_count = GetPageCount();
+  for (u32 page = 0; page < page_count; page++)
+  {
+    if (m_page_dirty[page])
+    {
+      m_page_generation[page] = m_generation;
+      m_page_dirty[page] = 0;
+    }
+  }
+}
+
+u32 DirtyPageTracker::UpdateSnapshot(Snapshot* snapshot, const u8* memory)
+{
+  FoldDirtyPages();
+
+  if (!snapshot->data)
+  {
+    snapshot->data = std::make_unique<u8[]>(m_memory_size);
+    snapshot->generation = 0;
+  }
+
+  const u32 page_size = GetPageSize();
+  const u32 page_count = GetPageCount();
+  u32 pages_copied = 0;
+  for (u32 page = 0; page < page_count; page++)
+  {
+    if (m_page_generation[page] <= snapshot->generation)
+      continue;
+
+    const u32 offset = page << m_page_shift;
+    std::memcpy(&snapshot->data[offset], memory + offset, std::min(page_size, m_memory_size - offset));
+    pages_copied++;
+  }
+
+  // writes from now on belong to a newer generation than the snapshot
+  snapshot->generation = m_generation++;
+  return pages_copied;
+}
+
+u32 DirtyPageTracker::RestoreSnapshot(Snapshot* snapshot, u8* memory)
+{
+  Assert(snapshot->data);
+  FoldDirtyPages();
+
+  const u32 page_size = GetPageSize();
+  const u32 page_count = GetPageCount();
+  u32 pages_copied = 0;
+  for (u32 page = 0; page < page_count; page++)
+  {
+    if (m_page_generation[page] <= snapshot->generation)
+      continue;
+
+    const u32 offset = page << m_page_shift;
+    std::memcpy(memory + offset, &snapshot->data[offset], std::min(page_size, m_memory_size - offset));
+
+    // the page changed as far as every other snapshot is concerned
+    m_page_generation[page] = m_generation;
+    pages_copied++;
+  }
+
+  // memory now matches this snapshot exactly
+  snapshot->generation = m_generation++;
+  return pages_copied;
+}
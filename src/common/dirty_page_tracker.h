@@ -0,0 +1,48 @@
+#pragma once
+#include "types.h"
+#include <memory>
+#include <vector>
+
+// Tracks which pages of a block of memory have been written, so that snapshots of it can be brought up to date (or
+// restored) by copying only the pages which changed since the snapshot was last synchronized.
+//
+// Writes are recorded with MarkDirty() into a per-page flag array, which is cheap enough to do on every store.
+// Each snapshot remembers the generation it was last synchronized at, and each page the generation it was last
+// written in, so any number of snapshots can be kept against the same memory.
+class DirtyPageTracker
+{
+public:
+  struct Snapshot
+  {
+    std::unique_ptr<u8[]> data;
+    u32 generation = 0;
+  };
+
+  DirtyPageTracker(u32 memory_size, u32 page_shift);
+  ~DirtyPageTracker();
+
+  ALWAYS_INLINE u32 GetMemorySize() const { return m_memory_size; }
+  ALWAYS_INLINE u32 GetPageSize() const { return (1u << m_page_shift); }
+  ALWAYS_INLINE u32 GetPageCount() const { return static_cast<u32>(m_page_dirty.size()); }
+
+  ALWAYS_INLINE void MarkDirty(u32 offset) { m_page_dirty[offset >> m_page_shift] = 1; }
+  void MarkRangeDirty(u32 offset, u32 size);
+  void MarkAllDirty();
+
+  /// Copies pages which were written since the snapshot was last synchronized. Returns the number of pages copied.
+  u32 UpdateSnapshot(Snapshot* snapshot, const u8* memory);
+
+  /// Copies pages which were written since the snapshot was last synchronized back to memory. Returns the number
+  /// of pages copied. The snapshot must have been updated at least once.
+  u32 RestoreSnapshot(Snapshot* snapshot, u8* memory);
+
+private:
+  void FoldDirtyPages();
+
+  u32 m_memory_size;
+  u32 m_page_shift;
+  u32 m_generation = 1;
+
+  std::vector<u8> m_page_dirty;
+  std::vector<u32> m_page_generation;
+};
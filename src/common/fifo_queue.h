@@ -126,6 +126,27 @@ public:
     return val;
   }
 
+  // faster version of PopRange for POD types which can be memcpy()ed
+  template<class Y = T, std::enable_if_t<std::is_pod_v<Y>, int> = 0>
+  void PopRange(T* out_data, u32 count)
+  {
+    DebugAssert(m_size >= count);
+    const u32 size_before_end = std::min(CAPACITY - m_head, count);
+    const u32 size_after_end = count - size_before_end;
+
+    std::memcpy(out_data, &m_ptr[m_head], sizeof(T) * size_before_end);
+    m_head = (m_head + size_before_end) % CAPACITY;
+
+    if (size_after_end > 0)
+    {
+      std::memcpy(out_data + size_before_end, &m_ptr[m_head], sizeof(T) * size_after_end);
+      m_head = (m_head + size_after_end) % CAPACITY;
+    }
+
+    m_size -= count;
+  }
+
+  template<class Y = T, std::enable_if_t<!std::is_pod_v<Y>, int> = 0>
   void PopRange(T* out_data, u32 count)
   {
     DebugAssert(m_size >= count);
@@ -3,6 +3,7 @@
 #include "file_system.h"
 #include "log.h"
 #include "stb_image.h"
+#include "stb_image_resize.h"
 #include "stb_image_write.h"
 #include "string_util.h"
 Log_SetChannel(Common::Image);
@@ -121,4 +122,24 @@ bool WriteImageToFile(const RGBA8Image& image, const char* filename)
   return true;
 }
 
+bool ResizeImage(RGBA8Image* image, u32 new_width, u32 new_height)
+{
+  if (image->GetWidth() == new_width && image->GetHeight() == new_height)
+    return true;
+
+  RGBA8Image resized_image;
+  resized_image.SetSize(new_width, new_height);
+  if (!stbir_resize_uint8(reinterpret_cast<const u8*>(image->GetPixels()), image->GetWidth(), image->GetHeight(),
+                          image->GetByteStride(), reinterpret_cast<u8*>(resized_image.GetPixels()), new_width,
+                          new_height, resized_image.GetByteStride(), 4))
+  {
+    Log_ErrorPrintf("Failed to resize image from %ux%u to %ux%u", image->GetWidth(), image->GetHeight(), new_width,
+                    new_height);
+    return false;
+  }
+
+  *image = std::move(resized_image);
+  return true;
+}
+
 } // namespace Common
\ No newline at end of file
@@ -98,5 +98,6 @@ bool LoadImageFromFile(Common::RGBA8Image* image, const char* filename);
 bool LoadImageFromBuffer(Common::RGBA8Image* image, const void* buffer, std::size_t buffer_size);
 bool LoadImageFromStream(Common::RGBA8Image* image, ByteStream* stream);
 bool WriteImageToFile(const Common::RGBA8Image& image, const char* filename);
+bool ResizeImage(Common::RGBA8Image* image, u32 new_width, u32 new_height);
 
 } // namespace Common
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+#include "assert.h"
+#include "types.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// Wait-free ring buffer for exactly one producer thread and one consumer thread. The read and write positions are
+// free-running counters, masked when indexing, so the buffer can be filled completely. The capacity must be a power of
+// two.
+//
+// The producer only calls the Write/GetWrite* methods, and the consumer only the Read/GetRead*/Discard* methods. The
+// size can be queried from either thread, but is only exact from the consumer's point of view for reading, and from
+// the producer's for writing.
+template<typename T>
+class SPSCRingBuffer
+{
+  static_assert(std::is_trivially_copyable_v<T>, "ring buffer elements are copied with memcpy()");
+
+public:
+  SPSCRingBuffer() = default;
+  explicit SPSCRingBuffer(u32 capacity) { Reset(capacity); }
+
+  u32 GetCapacity() const { return m_capacity; }
+  u32 GetSize() const
+  {
+    return m_write_pos.load(std::memory_order_acquire) - m_read_pos.load(std::memory_order_acquire);
+  }
+  u32 GetSpace() const { return m_capacity - GetSize(); }
+  bool IsEmpty() const { return GetSize() == 0; }
+
+  /// Reallocates the buffer and discards its contents. Neither thread can be using the buffer.
+  void Reset(u32 capacity)
+  {
+    Assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    if (capacity != m_capacity)
+    {
+      m_data = std::make_unique<T[]>(capacity);
+      m_capacity = capacity;
+      m_mask = capacity - 1;
+    }
+
+    Clear();
+  }
+
+  /// Discards the contents. Neither thread can be using the buffer.
+  void Clear()
+  {
+    m_write_pos.store(0, std::memory_order_relaxed);
+    m_read_pos.store(0, std::memory_order_relaxed);
+  }
+
+  /// Producer: returns the position the next element will be written to, for DiscardUntil().
+  u32 GetWritePosition() const { return m_write_pos.load(std::memory_order_relaxed); }
+
+  /// Producer: returns a pointer to the free space at the write position, and how much of it is contiguous.
+  T* GetWritePointer(u32* contiguous_space)
+  {
+    const u32 write_pos = m_write_pos.load(std::memory_order_relaxed);
+    const u32 space = m_capacity - (write_pos - m_read_pos.load(std::memory_order_acquire));
+    const u32 offset = write_pos & m_mask;
+    *contiguous_space = std::min(space, m_capacity - offset);
+    return &m_data[offset];
+  }
+
+  /// Producer: publishes elements which were written through GetWritePointer().
+  void CommitWrite(u32 count)
+  {
+    DebugAssert(count <= GetSpace());
+    m_write_pos.store(m_write_pos.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+  /// Producer: copies as many elements as fit, returns the number written.
+  u32 Write(const T* data, u32 count)
+  {
+    u32 written = 0;
+    while (written < count)
+    {
+      u32 contiguous_space;
+      T* ptr = GetWritePointer(&contiguous_space);
+      const u32 copy_count = std::min(contiguous_space, count - written);
+      if (copy_count == 0)
+        break;
+
+      std::memcpy(ptr, data + written, sizeof(T) * copy_count);
+      CommitWrite(copy_count);
+      written += copy_count;
+    }
+
+    return written;
+  }
+
+  /// Consumer: returns a pointer to the elements at the read position, and how many of them are contiguous.
+  const T* GetReadPointer(u32* contiguous_size) const
+  {
+    const u32 read_pos = m_read_pos.load(std::memory_order_relaxed);
+    const u32 size = m_write_pos.load(std::memory_order_acquire) - read_pos;
+    const u32 offset = read_pos & m_mask;
+    *contiguous_size = std::min(size, m_capacity - offset);
+    return &m_data[offset];
+  }
+
+  /// Consumer: releases elements which were read through GetReadPointer() back to the producer.
+  void CommitRead(u32 count)
+  {
+    DebugAssert(count <= GetSize());
+    m_read_pos.store(m_read_pos.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+  /// Consumer: copies up to count elements out, returns the number read.
+  u32 Read(T* data, u32 count)
+  {
+    u32 read = 0;
+    while (read < count)
+    {
+      u32 contiguous_size;
+      const T* ptr = GetReadPointer(&contiguous_size);
+      const u32 copy_count = std::min(contiguous_size, count - read);
+      if (copy_count == 0)
+        break;
+
+      std::memcpy(data + read, ptr, sizeof(T) * copy_count);
+      CommitRead(copy_count);
+      read += copy_count;
+    }
+
+    return read;
+  }
+
+  /// Consumer: drops up to count elements, returns the number dropped.
+  u32 Discard(u32 count)
+  {
+    const u32 read_pos = m_read_pos.load(std::memory_order_relaxed);
+    const u32 discard_count = std::min(count, m_write_pos.load(std::memory_order_acquire) - read_pos);
+    m_read_pos.store(read_pos + discard_count, std::memory_order_release);
+    return discard_count;
+  }
+
+  /// Consumer: drops everything before a position returned by GetWritePosition(), which lets the producer empty the
+  /// buffer without touching the read position.
+  void DiscardUntil(u32 write_position)
+  {
+    const u32 read_pos = m_read_pos.load(std::memory_order_relaxed);
+    if (static_cast<s32>(write_position - read_pos) > 0)
+      m_read_pos.store(write_position, std::memory_order_release);
+  }
+
+private:
+  // keep the positions on separate cache lines, so the threads don't invalidate each other's reads of the data
+  static constexpr u32 CACHE_LINE_SIZE = 64;
+
+  std::unique_ptr<T[]> m_data;
+  u32 m_capacity = 0;
+  u32 m_mask = 0;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<u32> m_write_pos{0};
+  alignas(CACHE_LINE_SIZE) std::atomic<u32> m_read_pos{0};
+};
@@ -88,6 +88,8 @@ static u32 m_ram_size_reg = 0;
 
 static std::string m_tty_line_buffer;
 
+static DirtyPageTracker m_ram_dirty_pages(RAM_SIZE, HOST_PAGE_SHIFT);
+
 static Common::MemoryArena m_memory_arena;
 
 static CPUFastmemMode m_fastmem_mode = CPUFastmemMode::Disabled;
@@ -167,17 +169,36 @@ void Reset()
   m_MEMCTRL.common_delay.bits = 0x00031125;
   m_ram_size_reg = UINT32_C(0x00000B88);
   m_ram_code_bits = {};
+  m_ram_dirty_pages.MarkAllDirty();
   RecalculateMemoryTimings();
 }
 
-bool DoState(StateWrapper& sw)
+bool DoState(StateWrapper& sw, DirtyPageTracker::Snapshot* ram_snapshot)
 {
   sw.Do(&m_exp1_access_time);
   sw.Do(&m_exp2_access_time);
   sw.Do(&m_bios_access_time);
   sw.Do(&m_cdrom_access_time);
   sw.Do(&m_spu_access_time);
-  sw.DoBytes(g_ram, RAM_SIZE);
+
+  if (ram_snapshot)
+  {
+    // Fastmem stores don't go through the bus, so we can't tell which pages they touched.
+    if (m_fastmem_mode != CPUFastmemMode::Disabled)
+      m_ram_dirty_pages.MarkAllDirty();
+
+    if (sw.IsReading())
+      m_ram_dirty_pages.RestoreSnapshot(ram_snapshot, g_ram);
+    else
+      m_ram_dirty_pages.UpdateSnapshot(ram_snapshot, g_ram);
+  }
+  else
+  {
+    sw.DoBytes(g_ram, RAM_SIZE);
+    if (sw.IsReading())
+      m_ram_dirty_pages.MarkAllDirty();
+  }
+
   sw.DoBytes(g_bios, BIOS_SIZE);
   sw.DoArray(m_MEMCTRL.regs, countof(m_MEMCTRL.regs));
   sw.Do(&m_ram_size_reg);
@@ -467,6 +488,11 @@ bool CanUseFastmemForAddress(VirtualMemoryAddress address)
   }
 }
 
+void MarkRAMRangeDirty(u32 offset, u32 size)
+{
+  m_ram_dirty_pages.MarkRangeDirty(offset, size);
+}
+
 bool IsRAMCodePage(u32 index)
 {
   return m_ram_code_bits[index];
@@ -749,6 +775,7 @@ ALWAYS_INLINE static TickCount DoRAMAccess(u32 offset, u32& value)
     const u32 page_index = offset / HOST_PAGE_SIZE;
     if (m_ram_code_bits[page_index])
       CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+    m_ram_dirty_pages.MarkDirty(offset);
 
     if constexpr (size == MemoryAccessSize::Byte)
     {
@@ -1,5 +1,6 @@
 #pragma once
 #include "common/bitfield.h"
+#include "common/dirty_page_tracker.h"
 #include "common/memory_arena.h"
 #include "types.h"
 #include <array>
@@ -97,7 +98,9 @@ enum : size_t
 bool Initialize();
 void Shutdown();
 void Reset();
-bool DoState(StateWrapper& sw);
+
+/// When ram_snapshot is non-null, RAM is synchronized with the snapshot instead of being written to the stream.
+bool DoState(StateWrapper& sw, DirtyPageTracker::Snapshot* ram_snapshot);
 
 CPUFastmemMode GetFastmemMode();
 void UpdateFastmemViews(CPUFastmemMode mode, bool isolate_cache);
@@ -122,6 +125,9 @@ ALWAYS_INLINE static u32 GetRAMCodePageIndex(PhysicalMemoryAddress address)
   return (address & RAM_MASK) / HOST_PAGE_SIZE;
 }
 
+/// Flags a range of RAM as written since the last memory state snapshot.
+void MarkRAMRangeDirty(u32 offset, u32 size);
+
 /// Returns true if the specified page contains code.
 bool IsRAMCodePage(u32 index);
 
@@ -88,7 +88,7 @@ void CDROM::Initialize()
     this, false);
 
   if (g_settings.cdrom_read_thread)
-    m_reader.StartThread();
+    m_reader.StartThread(g_settings.cdrom_readahead_sectors);
 
   Reset();
 }
@@ -323,13 +323,10 @@ std::unique_ptr<CDImage> CDROM::RemoveMedia(bool force /* = false */)
   return image;
 }
 
-void CDROM::SetUseReadThread(bool enabled)
+void CDROM::SetReadThread(bool enabled, u32 readahead_sectors)
 {
-  if (enabled == m_reader.IsUsingThread())
-    return;
-
   if (enabled)
-    m_reader.StartThread();
+    m_reader.StartThread(readahead_sectors);
   else
     m_reader.StopThread();
 }
@@ -1834,6 +1831,8 @@ void CDROM::StopReadingWithDataEnd()
 
 void CDROM::DoSectorRead()
 {
+  System::ScopedFrameTiming frame_timing(System::FrameTimingComponent::CDROM);
+
   if (!m_reader.WaitForReadToComplete())
     Panic("Sector read failed");
 
@@ -43,7 +43,7 @@ public:
   // Render statistics debug window.
   void DrawDebugWindow();
 
-  void SetUseReadThread(bool enabled);
+  void SetReadThread(bool enabled, u32 readahead_sectors);
 
   /// Reads a frame from the audio FIFO, used by the SPU.
   ALWAYS_INLINE std::tuple<s16, s16> GetAudioFrame()
@@ -2,19 +2,31 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/timer.h"
+#include <algorithm>
 Log_SetChannel(CDROMAsyncReader);
 
-CDROMAsyncReader::CDROMAsyncReader() = default;
+CDROMAsyncReader::CDROMAsyncReader()
+{
+  m_buffers.resize(1);
+}
 
 CDROMAsyncReader::~CDROMAsyncReader()
 {
   StopThread();
 }
 
-void CDROMAsyncReader::StartThread()
+void CDROMAsyncReader::StartThread(u32 readahead_sectors)
 {
   if (IsUsingThread())
-    return;
+  {
+    if (m_readahead_sectors == readahead_sectors)
+      return;
+
+    StopThread();
+  }
+
+  m_readahead_sectors = readahead_sectors;
+  ResizeBuffers(readahead_sectors + 1);
 
   m_shutdown_flag.store(false);
   m_read_thread = std::thread(&CDROMAsyncReader::WorkerThreadEntryPoint, this);
@@ -27,8 +39,7 @@ void CDROMAsyncReader::StopThread()
 
   {
     std::unique_lock<std::mutex> lock(m_mutex);
-    if (m_sector_read_pending.load())
-      m_notify_read_complete_cv.wait(lock, [this]() { return !m_sector_read_pending.load(); });
+    WaitForIdle(lock);
 
     m_shutdown_flag.store(true);
     m_do_read_cv.notify_one();
@@ -37,148 +48,228 @@ void CDROMAsyncReader::StopThread()
   m_read_thread.join();
 }
 
+void CDROMAsyncReader::ResizeBuffers(u32 count)
+{
+  // keep the current sector, and as much of the read-ahead as fits
+  std::vector<BufferSlot> new_buffers(count);
+  const u32 old_size = static_cast<u32>(m_buffers.size());
+  const u32 keep = std::min(std::max(m_buffer_count, 1u), count);
+  for (u32 i = 0; i < keep; i++)
+    new_buffers[i] = m_buffers[(m_buffer_front + i) % old_size];
+
+  m_buffers = std::move(new_buffers);
+  m_buffer_front = 0;
+  m_buffer_count = std::min(m_buffer_count, keep);
+}
+
+bool CDROMAsyncReader::WaitForIdle(std::unique_lock<std::mutex>& lock)
+{
+  // let the requested sector finish, but don't start any more read-ahead
+  m_notify_read_complete_cv.wait(lock, [this]() { return (m_buffer_count > 0 || !m_read_requested); });
+
+  const bool was_reading = m_read_requested;
+  m_read_requested = false;
+  m_notify_read_complete_cv.wait(lock, [this]() { return !m_read_in_flight; });
+  return was_reading;
+}
+
 void CDROMAsyncReader::SetMedia(std::unique_ptr<CDImage> media)
 {
-  WaitForReadToComplete();
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  if (IsUsingThread())
+  {
+    lock.lock();
+    WaitForIdle(lock);
+  }
+
   m_media = std::move(media);
+  m_buffer_count = 0;
 }
 
 std::unique_ptr<CDImage> CDROMAsyncReader::RemoveMedia()
 {
-  WaitForReadToComplete();
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  if (IsUsingThread())
+  {
+    lock.lock();
+    WaitForIdle(lock);
+  }
+
+  m_buffer_count = 0;
   return std::move(m_media);
 }
 
+bool CDROMAsyncReader::FindSectorInBuffers(CDImage::LBA lba)
+{
+  const u32 size = static_cast<u32>(m_buffers.size());
+  for (u32 i = 0; i < m_buffer_count; i++)
+  {
+    const u32 index = (m_buffer_front + i) % size;
+    const BufferSlot& slot = m_buffers[index];
+    if (slot.lba != lba || !slot.result)
+      continue;
+
+    // the CDC code re-reads the same sector when seeking->reading
+    if (i == 0)
+      Log_DebugPrintf("Skipping re-reading same sector %u", lba);
+
+    // drop everything before it, freeing up space for the worker to read further ahead
+    m_buffer_front = index;
+    m_buffer_count -= i;
+    return true;
+  }
+
+  return false;
+}
+
 void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
 {
   if (!IsUsingThread())
   {
-    m_sector_read_pending.store(true);
-    m_next_position_set.store(true);
-    m_next_position = lba;
-    DoSectorRead();
+    if (FindSectorInBuffers(lba))
+      return;
+
+    m_buffer_count = 1;
+    ReadSectorIntoSlot(&m_buffers[m_buffer_front], lba);
     return;
   }
 
   std::unique_lock<std::mutex> lock(m_mutex);
-  if (m_sector_read_pending.load())
-    m_notify_read_complete_cv.wait(lock, [this]() { return !m_sector_read_pending.load(); });
-
-  // don't re-read the same sector if it was the last one we read
-  // the CDC code does this when seeking->reading
-  if (m_last_read_sector == lba && m_sector_read_result.load())
+  if (!FindSectorInBuffers(lba))
   {
-    Log_DebugPrintf("Skipping re-reading same sector %u", lba);
-    return;
+    // not in the ring, so this is a seek. anything currently being read is stale.
+    m_buffer_count = 0;
+    m_next_position = lba;
+    m_read_generation++;
   }
 
-  m_sector_read_pending.store(true);
-  m_next_position_set.store(true);
-  m_next_position = lba;
+  m_read_requested = true;
   m_do_read_cv.notify_one();
 }
 
 bool CDROMAsyncReader::ReadSectorUncached(CDImage::LBA lba, CDImage::SubChannelQ* subq, SectorBuffer* data)
 {
-  WaitForReadToComplete();
+  // the lock is held for the whole read, so the worker can't touch the media
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  bool was_reading = false;
+  if (IsUsingThread())
+  {
+    lock.lock();
+    was_reading = WaitForIdle(lock);
+  }
 
+  bool result = true;
   if (m_media->GetPositionOnDisc() != lba && !m_media->Seek(lba))
   {
     Log_WarningPrintf("Seek to LBA %u failed", lba);
-    return false;
+    result = false;
   }
-
-  if ((subq && !m_media->ReadSubChannelQ(subq)) || (data && !m_media->ReadRawSector(data->data())))
+  else if ((subq && !m_media->ReadSubChannelQ(subq)) || (data && !m_media->ReadRawSector(data->data())))
   {
     Log_WarningPrintf("Read of LBA %u failed", lba);
-    return false;
+    result = false;
   }
 
-  return true;
-}
-
-void CDROMAsyncReader::QueueReadNextSector()
-{
-  if (!IsUsingThread())
+  if (was_reading)
   {
-    m_sector_read_pending.store(true);
-    DoSectorRead();
-    return;
+    m_read_requested = true;
+    m_do_read_cv.notify_one();
   }
 
-  std::unique_lock<std::mutex> lock(m_mutex);
-  if (m_sector_read_pending.load())
-    m_notify_read_complete_cv.wait(lock, [this]() { return !m_sector_read_pending.load(); });
+  return result;
+}
 
-  m_sector_read_pending.store(true);
-  m_do_read_cv.notify_one();
+void CDROMAsyncReader::QueueReadNextSector()
+{
+  QueueReadSector(GetLastReadSector() + 1);
 }
 
 bool CDROMAsyncReader::WaitForReadToComplete()
 {
   if (!IsUsingThread())
-    return m_sector_read_result.load();
+    return m_buffers[m_buffer_front].result;
 
   std::unique_lock<std::mutex> lock(m_mutex);
-  if (m_sector_read_pending.load())
+  if (m_buffer_count == 0 && m_read_requested)
   {
     Log_DebugPrintf("Sector read pending, waiting");
 
     Common::Timer wait_timer;
-    m_notify_read_complete_cv.wait(lock, [this]() { return !m_sector_read_pending.load(); });
+    m_notify_read_complete_cv.wait(lock, [this]() { return (m_buffer_count > 0 || !m_read_requested); });
 
     const double wait_time = wait_timer.GetTimeMilliseconds();
     if (wait_time > 1.0f)
-      Log_WarningPrintf("Had to wait %.2f msec for LBA %u", wait_time, m_last_read_sector);
+      Log_WarningPrintf("Had to wait %.2f msec for LBA %u", wait_time, m_next_position);
   }
 
-  return m_sector_read_result.load();
+  return m_buffers[m_buffer_front].result;
 }
 
-void CDROMAsyncReader::DoSectorRead()
+bool CDROMAsyncReader::ReadSectorIntoSlot(BufferSlot* slot, CDImage::LBA lba)
 {
   Common::Timer timer;
 
-  if (m_next_position_set.load())
+  slot->lba = lba;
+  slot->result = false;
+
+  if (m_media->GetPositionOnDisc() != lba && !m_media->Seek(lba))
   {
-    if (m_media->GetPositionOnDisc() != m_next_position && !m_media->Seek(m_next_position))
-    {
-      Log_WarningPrintf("Seek to LBA %u failed", m_next_position);
-      m_sector_read_result.store(false);
-      return;
-    }
+    Log_WarningPrintf("Seek to LBA %u failed", lba);
+    return false;
   }
 
-  CDImage::LBA pos = m_media->GetPositionOnDisc();
-  if (!m_media->ReadSubChannelQ(&m_subq) || !m_media->ReadRawSector(m_sector_buffer.data()))
+  if (!m_media->ReadSubChannelQ(&slot->subq) || !m_media->ReadRawSector(slot->data.data()))
   {
-    m_sector_read_result.store(false);
-    Log_WarningPrintf("Read of LBA %u failed", pos);
-    return;
+    Log_WarningPrintf("Read of LBA %u failed", lba);
+    return false;
   }
 
-  m_last_read_sector = pos;
-  m_sector_read_result.store(true);
+  slot->result = true;
 
   const double read_time = timer.GetTimeMilliseconds();
   if (read_time > 1.0f)
-    Log_DevPrintf("Read LBA %u took %.2f msec", pos, read_time);
+    Log_DevPrintf("Read LBA %u took %.2f msec", lba, read_time);
+
+  return true;
 }
 
 void CDROMAsyncReader::WorkerThreadEntryPoint()
 {
   std::unique_lock lock(m_mutex);
 
-  while (!m_shutdown_flag.load())
+  for (;;)
   {
-    m_do_read_cv.wait(lock, [this]() { return (m_shutdown_flag.load() || m_sector_read_pending.load()); });
-    if (m_sector_read_pending.load())
+    m_do_read_cv.wait(lock, [this]() {
+      return (m_shutdown_flag.load() || (m_read_requested && m_buffer_count < m_buffers.size()));
+    });
+    if (m_shutdown_flag.load())
+      break;
+
+    // the slot past the back of the ring isn't visible to the CPU thread, so we can fill it without the lock
+    const u32 size = static_cast<u32>(m_buffers.size());
+    const bool speculative = (m_buffer_count > 0);
+    const CDImage::LBA lba =
+      speculative ? (m_buffers[(m_buffer_front + m_buffer_count - 1) % size].lba + 1) : m_next_position;
+    BufferSlot* slot = &m_buffers[(m_buffer_front + m_buffer_count) % size];
+    const u32 generation = m_read_generation;
+    m_read_in_flight = true;
+
+    lock.unlock();
+    const bool result = ReadSectorIntoSlot(slot, lba);
+    lock.lock();
+
+    m_read_in_flight = false;
+    if (generation == m_read_generation)
     {
-      lock.unlock();
-      DoSectorRead();
-      lock.lock();
-      m_sector_read_pending.store(false);
-      m_notify_read_complete_cv.notify_one();
+      // failed read-ahead isn't an error until the sector is actually requested
+      if (result || !speculative)
+        m_buffer_count++;
+
+      // stop at errors, e.g. running off the end of the disc
+      if (!result)
+        m_read_requested = false;
     }
+
+    m_notify_read_complete_cv.notify_all();
   }
 }
@@ -4,7 +4,9 @@
 #include <array>
 #include <atomic>
 #include <condition_variable>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 class CDROMAsyncReader
 {
@@ -14,15 +16,18 @@ public:
   CDROMAsyncReader();
   ~CDROMAsyncReader();
 
-  const CDImage::LBA GetLastReadSector() const { return m_last_read_sector; }
-  const SectorBuffer& GetSectorBuffer() const { return m_sector_buffer; }
-  const CDImage::SubChannelQ& GetSectorSubQ() const { return m_subq; }
+  const CDImage::LBA GetLastReadSector() const { return m_buffers[m_buffer_front].lba; }
+  const SectorBuffer& GetSectorBuffer() const { return m_buffers[m_buffer_front].data; }
+  const CDImage::SubChannelQ& GetSectorSubQ() const { return m_buffers[m_buffer_front].subq; }
   const bool HasMedia() const { return static_cast<bool>(m_media); }
   const CDImage* GetMedia() const { return m_media.get(); }
   const std::string& GetMediaFileName() const { return m_media->GetFileName(); }
 
   bool IsUsingThread() const { return m_read_thread.joinable(); }
-  void StartThread();
+  u32 GetReadaheadSectors() const { return m_readahead_sectors; }
+
+  /// Starts the worker thread, which reads up to readahead_sectors past the last requested sector.
+  void StartThread(u32 readahead_sectors);
   void StopThread();
 
   void SetMedia(std::unique_ptr<CDImage> media);
@@ -37,7 +42,22 @@ public:
   bool ReadSectorUncached(CDImage::LBA lba, CDImage::SubChannelQ* subq, SectorBuffer* data);
 
 private:
-  void DoSectorRead();
+  struct BufferSlot
+  {
+    CDImage::LBA lba{};
+    CDImage::SubChannelQ subq{};
+    SectorBuffer data{};
+    bool result = false;
+  };
+
+  bool ReadSectorIntoSlot(BufferSlot* slot, CDImage::LBA lba);
+  bool FindSectorInBuffers(CDImage::LBA lba);
+  void ResizeBuffers(u32 count);
+
+  /// Waits for the requested sector and any in-flight read-ahead, then stops the worker from reading further.
+  /// Returns true if the worker was reading ahead.
+  bool WaitForIdle(std::unique_lock<std::mutex>& lock);
+
   void WorkerThreadEntryPoint();
 
   std::unique_ptr<CDImage> m_media;
@@ -47,13 +67,21 @@ private:
   std::condition_variable m_do_read_cv;
   std::condition_variable m_notify_read_complete_cv;
 
+  // Ring of consecutive sectors, starting with the most recently requested sector. The worker thread appends to the
+  // back while there is space, and the front is only moved by the CPU thread, so the front sector can be accessed
+  // without holding the lock.
+  std::vector<BufferSlot> m_buffers;
+  u32 m_buffer_front = 0;
+  u32 m_buffer_count = 0;
+  u32 m_readahead_sectors = 0;
+
+  // Set when the worker should be reading, either the requested sector (when the ring is empty) or read-ahead.
   CDImage::LBA m_next_position{};
-  std::atomic_bool m_next_position_set{false};
-  std::atomic_bool m_sector_read_pending{false};
-  std::atomic_bool m_shutdown_flag{true};
+  bool m_read_requested = false;
 
-  CDImage::LBA m_last_read_sector{};
-  CDImage::SubChannelQ m_subq{};
-  SectorBuffer m_sector_buffer{};
-  std::atomic_bool m_sector_read_result{false};
+  // Incremented on seeks, so that a read which was in flight at the time is thrown away.
+  u32 m_read_generation = 0;
+  bool m_read_in_flight = false;
+
+  std::atomic_bool m_shutdown_flag{true};
 };
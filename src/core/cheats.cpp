@@ -87,6 +87,7 @@ static void DoMemoryWrite(PhysicalMemoryAddress address, T value)
     if (old_value != value)
     {
       std::memcpy(&Bus::g_ram[address & Bus::RAM_MASK], &value, sizeof(value));
+      Bus::MarkRAMRangeDirty(address & Bus::RAM_MASK, sizeof(value));
 
       const u32 code_page_index = Bus::GetRAMCodePageIndex(address & Bus::RAM_MASK);
       if (Bus::IsRAMCodePage(code_page_index))
@@ -1,13 +1,19 @@
 #include "cpu_code_cache.h"
 #include "bus.h"
 #include "common/assert.h"
+#include "common/file_system.h"
 #include "common/log.h"
+#include "common/timer.h"
 #include "cpu_core.h"
 #include "cpu_core_private.h"
 #include "cpu_disasm.h"
 #include "settings.h"
 #include "system.h"
 #include "timing_event.h"
+#include "xxhash.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
 Log_SetChannel(CPU::CodeCache);
 
 #ifdef WITH_RECOMPILER
@@ -34,6 +40,7 @@ static constexpr u32 RECOMPILER_CODE_CACHE_SIZE = 32 * 1024 * 1024;
 static constexpr u32 RECOMPILER_FAR_CODE_CACHE_SIZE = 16 * 1024 * 1024;
 #endif
 static constexpr u32 CODE_WRITE_FAULT_THRESHOLD_FOR_SLOWMEM = 10;
+static constexpr u32 MAX_RETIRED_HOST_CODE_PER_BLOCK = 8;
 
 #ifdef USE_STATIC_CODE_BUFFER
 static constexpr u32 RECOMPILER_GUARD_SIZE = 4096;
@@ -85,6 +92,7 @@ static CodeBlock* LookupBlock(CodeBlockKey key);
 static bool RevalidateBlock(CodeBlock* block);
 
 static bool CompileBlock(CodeBlock* block);
+static bool DoCompileBlock(CodeBlock* block);
 static void RemoveReferencesToBlock(CodeBlock* block);
 static void AddBlockToPageMap(CodeBlock* block);
 static void RemoveBlockFromPageMap(CodeBlock* block);
@@ -96,16 +104,46 @@ static void LinkBlock(CodeBlock* from, CodeBlock* to);
 static void UnlinkBlock(CodeBlock* block);
 
 static void ClearState();
+static void ResetProfile();
 
 static BlockMap s_blocks;
 static std::array<std::vector<CodeBlock*>, Bus::RAM_CODE_PAGE_COUNT> m_ram_block_map;
 
+// Profiling totals are kept across flushes, so blocks which keep getting thrown away still show up.
+// Compile time bucket N counts compiles which took [2^N, 2^(N+1)) microseconds, the first and last are open-ended.
+static constexpr u32 COMPILE_TIME_HISTOGRAM_BUCKETS = 12;
+static std::array<u32, COMPILE_TIME_HISTOGRAM_BUCKETS> s_compile_time_histogram = {};
+static u64 s_total_compile_time = 0;
+static u32 s_total_compile_count = 0;
+static u32 s_total_invalidation_count = 0;
+static u32 s_flush_count = 0;
+
 #ifdef WITH_RECOMPILER
 static HostCodeMap s_host_code_map;
 
 static void AddBlockToHostCodeMap(CodeBlock* block);
 static void RemoveBlockFromHostCodeMap(CodeBlock* block);
 
+// Host code for blocks whose guest code was overwritten. It stays valid until the code buffer is reset, so if the
+// same instructions are written back to the same address (e.g. overlays being swapped in), the block can pick its
+// old code back up instead of being compiled again.
+struct RetiredHostCode
+{
+  u64 code_hash;
+  CodeBlock::HostCodePointer host_code;
+  u32 host_code_size;
+  TickCount estimated_ticks;
+  u32 fallback_instruction_count;
+  std::vector<CodeBlockInstruction> instructions;
+  std::vector<Recompiler::LoadStoreBackpatchInfo> loadstore_backpatch_info;
+};
+static std::unordered_map<u32, std::vector<RetiredHostCode>> s_retired_host_code;
+static u32 s_host_code_reuse_count = 0;
+
+static u64 GetBlockCodeHash(const CodeBlock* block);
+static void RetireHostCode(CodeBlock* block);
+static bool ReuseRetiredHostCode(CodeBlock* block);
+
 static bool InitializeFastmem();
 static void ShutdownFastmem();
 static Common::PageFaultHandler::HandlerResult LUTPageFaultHandler(void* exception_pc, void* fault_address,
@@ -119,6 +157,7 @@ static Common::PageFaultHandler::HandlerResult MMapPageFaultHandler(void* except
 void Initialize()
 {
   Assert(s_blocks.empty());
+  ResetProfile();
 
 #ifdef WITH_RECOMPILER
   if (g_settings.IsUsingRecompiler())
@@ -155,6 +194,7 @@ void ClearState()
   s_blocks.clear();
 #ifdef WITH_RECOMPILER
   s_host_code_map.clear();
+  s_retired_host_code.clear();
   s_code_buffer.Reset();
   ResetFastMap();
 #endif
@@ -163,6 +203,7 @@ void ClearState()
 void Shutdown()
 {
   ClearState();
+  ResetProfile();
 #ifdef WITH_RECOMPILER
   ShutdownFastmem();
   s_code_buffer.Destroy();
@@ -210,11 +251,19 @@ static void ExecuteImpl()
       LogCurrentState();
 #endif
 
+      const TickCount block_start_ticks = g_state.pending_ticks;
+
       if (g_settings.cpu_recompiler_icache)
         CheckAndUpdateICacheTags(block->icache_line_count, block->uncached_fetch_ticks);
 
       InterpretCachedBlock<pgxp_mode>(*block);
 
+      if (g_settings.cpu_recompiler_block_profiling)
+      {
+        block->execution_count++;
+        block->executed_ticks += static_cast<u32>(std::max(g_state.pending_ticks - block_start_ticks, 0));
+      }
+
       if (g_state.pending_ticks >= g_state.downcount)
         break;
       else if (!USE_BLOCK_LINKING)
@@ -370,6 +419,9 @@ void Reinitialize()
 
 void Flush()
 {
+  if (g_settings.cpu_recompiler_block_profiling)
+    s_flush_count++;
+
   ClearState();
 #ifdef WITH_RECOMPILER
   if (g_settings.IsUsingRecompiler())
@@ -463,12 +515,17 @@ recompile:
 
 #ifdef WITH_RECOMPILER
   RemoveBlockFromHostCodeMap(block);
+  RetireHostCode(block);
 #endif
 
   block->instructions.clear();
   if (!CompileBlock(block))
   {
     Log_WarningPrintf("Failed to recompile block 0x%08X - flushing.", block->GetPC());
+#ifdef WITH_RECOMPILER
+    // retired code can refer to the block when profiling
+    s_retired_host_code.erase(block->key.bits);
+#endif
     delete block;
     return false;
   }
@@ -487,6 +544,30 @@ recompile:
 }
 
 bool CompileBlock(CodeBlock* block)
+{
+  System::ScopedFrameTiming frame_timing(System::FrameTimingComponent::Recompiler);
+  if (!g_settings.cpu_recompiler_block_profiling)
+    return DoCompileBlock(block);
+
+  const Common::Timer::Value start_time = Common::Timer::GetValue();
+  if (!DoCompileBlock(block))
+    return false;
+
+  const Common::Timer::Value compile_time = Common::Timer::GetValue() - start_time;
+  block->compile_time += compile_time;
+  block->compile_count++;
+  s_total_compile_time += compile_time;
+  s_total_compile_count++;
+
+  const u64 compile_time_us = static_cast<u64>(Common::Timer::ConvertValueToNanoseconds(compile_time) / 1000.0);
+  u32 bucket = 0;
+  while (bucket < (COMPILE_TIME_HISTOGRAM_BUCKETS - 1) && (compile_time_us >> (bucket + 1)) != 0)
+    bucket++;
+  s_compile_time_histogram[bucket]++;
+  return true;
+}
+
+bool DoCompileBlock(CodeBlock* block)
 {
   u32 pc = block->GetPC();
   bool is_branch_delay_slot = false;
@@ -502,6 +583,8 @@ bool CompileBlock(CodeBlock* block)
   block->uncached_fetch_ticks = 0;
   block->contains_double_branches = false;
   block->contains_loadstore_instructions = false;
+  block->fallback_instruction_count = 0;
+  block->estimated_ticks = 0;
 
   u32 last_cache_line = ICACHE_LINES;
 
@@ -600,6 +683,10 @@ bool CompileBlock(CodeBlock* block)
 #ifdef WITH_RECOMPILER
   if (g_settings.IsUsingRecompiler())
   {
+    block->code_hash = GetBlockCodeHash(block);
+    if (ReuseRetiredHostCode(block))
+      return true;
+
     // Ensure we're not going to run out of space while compiling this block.
     if (s_code_buffer.GetFreeCodeSpace() <
           (block->instructions.size() * Recompiler::MAX_NEAR_HOST_BYTES_PER_INSTRUCTION) ||
@@ -624,6 +711,82 @@ bool CompileBlock(CodeBlock* block)
 
 #ifdef WITH_RECOMPILER
 
+u64 GetBlockCodeHash(const CodeBlock* block)
+{
+  // Changing any of these flushes the cache anyway, but don't rely on it.
+  const u64 settings_bits = static_cast<u64>(g_settings.cpu_fastmem_mode) |
+                            (static_cast<u64>(g_settings.cpu_recompiler_memory_exceptions) << 8) |
+                            (static_cast<u64>(g_settings.cpu_recompiler_icache) << 9) |
+                            (static_cast<u64>(g_settings.cpu_recompiler_block_profiling) << 10) |
+                            (static_cast<u64>(g_settings.gpu_pgxp_enable) << 11) |
+                            (static_cast<u64>(g_settings.gpu_pgxp_cpu) << 12) |
+                            (static_cast<u64>(g_settings.gpu_pgxp_culling) << 13);
+
+  XXH64_state_t state;
+  XXH64_reset(&state, settings_bits);
+  for (const CodeBlockInstruction& cbi : block->instructions)
+  {
+    const u32 words[2] = {cbi.pc, cbi.instruction.bits};
+    XXH64_update(&state, words, sizeof(words));
+  }
+
+  return XXH64_digest(&state);
+}
+
+void RetireHostCode(CodeBlock* block)
+{
+  if (!block->host_code)
+    return;
+
+  std::vector<RetiredHostCode>& retired = s_retired_host_code[block->key.bits];
+  if (retired.size() == MAX_RETIRED_HOST_CODE_PER_BLOCK)
+    retired.erase(retired.begin());
+
+  retired.push_back(RetiredHostCode{block->code_hash, block->host_code, block->host_code_size,
+                                    block->estimated_ticks, block->fallback_instruction_count,
+                                    std::move(block->instructions), std::move(block->loadstore_backpatch_info)});
+  block->host_code = nullptr;
+  block->host_code_size = 0;
+  block->instructions.clear();
+  block->loadstore_backpatch_info.clear();
+}
+
+bool ReuseRetiredHostCode(CodeBlock* block)
+{
+  auto iter = s_retired_host_code.find(block->key.bits);
+  if (iter == s_retired_host_code.end())
+    return false;
+
+  std::vector<RetiredHostCode>& retired = iter->second;
+  for (auto rhc = retired.begin(); rhc != retired.end(); ++rhc)
+  {
+    // compare the instructions as well, so a hash collision can't run the wrong code
+    if (rhc->code_hash != block->code_hash || rhc->instructions.size() != block->instructions.size() ||
+        !std::equal(rhc->instructions.begin(), rhc->instructions.end(), block->instructions.begin(),
+                    [](const CodeBlockInstruction& lhs, const CodeBlockInstruction& rhs) {
+                      return (lhs.pc == rhs.pc && lhs.instruction.bits == rhs.instruction.bits);
+                    }))
+    {
+      continue;
+    }
+
+    Log_DebugPrintf("Reusing host code %p for block 0x%08X", rhc->host_code, block->GetPC());
+    block->host_code = rhc->host_code;
+    block->host_code_size = rhc->host_code_size;
+    block->estimated_ticks = rhc->estimated_ticks;
+    block->fallback_instruction_count = rhc->fallback_instruction_count;
+    block->loadstore_backpatch_info = std::move(rhc->loadstore_backpatch_info);
+    retired.erase(rhc);
+    if (retired.empty())
+      s_retired_host_code.erase(iter);
+
+    s_host_code_reuse_count++;
+    return true;
+  }
+
+  return false;
+}
+
 void FastCompileBlockFunction()
 {
   CodeBlock* block = LookupBlock(GetNextBlockKey());
@@ -646,6 +809,11 @@ void InvalidateBlocksWithPageIndex(u32 page_index)
     // Invalidate forces the block to be checked again.
     Log_DebugPrintf("Invalidating block at 0x%08X", block->GetPC());
     block->invalidated = true;
+    if (g_settings.cpu_recompiler_block_profiling)
+    {
+      block->invalidation_count++;
+      s_total_invalidation_count++;
+    }
 #ifdef WITH_RECOMPILER
     SetFastMap(block->GetPC(), FastCompileBlockFunction);
 #endif
@@ -734,6 +902,113 @@ void UnlinkBlock(CodeBlock* block)
   block->link_successors.clear();
 }
 
+void RecordBlockExecution(CodeBlock* block)
+{
+  block->execution_count++;
+  block->executed_ticks += static_cast<u32>(block->estimated_ticks);
+}
+
+void ResetProfile()
+{
+  s_compile_time_histogram.fill(0);
+  s_total_compile_time = 0;
+  s_total_compile_count = 0;
+  s_total_invalidation_count = 0;
+  s_flush_count = 0;
+#ifdef WITH_RECOMPILER
+  s_host_code_reuse_count = 0;
+#endif
+}
+
+bool DumpProfile(const char* filename, u32 max_blocks)
+{
+  if (!g_settings.cpu_recompiler_block_profiling)
+  {
+    Log_ErrorPrintf("Block profiling is not enabled");
+    return false;
+  }
+
+  std::FILE* fp = FileSystem::OpenCFile(filename, "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open '%s' for writing", filename);
+    return false;
+  }
+
+  std::vector<const CodeBlock*> blocks;
+  blocks.reserve(s_blocks.size());
+  u64 total_ticks = 0;
+  for (const auto& it : s_blocks)
+  {
+    if (!it.second)
+      continue;
+
+    blocks.push_back(it.second);
+    total_ticks += it.second->executed_ticks;
+  }
+
+  std::sort(blocks.begin(), blocks.end(), [](const CodeBlock* lhs, const CodeBlock* rhs) {
+    return (lhs->executed_ticks != rhs->executed_ticks) ? (lhs->executed_ticks > rhs->executed_ticks) :
+                                                          (lhs->execution_count > rhs->execution_count);
+  });
+
+  const bool recompiler = g_settings.IsUsingRecompiler();
+  std::fprintf(fp, "Execution mode: %s\n", Settings::GetCPUExecutionModeName(g_settings.cpu_execution_mode));
+  std::fprintf(fp, "Blocks: %zu\n", blocks.size());
+  std::fprintf(fp, "Compiles: %u (%.3f ms)\n", s_total_compile_count,
+               Common::Timer::ConvertValueToMilliseconds(s_total_compile_time));
+  std::fprintf(fp, "Invalidations: %u\n", s_total_invalidation_count);
+  std::fprintf(fp, "Flushes: %u\n", s_flush_count);
+#ifdef WITH_RECOMPILER
+  if (recompiler)
+    std::fprintf(fp, "Reused host code: %u\n", s_host_code_reuse_count);
+#endif
+  if (recompiler)
+    std::fprintf(fp, "Ticks are estimated from the instructions in each block, excluding memory access time.\n");
+
+  std::fprintf(fp, "\nCompile time histogram:\n");
+  for (u32 i = 0; i < COMPILE_TIME_HISTOGRAM_BUCKETS; i++)
+  {
+    if (i == 0)
+      std::fprintf(fp, "  %13s: %u\n", "< 2us", s_compile_time_histogram[i]);
+    else if (i == (COMPILE_TIME_HISTOGRAM_BUCKETS - 1))
+      std::fprintf(fp, "  >= %8uus: %u\n", 1u << i, s_compile_time_histogram[i]);
+    else
+      std::fprintf(fp, "  %5u-%5uus: %u\n", 1u << i, 1u << (i + 1), s_compile_time_histogram[i]);
+  }
+
+  const u32 count = std::min(static_cast<u32>(blocks.size()), max_blocks);
+  std::fprintf(fp, "\nTop %u blocks by executed ticks:\n", count);
+
+  SmallString disasm;
+  for (u32 i = 0; i < count; i++)
+  {
+    const CodeBlock* block = blocks[i];
+    const double percent =
+      (total_ticks > 0) ? (static_cast<double>(block->executed_ticks) * 100.0 / static_cast<double>(total_ticks)) : 0.0;
+
+    std::fprintf(fp, "\n#%u: PC 0x%08X%s, %zu instructions (%u bytes), %u host bytes\n", i + 1, block->GetPC(),
+                 block->key.user_mode ? " (user)" : "", block->instructions.size(), block->GetSizeInBytes(),
+                 block->host_code_size);
+    std::fprintf(fp,
+                 "  executions: %" PRIu64 ", ticks: %" PRIu64 " (%.2f%%), compiles: %u (%.3f ms), invalidations: %u, "
+                 "fallbacks: %u\n",
+                 block->execution_count, block->executed_ticks, percent, block->compile_count,
+                 Common::Timer::ConvertValueToMilliseconds(block->compile_time), block->invalidation_count,
+                 block->fallback_instruction_count);
+
+    for (const CodeBlockInstruction& cbi : block->instructions)
+    {
+      DisassembleInstruction(&disasm, cbi.pc, cbi.instruction.bits);
+      std::fprintf(fp, "  0x%08X  %08X  %s\n", cbi.pc, cbi.instruction.bits, disasm.GetCharArray());
+    }
+  }
+
+  std::fclose(fp);
+  Log_InfoPrintf("Wrote profile of %u blocks to '%s'", count, filename);
+  return true;
+}
+
 #ifdef WITH_RECOMPILER
 
 void AddBlockToHostCodeMap(CodeBlock* block)
@@ -79,6 +79,9 @@ struct CodeBlock
   TickCount uncached_fetch_ticks = 0;
   u32 icache_line_count = 0;
 
+  // Hash of the instructions and the settings which affect code generation.
+  u64 code_hash = 0;
+
 #ifdef WITH_RECOMPILER
   std::vector<Recompiler::LoadStoreBackpatchInfo> loadstore_backpatch_info;
 #endif
@@ -87,6 +90,15 @@ struct CodeBlock
   bool contains_double_branches = false;
   bool invalidated = false;
 
+  // Only updated when block profiling is enabled.
+  u64 execution_count = 0;
+  u64 executed_ticks = 0;
+  u64 compile_time = 0;
+  u32 compile_count = 0;
+  u32 invalidation_count = 0;
+  u32 fallback_instruction_count = 0;
+  TickCount estimated_ticks = 0;
+
   const u32 GetPC() const { return key.GetPC(); }
   const u32 GetSizeInBytes() const { return static_cast<u32>(instructions.size()) * sizeof(Instruction); }
   const u32 GetStartPageIndex() const { return (key.GetPCPhysicalAddress() / HOST_PAGE_SIZE); }
@@ -103,6 +115,11 @@ struct CodeBlock
 
 namespace CodeCache {
 
+enum : u32
+{
+  DEFAULT_PROFILE_DUMP_BLOCKS = 100
+};
+
 void Initialize();
 void Shutdown();
 void Execute();
@@ -124,6 +141,13 @@ void Reinitialize();
 /// Invalidates all blocks which are in the range of the specified code page.
 void InvalidateBlocksWithPageIndex(u32 page_index);
 
+/// Counts an execution of a block when profiling. Recompiled blocks call this from their prologue, and add their
+/// estimated tick count since the exact number of ticks is not known until the block exits.
+void RecordBlockExecution(CodeBlock* block);
+
+/// Writes the most expensive blocks and a histogram of compile times to a text file. Requires block profiling.
+bool DumpProfile(const char* filename, u32 max_blocks = DEFAULT_PROFILE_DUMP_BLOCKS);
+
 template<PGXPMode pgxp_mode>
 void InterpretCachedBlock(const CodeBlock& block);
 
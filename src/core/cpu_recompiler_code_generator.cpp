@@ -899,12 +899,51 @@ void CodeGenerator::GenerateExceptionExit(const CodeBlockInstruction& cbi, Excep
   EmitBindLabel(&skip_exception);
 }
 
+u32 CodeGenerator::GetGuestRegisterNextUse(Reg reg) const
+{
+  if (!m_current_instruction)
+    return 0;
+
+  u32 distance = 0;
+  for (const CodeBlockInstruction* cbi = m_current_instruction; cbi != m_block_end; cbi++, distance++)
+  {
+    if (InstructionReferencesRegister(cbi->instruction, reg))
+      return distance;
+  }
+
+  return UINT32_MAX;
+}
+
+void CodeGenerator::WriteLoadedGuestRegister(const CodeBlockInstruction& cbi, Reg reg, Value&& value)
+{
+  // If the instruction in the load delay slot doesn't touch the register, nothing can observe the old value, so we
+  // can skip the delay and write it now. Exceptions in the delay slot commit the load anyway.
+  const CodeBlockInstruction* next_cbi = &cbi + 1;
+  if (cbi.is_last_instruction || next_cbi == m_block_end || InstructionReferencesRegister(next_cbi->instruction, reg))
+  {
+    m_register_cache.WriteGuestRegisterDelayed(reg, std::move(value));
+    return;
+  }
+
+  if (reg == Reg::zero)
+    return;
+
+  EmitCancelInterpreterLoadDelayForReg(reg);
+  m_register_cache.WriteGuestRegister(reg, std::move(value));
+}
+
 void CodeGenerator::BlockPrologue()
 {
   InitSpeculativeRegs();
 
   EmitStoreCPUStructField(offsetof(State, exception_raised), Value::FromConstantU8(0));
 
+  if (g_settings.cpu_recompiler_block_profiling)
+  {
+    EmitFunctionCall(nullptr, &CodeCache::RecordBlockExecution,
+                     Value::FromConstant(static_cast<u64>(reinterpret_cast<uintptr_t>(m_block)), HostPointerSize));
+  }
+
   if (m_block->uncached_fetch_ticks > 0)
     EmitICacheCheckAndUpdate();
 
@@ -940,6 +979,8 @@ void CodeGenerator::InstructionPrologue(const CodeBlockInstruction& cbi, TickCou
   m_emit->nop();
 #endif
 
+  m_block->estimated_ticks += cycles;
+
   // move instruction offsets forward
   m_current_instruction_pc_offset = m_pc_offset;
   m_pc_offset = m_next_pc_offset;
@@ -1066,6 +1107,7 @@ void CodeGenerator::WriteNewPC(const Value& value, bool commit)
 bool CodeGenerator::Compile_Fallback(const CodeBlockInstruction& cbi)
 {
   InstructionPrologue(cbi, 1, true);
+  m_block->fallback_instruction_count++;
 
   // flush and invalidate all guest registers, since the fallback could change any of them
   m_register_cache.FlushAllGuestRegisters(true, true);
@@ -1347,7 +1389,7 @@ bool CodeGenerator::Compile_Load(const CodeBlockInstruction& cbi)
       break;
   }
 
-  m_register_cache.WriteGuestRegisterDelayed(cbi.instruction.i.rt, std::move(result));
+  WriteLoadedGuestRegister(cbi, cbi.instruction.i.rt, std::move(result));
   SpeculativeWriteReg(cbi.instruction.i.rt, value_spec);
 
   InstructionEpilogue(cbi);
@@ -1511,7 +1553,7 @@ bool CodeGenerator::Compile_LoadLeftRight(const CodeBlockInstruction& cbi)
   if (g_settings.gpu_pgxp_enable)
     EmitFunctionCall(nullptr, PGXP::CPU_LW, Value::FromConstantU32(cbi.instruction.bits), mem, address);
 
-  m_register_cache.WriteGuestRegisterDelayed(cbi.instruction.i.rt, std::move(mem));
+  WriteLoadedGuestRegister(cbi, cbi.instruction.i.rt, std::move(mem));
 
   // TODO: Speculative values
   SpeculativeWriteReg(cbi.instruction.r.rt, std::nullopt);
@@ -2245,7 +2287,7 @@ bool CodeGenerator::Compile_cop0(const CodeBlockInstruction& cbi)
           // coprocessor loads are load-delayed
           Value value = m_register_cache.AllocateScratch(RegSize_32);
           EmitLoadCPUStructField(value.host_reg, value.size, offset);
-          m_register_cache.WriteGuestRegisterDelayed(cbi.instruction.r.rt, std::move(value));
+          WriteLoadedGuestRegister(cbi, cbi.instruction.r.rt, std::move(value));
           SpeculativeWriteReg(cbi.instruction.r.rt, std::nullopt);
         }
         else
@@ -2377,7 +2419,7 @@ Value CodeGenerator::DoGTERegisterRead(u32 index)
 
     default:
     {
-      EmitLoadCPUStructField(value.host_reg, RegSize_32, offsetof(State, gte_regs.r32[index]));
+      EmitLoadCPUStructField(value.host_reg, RegSize_32, offsetof(State, gte_regs.r32[0]) + index * sizeof(u32));
     }
     break;
   }
@@ -2406,7 +2448,7 @@ void CodeGenerator::DoGTERegisterWrite(u32 index, const Value& value)
     {
       // sign-extend z component of vector registers
       Value temp = ConvertValueSize(value.ViewAsSize(RegSize_16), RegSize_32, true);
-      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[index]), temp);
+      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[0]) + index * sizeof(u32), temp);
       return;
     }
     break;
@@ -2419,7 +2461,7 @@ void CodeGenerator::DoGTERegisterWrite(u32 index, const Value& value)
     {
       // zero-extend unsigned values
       Value temp = ConvertValueSize(value.ViewAsSize(RegSize_16), RegSize_32, false);
-      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[index]), temp);
+      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[0]) + index * sizeof(u32), temp);
       return;
     }
     break;
@@ -2461,7 +2503,7 @@ void CodeGenerator::DoGTERegisterWrite(u32 index, const Value& value)
     default:
     {
       // written as-is, 2x16 or 1x32 bits
-      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[index]), value);
+      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[0]) + index * sizeof(u32), value);
       return;
     }
   }
@@ -2529,7 +2571,7 @@ bool CodeGenerator::Compile_cop2(const CodeBlockInstruction& cbi)
             Value::FromConstantU32(cbi.instruction.bits), value, value);
         }
 
-        m_register_cache.WriteGuestRegisterDelayed(cbi.instruction.r.rt, std::move(value));
+        WriteLoadedGuestRegister(cbi, cbi.instruction.r.rt, std::move(value));
         SpeculativeWriteReg(cbi.instruction.r.rt, std::nullopt);
 
         InstructionEpilogue(cbi);
@@ -2564,11 +2606,32 @@ bool CodeGenerator::Compile_cop2(const CodeBlockInstruction& cbi)
   }
   else
   {
-    // forward everything to the GTE.
     InstructionPrologue(cbi, 1);
 
-    Value instruction_bits = Value::FromConstantU32(cbi.instruction.bits & GTE::Instruction::REQUIRED_BITS_MASK);
-    EmitFunctionCall(nullptr, GTE::GetInstructionImpl(cbi.instruction.bits), instruction_bits);
+    // The common geometry commands are generated inline, forward everything else to the GTE. MVMVA with the far colour
+    // translation vector loses the first product, and PGXP needs the full precision transform, so they aren't.
+    const GTE::Instruction gte_instruction{cbi.instruction.bits};
+    if (gte_instruction.command == 0x06 && !(g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling))
+    {
+      EmitGTE_NCLIP();
+    }
+    else if (gte_instruction.command == 0x2D || gte_instruction.command == 0x2E)
+    {
+      EmitGTE_AVSZ(gte_instruction.command == 0x2E);
+    }
+    else if (gte_instruction.command == 0x12 && gte_instruction.mvmva_translation_vector != 2)
+    {
+      EmitGTE_MVMVA(gte_instruction);
+    }
+    else if ((gte_instruction.command == 0x01 || gte_instruction.command == 0x30) && !g_settings.gpu_pgxp_enable)
+    {
+      EmitGTE_RTPS(gte_instruction);
+    }
+    else
+    {
+      Value instruction_bits = Value::FromConstantU32(cbi.instruction.bits & GTE::Instruction::REQUIRED_BITS_MASK);
+      EmitFunctionCall(nullptr, GTE::GetInstructionImpl(cbi.instruction.bits), instruction_bits);
+    }
 
     InstructionEpilogue(cbi);
     return true;
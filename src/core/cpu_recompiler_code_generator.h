@@ -10,6 +10,7 @@
 #include "cpu_recompiler_thunks.h"
 #include "cpu_recompiler_types.h"
 #include "cpu_types.h"
+#include "gte_types.h"
 
 namespace CPU::Recompiler {
 
@@ -72,6 +73,10 @@ public:
   void EmitMoveNextInterpreterLoadDelay();
   void EmitCancelInterpreterLoadDelayForReg(Reg reg);
   void EmitICacheCheckAndUpdate();
+  void EmitGTE_NCLIP();
+  void EmitGTE_AVSZ(bool avsz4);
+  void EmitGTE_MVMVA(GTE::Instruction inst);
+  void EmitGTE_RTPS(GTE::Instruction inst);
   void EmitLoadCPUStructField(HostReg host_reg, RegSize size, u32 offset);
   void EmitStoreCPUStructField(u32 offset, const Value& value);
   void EmitAddCPUStructField(u32 offset, const Value& value);
@@ -172,6 +177,9 @@ public:
   void GenerateExceptionExit(const CodeBlockInstruction& cbi, Exception excode,
                              Condition condition = Condition::Always);
 
+  /// Returns the number of instructions until the guest register is next referenced in the block, or UINT32_MAX.
+  u32 GetGuestRegisterNextUse(Reg reg) const;
+
 private:
   // Host register setup
   void InitHostRegs();
@@ -206,6 +214,9 @@ private:
   Value DoGTERegisterRead(u32 index);
   void DoGTERegisterWrite(u32 index, const Value& value);
 
+  /// Writes the result of a load, skipping the load delay when the next instruction can't observe it.
+  void WriteLoadedGuestRegister(const CodeBlockInstruction& cbi, Reg reg, Value&& value);
+
   //////////////////////////////////////////////////////////////////////////
   // Instruction Code Generators
   //////////////////////////////////////////////////////////////////////////
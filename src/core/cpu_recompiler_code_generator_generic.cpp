@@ -2,6 +2,7 @@
 #include "cpu_core.h"
 #include "cpu_core_private.h"
 #include "cpu_recompiler_code_generator.h"
+#include "gte.h"
 #include "settings.h"
 Log_SetChannel(Recompiler::CodeGenerator);
 
@@ -199,4 +200,32 @@ void CodeGenerator::EmitICacheCheckAndUpdate()
 
 #endif
 
+#if !defined(CPU_X64)
+
+void CodeGenerator::EmitGTE_NCLIP()
+{
+  constexpr u32 inst_bits = 0x06;
+  EmitFunctionCall(nullptr, GTE::GetInstructionImpl(inst_bits), Value::FromConstantU32(inst_bits));
+}
+
+void CodeGenerator::EmitGTE_AVSZ(bool avsz4)
+{
+  const u32 inst_bits = avsz4 ? 0x2E : 0x2D;
+  EmitFunctionCall(nullptr, GTE::GetInstructionImpl(inst_bits), Value::FromConstantU32(inst_bits));
+}
+
+void CodeGenerator::EmitGTE_MVMVA(GTE::Instruction inst)
+{
+  const u32 inst_bits = inst.bits & GTE::Instruction::REQUIRED_BITS_MASK;
+  EmitFunctionCall(nullptr, GTE::GetInstructionImpl(inst_bits), Value::FromConstantU32(inst_bits));
+}
+
+void CodeGenerator::EmitGTE_RTPS(GTE::Instruction inst)
+{
+  const u32 inst_bits = inst.bits & GTE::Instruction::REQUIRED_BITS_MASK;
+  EmitFunctionCall(nullptr, GTE::GetInstructionImpl(inst_bits), Value::FromConstantU32(inst_bits));
+}
+
+#endif
+
 } // namespace CPU::Recompiler
@@ -5,6 +5,7 @@
 #include "cpu_core_private.h"
 #include "cpu_recompiler_code_generator.h"
 #include "cpu_recompiler_thunks.h"
+#include "gte.h"
 #include "settings.h"
 #include "timing_event.h"
 Log_SetChannel(Recompiler::CodeGenerator);
@@ -2626,6 +2627,333 @@ void CodeGenerator::EmitICacheCheckAndUpdate()
   m_register_cache.UninhibitAllocation();
 }
 
+void CodeGenerator::EmitGTE_NCLIP()
+{
+  Value result = m_register_cache.AllocateScratch(RegSize_64);
+  Value temp = m_register_cache.AllocateScratch(RegSize_64);
+  Value temp2 = m_register_cache.AllocateScratch(RegSize_64);
+
+  // MAC0 = SX0*(SY1-SY2) + SX1*(SY2-SY0) + SX2*(SY0-SY1), which is the same sum of six products the GTE uses
+  for (u32 i = 0; i < 3; i++)
+  {
+    const u32 sx_offset = offsetof(State, gte_regs.SXY0[0]) + (i * sizeof(u32));
+    const u32 sy_lhs_offset = offsetof(State, gte_regs.SXY0[1]) + (((i + 1) % 3) * sizeof(u32));
+    const u32 sy_rhs_offset = offsetof(State, gte_regs.SXY0[1]) + (((i + 2) % 3) * sizeof(u32));
+    const Xbyak::Reg64 term = (i == 0) ? GetHostReg64(result) : GetHostReg64(temp);
+
+    m_emit->movsx(term, m_emit->word[GetCPUPtrReg() + sy_lhs_offset]);
+    m_emit->movsx(GetHostReg64(temp2), m_emit->word[GetCPUPtrReg() + sy_rhs_offset]);
+    m_emit->sub(term, GetHostReg64(temp2));
+    m_emit->movsx(GetHostReg64(temp2), m_emit->word[GetCPUPtrReg() + sx_offset]);
+    m_emit->imul(term, GetHostReg64(temp2));
+    if (i != 0)
+      m_emit->add(GetHostReg64(result), term);
+  }
+
+  m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.MAC0)], GetHostReg32(result.host_reg));
+
+  // FLAG = overflow/underflow if the result doesn't fit in 32 bits, otherwise zero
+  m_emit->mov(GetHostReg32(temp.host_reg), GTE::FLAGS::MAC0_OVERFLOW_BITS);
+  m_emit->mov(GetHostReg32(temp2.host_reg), GTE::FLAGS::MAC0_UNDERFLOW_BITS);
+  m_emit->test(GetHostReg64(result), GetHostReg64(result));
+  m_emit->cmovs(GetHostReg32(temp.host_reg), GetHostReg32(temp2.host_reg));
+  m_emit->movsxd(GetHostReg64(temp2), GetHostReg32(result.host_reg));
+  m_emit->cmp(GetHostReg64(temp2), GetHostReg64(result));
+  m_emit->mov(GetHostReg32(temp2.host_reg), 0);
+  m_emit->cmove(GetHostReg32(temp.host_reg), GetHostReg32(temp2.host_reg));
+  m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], GetHostReg32(temp.host_reg));
+}
+
+void CodeGenerator::EmitGTE_AVSZ(bool avsz4)
+{
+  Value result = m_register_cache.AllocateScratch(RegSize_64);
+  Value temp = m_register_cache.AllocateScratch(RegSize_64);
+  Value temp2 = m_register_cache.AllocateScratch(RegSize_64);
+
+  // MAC0 = ZSF3*(SZ1+SZ2+SZ3) or ZSF4*(SZ0+SZ1+SZ2+SZ3)
+  const u32 first_sz = avsz4 ? 0 : 1;
+  m_emit->movzx(GetHostReg32(temp.host_reg),
+                m_emit->word[GetCPUPtrReg() + offsetof(State, gte_regs.SZ0) + (first_sz * sizeof(u32))]);
+  for (u32 i = first_sz + 1; i < 4; i++)
+  {
+    m_emit->movzx(GetHostReg32(temp2.host_reg),
+                  m_emit->word[GetCPUPtrReg() + offsetof(State, gte_regs.SZ0) + (i * sizeof(u32))]);
+    m_emit->add(GetHostReg32(temp.host_reg), GetHostReg32(temp2.host_reg));
+  }
+
+  const u32 zsf_offset = avsz4 ? offsetof(State, gte_regs.ZSF4) : offsetof(State, gte_regs.ZSF3);
+  m_emit->movsx(GetHostReg64(result), m_emit->word[GetCPUPtrReg() + zsf_offset]);
+  m_emit->imul(GetHostReg64(result), GetHostReg64(temp));
+  m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.MAC0)], GetHostReg32(result.host_reg));
+
+  // FLAG = overflow/underflow if the result doesn't fit in 32 bits, otherwise zero
+  m_emit->mov(GetHostReg32(temp.host_reg), GTE::FLAGS::MAC0_OVERFLOW_BITS);
+  m_emit->mov(GetHostReg32(temp2.host_reg), GTE::FLAGS::MAC0_UNDERFLOW_BITS);
+  m_emit->test(GetHostReg64(result), GetHostReg64(result));
+  m_emit->cmovs(GetHostReg32(temp.host_reg), GetHostReg32(temp2.host_reg));
+  m_emit->movsxd(GetHostReg64(temp2), GetHostReg32(result.host_reg));
+  m_emit->cmp(GetHostReg64(temp2), GetHostReg64(result));
+  m_emit->mov(GetHostReg32(temp2.host_reg), 0);
+  m_emit->cmove(GetHostReg32(temp.host_reg), GetHostReg32(temp2.host_reg));
+
+  // OTZ = clamp(MAC0 >> 12, 0, 0xFFFF), the shifted value always fits in 32 bits
+  m_emit->sar(GetHostReg64(result), 12);
+  m_emit->mov(GetHostReg32(temp2.host_reg), GTE::FLAGS::SZ1_OTZ_SATURATED_BITS);
+  m_emit->or_(GetHostReg32(temp2.host_reg), GetHostReg32(temp.host_reg));
+  m_emit->cmp(GetHostReg32(result.host_reg), 0xFFFF);
+  m_emit->cmova(GetHostReg32(temp.host_reg), GetHostReg32(temp2.host_reg));
+  m_emit->mov(GetHostReg32(temp2.host_reg), 0);
+  m_emit->test(GetHostReg32(result.host_reg), GetHostReg32(result.host_reg));
+  m_emit->cmovs(GetHostReg32(result.host_reg), GetHostReg32(temp2.host_reg));
+  m_emit->mov(GetHostReg32(temp2.host_reg), 0xFFFF);
+  m_emit->cmp(GetHostReg32(result.host_reg), GetHostReg32(temp2.host_reg));
+  m_emit->cmovg(GetHostReg32(result.host_reg), GetHostReg32(temp2.host_reg));
+  m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.dr32[7])], GetHostReg32(result.host_reg));
+  m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], GetHostReg32(temp.host_reg));
+}
+
+// Adds the GTE's MAC1-3 overflow flags for a 64-bit sum, the hardware checks against 44 bits. Leaves the sum sign
+// extended from 44 bits in temp.
+static void EmitGTE_CheckMACOverflow(CodeEmitter* emit, const Xbyak::Reg64& value, const Xbyak::Reg64& temp, u32 index)
+{
+  Xbyak::Label underflow, done;
+  emit->mov(temp, value);
+  emit->shl(temp, 20);
+  emit->sar(temp, 20);
+  emit->cmp(temp, value);
+  emit->je(done);
+  emit->test(value, value);
+  emit->js(underflow);
+  emit->or_(emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], GTE::FLAGS::GetMACOverflowBit(index));
+  emit->jmp(done);
+  emit->L(underflow);
+  emit->or_(emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], GTE::FLAGS::GetMACUnderflowBit(index));
+  emit->L(done);
+}
+
+// Clamps value to min_value..7FFFh in place, adding flag_bits to FLAG if it was out of range.
+static void EmitGTE_SaturateIR(CodeEmitter* emit, const Xbyak::Reg32& value, s32 min_value, u32 flag_bits)
+{
+  Xbyak::Label saturate_min, done;
+  emit->cmp(value, min_value);
+  emit->jl(saturate_min);
+  emit->cmp(value, 0x7FFF);
+  emit->jle(done);
+  emit->mov(value, 0x7FFF);
+  if (flag_bits != 0)
+    emit->or_(emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], flag_bits);
+  emit->jmp(done);
+  emit->L(saturate_min);
+  emit->mov(value, static_cast<u32>(min_value));
+  if (flag_bits != 0)
+    emit->or_(emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], flag_bits);
+  emit->L(done);
+}
+
+static void EmitGTE_UpdateError(CodeEmitter* emit, const Xbyak::Reg32& temp)
+{
+  Xbyak::Label no_error;
+  emit->mov(temp, emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)]);
+  emit->test(temp, GTE::FLAGS::ERROR_MASK);
+  emit->jz(no_error);
+  emit->or_(temp, GTE::FLAGS::ERROR_BIT);
+  emit->mov(emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], temp);
+  emit->L(no_error);
+}
+
+// Computes (T[row] << 12) + M[row][0]*V[0] + M[row][1]*V[1] + M[row][2]*V[2] into acc, with the overflow checks after
+// each addition, in the same order as GTE::MulMatVec(). load_matrix_element loads M[row][column] sign-extended.
+template<typename LoadMatrixElement>
+static void EmitGTE_MulMatVecRow(CodeEmitter* emit, const Xbyak::Reg64& acc, const Xbyak::Reg64& temp,
+                                 const Xbyak::Reg64 V[3], std::optional<u32> T_offset, u32 row,
+                                 const LoadMatrixElement& load_matrix_element)
+{
+  if (T_offset.has_value())
+  {
+    emit->movsxd(acc, emit->dword[GetCPUPtrReg() + T_offset.value() + (row * sizeof(u32))]);
+    emit->shl(acc, 12);
+  }
+  else
+  {
+    emit->xor_(acc.cvt32(), acc.cvt32());
+  }
+
+  for (u32 column = 0; column < 3; column++)
+  {
+    load_matrix_element(temp, row, column);
+    emit->imul(temp, V[column]);
+    emit->add(acc, temp);
+    EmitGTE_CheckMACOverflow(emit, acc, temp, row + 1);
+
+    // the intermediate sums wrap around at 44 bits, the last one is only truncated when storing MAC
+    if (column != 2)
+      emit->mov(acc, temp);
+  }
+}
+
+void CodeGenerator::EmitGTE_MVMVA(GTE::Instruction inst)
+{
+  DebugAssert(inst.mvmva_translation_vector != 2);
+
+  Value acc = m_register_cache.AllocateScratch(RegSize_64);
+  Value temp = m_register_cache.AllocateScratch(RegSize_64);
+  Value vector[3] = {m_register_cache.AllocateScratch(RegSize_64), m_register_cache.AllocateScratch(RegSize_64),
+                     m_register_cache.AllocateScratch(RegSize_64)};
+  const Xbyak::Reg64 V[3] = {GetHostReg64(vector[0]), GetHostReg64(vector[1]), GetHostReg64(vector[2])};
+
+  m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], 0);
+
+  // The vector has to be read up front, IR1-3 can be both the vector and the result.
+  for (u32 i = 0; i < 3; i++)
+  {
+    const u32 mv = inst.mvmva_multiply_vector;
+    const u32 offset = (mv == 3) ? (offsetof(State, gte_regs.IR1) + (i * sizeof(u32))) :
+                                   (offsetof(State, gte_regs.V0) + (mv * sizeof(u32) * 2) + (i * sizeof(s16)));
+    m_emit->movsx(V[i], m_emit->word[GetCPUPtrReg() + offset]);
+  }
+
+  std::optional<u32> T_offset;
+  if (inst.mvmva_translation_vector == 0)
+    T_offset = offsetof(State, gte_regs.TR);
+  else if (inst.mvmva_translation_vector == 1)
+    T_offset = offsetof(State, gte_regs.BK);
+
+  const u32 mx = inst.mvmva_multiply_matrix;
+  const auto load_matrix_element = [this, mx](const Xbyak::Reg64& dst, u32 row, u32 column) {
+    if (mx != 3)
+    {
+      const u32 offset = ((mx == 0) ? offsetof(State, gte_regs.RT) :
+                                      ((mx == 1) ? offsetof(State, gte_regs.LLM) : offsetof(State, gte_regs.LCM))) +
+                         (((row * 3) + column) * sizeof(s16));
+      m_emit->movsx(dst, m_emit->word[GetCPUPtrReg() + offset]);
+      return;
+    }
+
+    // the garbage matrix, see Execute_MVMVA()
+    if (row == 0 && column < 2)
+    {
+      m_emit->movzx(dst.cvt32(), m_emit->byte[GetCPUPtrReg() + offsetof(State, gte_regs.RGBC[0])]);
+      m_emit->shl(dst.cvt32(), 4);
+      if (column == 0)
+        m_emit->neg(dst);
+    }
+    else
+    {
+      const u32 offset = (row == 0) ? offsetof(State, gte_regs.IR0) :
+                                      ((row == 1) ? offsetof(State, gte_regs.RT[0][2]) :
+                                                    offsetof(State, gte_regs.RT[1][1]));
+      m_emit->movsx(dst, m_emit->word[GetCPUPtrReg() + offset]);
+    }
+  };
+
+  const u8 shift = inst.GetShift();
+  const s32 ir_min_value = inst.lm ? 0 : -0x8000;
+  for (u32 i = 0; i < 3; i++)
+  {
+    EmitGTE_MulMatVecRow(m_emit, GetHostReg64(acc), GetHostReg64(temp), V, T_offset, i, load_matrix_element);
+    if (shift != 0)
+      m_emit->sar(GetHostReg64(acc), shift);
+
+    m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.MAC1) + (i * sizeof(u32))],
+                GetHostReg32(acc));
+    EmitGTE_SaturateIR(m_emit, GetHostReg32(acc), ir_min_value, GTE::FLAGS::GetIRSaturatedBit(i + 1));
+    m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.IR1) + (i * sizeof(u32))],
+                GetHostReg32(acc));
+  }
+
+  EmitGTE_UpdateError(m_emit, GetHostReg32(temp));
+}
+
+void CodeGenerator::EmitGTE_RTPS(GTE::Instruction inst)
+{
+  const bool rtpt = (inst.command == 0x30);
+  const u8 shift = inst.GetShift();
+  const s32 ir_min_value = inst.lm ? 0 : -0x8000;
+
+  m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)], 0);
+
+  const u32 num_vertices = rtpt ? 3 : 1;
+  for (u32 vertex = 0; vertex < num_vertices; vertex++)
+  {
+    {
+      Value acc = m_register_cache.AllocateScratch(RegSize_64);
+      Value temp = m_register_cache.AllocateScratch(RegSize_64);
+      Value vector[3] = {m_register_cache.AllocateScratch(RegSize_64), m_register_cache.AllocateScratch(RegSize_64),
+                         m_register_cache.AllocateScratch(RegSize_64)};
+      const Xbyak::Reg64 V[3] = {GetHostReg64(vector[0]), GetHostReg64(vector[1]), GetHostReg64(vector[2])};
+      for (u32 i = 0; i < 3; i++)
+      {
+        m_emit->movsx(V[i], m_emit->word[GetCPUPtrReg() + offsetof(State, gte_regs.V0) +
+                                         (vertex * sizeof(u32) * 2) + (i * sizeof(s16))]);
+      }
+
+      const auto load_matrix_element = [this](const Xbyak::Reg64& dst, u32 row, u32 column) {
+        m_emit->movsx(dst, m_emit->word[GetCPUPtrReg() + offsetof(State, gte_regs.RT) +
+                                        (((row * 3) + column) * sizeof(s16))]);
+      };
+
+      // MAC1/MAC2 and IR1/IR2 are set like MVMVA.
+      for (u32 i = 0; i < 2; i++)
+      {
+        EmitGTE_MulMatVecRow(m_emit, GetHostReg64(acc), GetHostReg64(temp), V, offsetof(State, gte_regs.TR), i,
+                             load_matrix_element);
+        if (shift != 0)
+          m_emit->sar(GetHostReg64(acc), shift);
+
+        m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.MAC1) + (i * sizeof(u32))],
+                    GetHostReg32(acc));
+        EmitGTE_SaturateIR(m_emit, GetHostReg32(acc), ir_min_value, GTE::FLAGS::GetIRSaturatedBit(i + 1));
+        m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.IR1) + (i * sizeof(u32))],
+                    GetHostReg32(acc));
+      }
+
+      // IR3 is saturated from MAC3, but the flag is from MAC3 SAR 12 regardless of sf and lm, see GTE::RTPS().
+      EmitGTE_MulMatVecRow(m_emit, GetHostReg64(acc), GetHostReg64(temp), V, offsetof(State, gte_regs.TR), 2,
+                           load_matrix_element);
+      m_emit->mov(GetHostReg64(temp), GetHostReg64(acc));
+      if (shift != 0)
+        m_emit->sar(GetHostReg64(temp), shift);
+      m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.MAC3)], GetHostReg32(temp));
+      EmitGTE_SaturateIR(m_emit, GetHostReg32(temp), ir_min_value, 0);
+      m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.IR3)], GetHostReg32(temp));
+
+      m_emit->sar(GetHostReg64(acc), 12);
+      m_emit->mov(GetHostReg32(temp), GetHostReg32(acc));
+      EmitGTE_SaturateIR(m_emit, GetHostReg32(temp), -0x8000, GTE::FLAGS::GetIRSaturatedBit(3));
+
+      // SZ3 = clamp(MAC3 SAR 12, 0, FFFFh), pushing the FIFO along
+      Xbyak::Label sz_saturate_min, sz_done;
+      m_emit->test(GetHostReg32(acc), GetHostReg32(acc));
+      m_emit->js(sz_saturate_min);
+      m_emit->cmp(GetHostReg32(acc), 0xFFFF);
+      m_emit->jle(sz_done);
+      m_emit->mov(GetHostReg32(acc), 0xFFFF);
+      m_emit->or_(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)],
+                  GTE::FLAGS::SZ1_OTZ_SATURATED_BITS);
+      m_emit->jmp(sz_done);
+      m_emit->L(sz_saturate_min);
+      m_emit->xor_(GetHostReg32(acc), GetHostReg32(acc));
+      m_emit->or_(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.FLAG)],
+                  GTE::FLAGS::SZ1_OTZ_SATURATED_BITS);
+      m_emit->L(sz_done);
+      for (u32 i = 0; i < 3; i++)
+      {
+        m_emit->mov(GetHostReg32(temp),
+                    m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.SZ1) + (i * sizeof(u32))]);
+        m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.SZ0) + (i * sizeof(u32))],
+                    GetHostReg32(temp));
+      }
+      m_emit->mov(m_emit->dword[GetCPUPtrReg() + offsetof(State, gte_regs.SZ3)], GetHostReg32(acc));
+    }
+
+    // UNR division and the screen coordinates
+    EmitFunctionCall(nullptr, &GTE::RTPSProject, Value::FromConstantU32((vertex == (num_vertices - 1)) ? 1 : 0));
+  }
+
+  Value temp = m_register_cache.AllocateScratch(RegSize_32);
+  EmitGTE_UpdateError(m_emit, GetHostReg32(temp));
+}
+
 void CodeGenerator::EmitBranch(const void* address, bool allow_scratch)
 {
   const s64 jump_distance =
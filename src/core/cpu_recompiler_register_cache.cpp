@@ -845,8 +845,21 @@ bool RegisterCache::EvictOneGuestRegister()
   if (m_state.guest_reg_order_count == 0)
     return false;
 
-  // evict the register used the longest time ago
+  // evict the register which is referenced furthest away in the block, falling back to the one used the longest time
+  // ago, since a register we're about to use again would just have to be loaded back in
   Reg evict_reg = m_state.guest_reg_order[m_state.guest_reg_order_count - 1];
+  u32 evict_reg_next_use = m_code_generator.GetGuestRegisterNextUse(evict_reg);
+  for (u32 i = m_state.guest_reg_order_count - 1; i > 0 && evict_reg_next_use != UINT32_MAX; i--)
+  {
+    const Reg reg = m_state.guest_reg_order[i - 1];
+    const u32 next_use = m_code_generator.GetGuestRegisterNextUse(reg);
+    if (next_use > evict_reg_next_use)
+    {
+      evict_reg = reg;
+      evict_reg_next_use = next_use;
+    }
+  }
+
   Log_ProfilePrintf("Evicting guest register %s", GetRegName(evict_reg));
   FlushGuestRegister(evict_reg, true, true);
 
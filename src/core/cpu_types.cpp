@@ -234,6 +234,16 @@ bool InstructionHasLoadDelay(const Instruction& instruction)
   }
 }
 
+bool InstructionReferencesRegister(const Instruction& instruction, Reg reg)
+{
+  // Conservative, any instruction with the register in one of its fields counts, even if the field isn't used.
+  if (instruction.r.rs == reg || instruction.r.rt == reg || instruction.r.rd == reg)
+    return true;
+
+  // jal and bltzal/bgezal write the return address without naming it.
+  return (reg == Reg::ra && (IsCallInstruction(instruction) || instruction.op == InstructionOp::b));
+}
+
 bool IsExitBlockInstruction(const Instruction& instruction)
 {
   switch (instruction.op)
@@ -512,13 +512,21 @@ TickCount DMA::TransferMemoryToDevice(Channel channel, u32 address, u32 incremen
     {
       if (g_gpu->BeginDMAWrite())
       {
-        u8* ram_pointer = Bus::g_ram;
-        for (u32 i = 0; i < word_count; i++)
+        if (static_cast<s32>(increment) > 0 && ((address + (increment * word_count)) & ADDRESS_MASK) > address)
         {
-          u32 value;
-          std::memcpy(&value, &ram_pointer[address], sizeof(u32));
-          g_gpu->DMAWrite(address, value);
-          address = (address + increment) & ADDRESS_MASK;
+          // linked list packets and forward block transfers are contiguous, so they can be copied in one go
+          g_gpu->DMAWrite(address, src_pointer, word_count);
+        }
+        else
+        {
+          u8* ram_pointer = Bus::g_ram;
+          for (u32 i = 0; i < word_count; i++)
+          {
+            u32 value;
+            std::memcpy(&value, &ram_pointer[address], sizeof(u32));
+            g_gpu->DMAWrite(address, value);
+            address = (address + increment) & ADDRESS_MASK;
+          }
         }
         g_gpu->EndDMAWrite();
       }
@@ -550,6 +558,7 @@ TickCount DMA::TransferDeviceToMemory(Channel channel, u32 address, u32 incremen
   {
     // clear ordering table
     u8* ram_pointer = Bus::g_ram;
+    const u32 start_address = address;
     const u32 word_count_less_1 = word_count - 1;
     for (u32 i = 0; i < word_count_less_1; i++)
     {
@@ -560,6 +569,13 @@ TickCount DMA::TransferDeviceToMemory(Channel channel, u32 address, u32 incremen
 
     const u32 terminator = UINT32_C(0xFFFFFF);
     std::memcpy(&ram_pointer[address], &terminator, sizeof(terminator));
+
+    // the table is written backwards, so it only wrapped if we ended up past where we started
+    if (address <= start_address)
+      Bus::MarkRAMRangeDirty(address, start_address - address + sizeof(u32));
+    else
+      Bus::MarkRAMRangeDirty(0, Bus::RAM_SIZE);
+
     CPU::CodeCache::InvalidateCodePages(address, word_count);
     return Bus::GetDMARAMTickCount(word_count);
   }
@@ -604,9 +620,14 @@ TickCount DMA::TransferDeviceToMemory(Channel channel, u32 address, u32 incremen
     for (u32 i = 0; i < word_count; i++)
     {
       std::memcpy(&ram_pointer[address], &m_transfer_buffer[i], sizeof(u32));
+      Bus::MarkRAMRangeDirty(address, sizeof(u32));
       address = (address + increment) & ADDRESS_MASK;
     }
   }
+  else
+  {
+    Bus::MarkRAMRangeDirty(address, word_count * sizeof(u32));
+  }
 
   CPU::CodeCache::InvalidateCodePages(address, word_count);
   return Bus::GetDMARAMTickCount(word_count);
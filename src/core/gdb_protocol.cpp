@@ -201,6 +201,8 @@ static std::optional<std::string> Cmd$M(const std::string_view& data)
     u8* ptr_data = GetMemoryPointer(phys_addr, phys_length);
     if (ptr_data) {
       memcpy(ptr_data, payload->data(), phys_length);
+      if (Bus::IsRAMAddress(phys_addr))
+        Bus::MarkRAMRangeDirty(phys_addr & Bus::RAM_MASK, phys_length);
       return { "OK" };
     }
   }
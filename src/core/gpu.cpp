@@ -40,6 +40,8 @@ bool GPU::Initialize(HostDisplay* host_display)
     [](void* param, TickCount ticks, TickCount ticks_late) { static_cast<GPU*>(param)->CommandTickEvent(ticks); }, this,
     true);
   m_fifo_size = g_settings.gpu_fifo_size;
+  m_fifo_addresses.fill(0);
+  m_fifo_track_addresses = g_settings.gpu_pgxp_enable;
   m_max_run_ahead = g_settings.gpu_max_run_ahead;
   m_console_is_pal = System::IsPALRegion();
   UpdateCRTCConfig();
@@ -50,6 +52,7 @@ void GPU::UpdateSettings()
 {
   m_force_progressive_scan = g_settings.gpu_disable_interlacing;
   m_fifo_size = g_settings.gpu_fifo_size;
+  m_fifo_track_addresses = g_settings.gpu_pgxp_enable;
   m_max_run_ahead = g_settings.gpu_max_run_ahead;
 
   if (m_force_ntsc_timings != g_settings.gpu_force_ntsc_timings || m_console_is_pal != System::IsPALRegion())
@@ -198,7 +201,24 @@ bool GPU::DoState(StateWrapper& sw, HostDisplayTexture** host_texture, bool upda
   sw.Do(&m_vram_transfer.col);
   sw.Do(&m_vram_transfer.row);
 
-  sw.Do(&m_fifo);
+  if (sw.GetVersion() < 49)
+  {
+    // FIFO entries used to be 64-bit, with the source address in the upper half.
+    DebugAssert(sw.IsReading());
+    HeapFIFOQueue<u64, MAX_FIFO_SIZE> old_fifo;
+    sw.Do(&old_fifo);
+    m_fifo.Clear();
+    while (!old_fifo.IsEmpty())
+    {
+      const u64 entry = old_fifo.Pop();
+      FifoPush(Truncate32(entry >> 32), Truncate32(entry));
+    }
+  }
+  else
+  {
+    sw.Do(&m_fifo);
+  }
+
   sw.Do(&m_blit_buffer);
   sw.Do(&m_blit_remaining_words);
   sw.Do(&m_render_command.bits);
@@ -345,7 +365,9 @@ void GPU::WriteRegister(u32 offset, u32 value)
   switch (offset)
   {
     case 0x00:
-      m_fifo.Push(value);
+      if (m_dump_recorder)
+        m_dump_recorder->WriteGP0(value);
+      FifoPush(0, value);
       ExecuteCommands();
       UpdateCommandTickEvent();
       return;
@@ -373,6 +395,25 @@ void GPU::DMARead(u32* words, u32 word_count)
     words[i] = ReadGPUREAD();
 }
 
+void GPU::DMAWrite(u32 address, const u32* words, u32 word_count)
+{
+  if (m_dump_recorder)
+    m_dump_recorder->WriteGP0(words, word_count);
+
+  if (m_fifo_track_addresses)
+  {
+    u32 index = GetFifoWriteIndex();
+    for (u32 i = 0; i < word_count; i++)
+    {
+      m_fifo_addresses[index] = address;
+      index = (index + 1) % MAX_FIFO_SIZE;
+      address += sizeof(u32);
+    }
+  }
+
+  m_fifo.PushRange(words, word_count);
+}
+
 void GPU::EndDMAWrite()
 {
   m_fifo_pushed = true;
@@ -854,8 +895,11 @@ void GPU::CRTCTickEvent(TickCount ticks)
         g_interrupt_controller.InterruptRequest(InterruptController::IRQ::VBLANK);
 
         // flush any pending draws and "scan out" the image
-        FlushRender();
-        UpdateDisplay();
+        {
+          System::ScopedFrameTiming frame_timing(System::FrameTimingComponent::GPU);
+          FlushRender();
+          UpdateDisplay();
+        }
         System::FrameDone();
 
         // switch fields early. this is needed so we draw to the correct one.
@@ -863,6 +907,9 @@ void GPU::CRTCTickEvent(TickCount ticks)
           m_crtc_state.interlaced_display_field = m_crtc_state.interlaced_field ^ 1u;
         else
           m_crtc_state.interlaced_display_field = 0;
+
+        if (IsRecordingDump())
+          UpdateDumpRecording();
       }
 
       g_timers.SetGate(HBLANK_TIMER_INDEX, new_vblank);
@@ -967,6 +1014,9 @@ u32 GPU::ReadGPUREAD()
   if (m_blitter_state != BlitterState::ReadingVRAM)
     return m_GPUREAD_latch;
 
+  if (m_dump_recorder)
+    m_dump_recorder->WriteGPUREAD(1);
+
   // Read two pixels out of VRAM and combine them. Zero fill odd pixel counts.
   u32 value = 0;
   for (u32 i = 0; i < 2; i++)
@@ -1000,6 +1050,9 @@ u32 GPU::ReadGPUREAD()
 
 void GPU::WriteGP1(u32 value)
 {
+  if (m_dump_recorder)
+    m_dump_recorder->WriteGP1(value);
+
   const u32 command = (value >> 24) & 0x3Fu;
   const u32 param = value & UINT32_C(0x00FFFFFF);
   switch (command)
@@ -1519,6 +1572,155 @@ bool GPU::DumpVRAMToFile(const char* filename, u32 width, u32 height, u32 stride
   return (stbi_write_png_to_func(write_func, fp.get(), width, height, 4, rgba8_buf.get(), sizeof(u32) * width) != 0);
 }
 
+bool GPU::StartDumpRecording(const char* filename, u32 max_frames)
+{
+  if (IsRecordingDump())
+    return false;
+
+  m_pending_dump_recorder = GPUDump::Recorder::Create(filename, System::IsPALRegion(), max_frames);
+  if (!m_pending_dump_recorder)
+    return false;
+
+  Log_InfoPrintf("Recording GPU dump to '%s' from the next frame", filename);
+  return true;
+}
+
+bool GPU::StopDumpRecording()
+{
+  if (!m_dump_recorder)
+  {
+    // never got to the first frame, so there's nothing worth keeping
+    m_pending_dump_recorder.reset();
+    return false;
+  }
+
+  const bool result = m_dump_recorder->Close();
+  m_dump_recorder.reset();
+  return result;
+}
+
+void GPU::UpdateDumpRecording()
+{
+  if (m_dump_recorder)
+  {
+    m_dump_recorder->WriteVSync(GetDumpFieldBits());
+    if (m_dump_recorder->IsFinished())
+      StopDumpRecording();
+  }
+  else if (m_blitter_state == BlitterState::Idle && m_fifo.IsEmpty())
+  {
+    // only start between commands, otherwise the dump would begin part way through one
+    m_dump_recorder = std::move(m_pending_dump_recorder);
+    WriteDumpInitialState();
+  }
+}
+
+void GPU::WriteDumpInitialState()
+{
+  GPUDump::Recorder* recorder = m_dump_recorder.get();
+  recorder->WriteGP1(0x00000000u);
+  recorder->WriteGP1(0x09000000u | BoolToUInt32(m_set_texture_disable_mask));
+
+  ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  recorder->WriteVRAM(m_vram_ptr);
+
+  // GP1(08h) bits 0-5 are GPUSTAT bits 17-22, bit 6 is GPUSTAT bit 16, and bit 7 is GPUSTAT bit 14.
+  const u32 display_mode =
+    ((m_GPUSTAT.bits >> 17) & 0x3Fu) | (((m_GPUSTAT.bits >> 16) & 1u) << 6) | (((m_GPUSTAT.bits >> 14) & 1u) << 7);
+  recorder->WriteGP1(0x03000000u | BoolToUInt32(m_GPUSTAT.display_disable));
+  recorder->WriteGP1(0x04000000u | static_cast<u32>(m_GPUSTAT.dma_direction.GetValue()));
+  recorder->WriteGP1(0x05000000u | m_crtc_state.regs.display_address_start);
+  recorder->WriteGP1(0x06000000u | m_crtc_state.regs.horizontal_display_range);
+  recorder->WriteGP1(0x07000000u | m_crtc_state.regs.vertical_display_range);
+  recorder->WriteGP1(0x08000000u | display_mode);
+
+  const u32 gp0[] = {
+    0xE1000000u | ZeroExtend32(m_draw_mode.mode_reg.bits),
+    0xE2000000u | (m_draw_mode.texture_window_value & DrawMode::TEXTURE_WINDOW_MASK),
+    0xE3000000u | m_drawing_area.left | (m_drawing_area.top << 10),
+    0xE4000000u | m_drawing_area.right | (m_drawing_area.bottom << 10),
+    0xE5000000u | (static_cast<u32>(m_drawing_offset.x) & 0x7FFu) |
+      ((static_cast<u32>(m_drawing_offset.y) & 0x7FFu) << 11),
+    0xE6000000u | BoolToUInt32(m_GPUSTAT.set_mask_while_drawing) |
+      (BoolToUInt32(m_GPUSTAT.check_mask_before_draw) << 1),
+  };
+  recorder->WriteGP0(gp0, static_cast<u32>(countof(gp0)));
+}
+
+u32 GPU::GetDumpFieldBits() const
+{
+  return (m_crtc_state.interlaced_field ? GPUDump::VSYNC_INTERLACED_FIELD : 0u) |
+         (m_crtc_state.interlaced_display_field ? GPUDump::VSYNC_INTERLACED_DISPLAY_FIELD : 0u) |
+         (m_crtc_state.active_line_lsb ? GPUDump::VSYNC_ACTIVE_LINE_LSB : 0u);
+}
+
+void GPU::ExecuteReplayCommands()
+{
+  // ignore command timing, keep going until we run out of words or are waiting for the rest of a command
+  for (;;)
+  {
+    const u32 fifo_size = m_fifo.GetSize();
+    const BlitterState blitter_state = m_blitter_state;
+    m_pending_command_ticks = 0;
+    ExecuteCommands();
+    if (m_fifo.IsEmpty() || (m_fifo.GetSize() == fifo_size && m_blitter_state == blitter_state))
+      break;
+  }
+
+  m_pending_command_ticks = 0;
+  UpdateCommandTickEvent();
+}
+
+void GPU::ReplayVRAM(const u16* pixels)
+{
+  UpdateVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT, pixels, false, false);
+}
+
+void GPU::ReplayGP0(const u32* words, u32 word_count)
+{
+  while (word_count > 0)
+  {
+    const u32 count = std::min(m_fifo.GetSpace(), word_count);
+    if (count == 0)
+    {
+      Log_WarningPrintf("GPU FIFO full during replay, dropping %u words", word_count);
+      return;
+    }
+
+    DMAWrite(0, words, count);
+    words += count;
+    word_count -= count;
+    ExecuteReplayCommands();
+  }
+}
+
+void GPU::ReplayGP1(u32 value)
+{
+  WriteGP1(value);
+}
+
+void GPU::ReplayGPUREAD(u32 word_count)
+{
+  for (u32 i = 0; i < word_count; i++)
+    ReadGPUREAD();
+
+  ExecuteReplayCommands();
+}
+
+void GPU::ReplayVSync(u32 field_bits)
+{
+  {
+    System::ScopedFrameTiming frame_timing(System::FrameTimingComponent::GPU);
+    FlushRender();
+    UpdateDisplay();
+  }
+  System::FrameDone();
+
+  m_crtc_state.interlaced_field = BoolToUInt8((field_bits & GPUDump::VSYNC_INTERLACED_FIELD) != 0);
+  m_crtc_state.interlaced_display_field = BoolToUInt8((field_bits & GPUDump::VSYNC_INTERLACED_DISPLAY_FIELD) != 0);
+  m_crtc_state.active_line_lsb = BoolToUInt8((field_bits & GPUDump::VSYNC_ACTIVE_LINE_LSB) != 0);
+}
+
 void GPU::DrawDebugStateWindow()
 {
 #ifdef WITH_IMGUI
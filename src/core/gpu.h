@@ -1,7 +1,9 @@
 #pragma once
 #include "common/bitfield.h"
 #include "common/fifo_queue.h"
+#include "common/heap_array.h"
 #include "common/rectangle.h"
+#include "gpu_dump.h"
 #include "gpu_types.h"
 #include "timers.h"
 #include "types.h"
@@ -98,8 +100,11 @@ public:
   ALWAYS_INLINE bool BeginDMAWrite() const { return (m_GPUSTAT.dma_direction == DMADirection::CPUtoGP0); }
   ALWAYS_INLINE void DMAWrite(u32 address, u32 value)
   {
-    m_fifo.Push((ZeroExtend64(address) << 32) | ZeroExtend64(value));
+    if (m_dump_recorder)
+      m_dump_recorder->WriteGP0(value);
+    FifoPush(address, value);
   }
+  void DMAWrite(u32 address, const u32* words, u32 word_count);
   void EndDMAWrite();
 
   /// Returns true if no data is being sent from VRAM to the DAC or that no portion of VRAM would be visible on screen.
@@ -164,6 +169,18 @@ public:
   // Dumps raw VRAM to a file.
   bool DumpVRAMToFile(const char* filename);
 
+  /// Records all GPU register writes to a file, starting at the next vblank. Stops after max_frames, if non-zero.
+  bool StartDumpRecording(const char* filename, u32 max_frames);
+  bool StopDumpRecording();
+  ALWAYS_INLINE bool IsRecordingDump() const { return (m_dump_recorder || m_pending_dump_recorder); }
+
+  // GPU dump playback. Commands are executed immediately, as if the GPU was infinitely fast.
+  void ReplayVRAM(const u16* pixels);
+  void ReplayGP0(const u32* words, u32 word_count);
+  void ReplayGP1(u32 value);
+  void ReplayGPUREAD(u32 word_count);
+  void ReplayVSync(u32 field_bits);
+
 protected:
   TickCount CRTCTicksToSystemTicks(TickCount crtc_ticks, TickCount fractional_ticks) const;
   TickCount SystemTicksToCRTCTicks(TickCount sysclk_ticks, TickCount* fractional_ticks) const;
@@ -282,6 +299,11 @@ protected:
 
   void AddCommandTicks(TickCount ticks);
 
+  void UpdateDumpRecording();
+  void WriteDumpInitialState();
+  u32 GetDumpFieldBits() const;
+  void ExecuteReplayCommands();
+
   void WriteGP1(u32 value);
   void EndCommand();
   void ExecuteCommands();
@@ -552,18 +574,47 @@ protected:
     u16 row;
   } m_vram_transfer = {};
 
-  HeapFIFOQueue<u64, MAX_FIFO_SIZE> m_fifo;
+  HeapFIFOQueue<u32, MAX_FIFO_SIZE> m_fifo;
   std::vector<u32> m_blit_buffer;
   u32 m_blit_remaining_words;
   GPURenderCommand m_render_command{};
 
-  ALWAYS_INLINE u32 FifoPop() { return Truncate32(m_fifo.Pop()); }
-  ALWAYS_INLINE u32 FifoPeek() { return Truncate32(m_fifo.Peek()); }
-  ALWAYS_INLINE u32 FifoPeek(u32 i) { return Truncate32(m_fifo.Peek(i)); }
+  // Source RAM address of each word in the FIFO, at the same position as the word. Only written when PGXP is enabled,
+  // since it's only needed to look up precise vertex positions.
+  HeapArray<u32, MAX_FIFO_SIZE> m_fifo_addresses;
+  bool m_fifo_track_addresses = false;
+
+  ALWAYS_INLINE u32 GetFifoWriteIndex() { return static_cast<u32>(m_fifo.GetWritePointer() - m_fifo.GetDataPointer()); }
+  ALWAYS_INLINE u32 GetFifoReadIndex() { return static_cast<u32>(m_fifo.GetReadPointer() - m_fifo.GetDataPointer()); }
+
+  ALWAYS_INLINE void FifoPush(u32 address, u32 value)
+  {
+    if (m_fifo_track_addresses)
+      m_fifo_addresses[GetFifoWriteIndex()] = address;
+    m_fifo.Push(value);
+  }
+
+  ALWAYS_INLINE u32 FifoPop() { return m_fifo.Pop(); }
+  ALWAYS_INLINE u32 FifoPeek() { return m_fifo.Peek(); }
+  ALWAYS_INLINE u32 FifoPeek(u32 i) { return m_fifo.Peek(i); }
+
+  /// Pops a word, also returning the address it was written from. The address is only valid when PGXP is enabled.
+  ALWAYS_INLINE u32 FifoPopWithAddress(u32* address)
+  {
+    *address = m_fifo_addresses[GetFifoReadIndex()];
+    return m_fifo.Pop();
+  }
+
+  /// Pops a range of words into the end of the blit buffer.
+  void FifoPopToBlitBuffer(u32 count);
 
   TickCount m_max_run_ahead = 128;
   u32 m_fifo_size = 128;
 
+  // The pending recorder is promoted at the next vblank where the GPU is idle.
+  std::unique_ptr<GPUDump::Recorder> m_dump_recorder;
+  std::unique_ptr<GPUDump::Recorder> m_pending_dump_recorder;
+
   struct Stats
   {
     u32 num_vram_reads;
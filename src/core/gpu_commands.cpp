@@ -22,8 +22,16 @@ static constexpr u32 ReplaceZero(u32 value, u32 value_for_zero)
   return value == 0 ? value_for_zero : value;
 }
 
+void GPU::FifoPopToBlitBuffer(u32 count)
+{
+  const size_t offset = m_blit_buffer.size();
+  m_blit_buffer.resize(offset + count);
+  m_fifo.PopRange(&m_blit_buffer[offset], count);
+}
+
 void GPU::ExecuteCommands()
 {
+  System::ScopedFrameTiming frame_timing(System::FrameTimingComponent::GPU);
   m_syncing = true;
 
   for (;;)
@@ -45,9 +53,7 @@ void GPU::ExecuteCommands()
         {
           DebugAssert(m_blit_remaining_words > 0);
           const u32 words_to_copy = std::min(m_blit_remaining_words, m_fifo.GetSize());
-          m_blit_buffer.reserve(m_blit_buffer.size() + words_to_copy);
-          for (u32 i = 0; i < words_to_copy; i++)
-            m_blit_buffer.push_back(FifoPop());
+          FifoPopToBlitBuffer(words_to_copy);
           m_blit_remaining_words -= words_to_copy;
 
           Log_DebugPrintf("VRAM write burst of %u words, %u words remaining", words_to_copy, m_blit_remaining_words);
@@ -79,11 +85,7 @@ void GPU::ExecuteCommands()
           const bool found_terminator = (terminator_index < m_fifo.GetSize());
           const u32 words_to_copy = std::min(terminator_index, m_fifo.GetSize());
           if (words_to_copy > 0)
-          {
-            m_blit_buffer.reserve(m_blit_buffer.size() + words_to_copy);
-            for (u32 i = 0; i < words_to_copy; i++)
-              m_blit_buffer.push_back(FifoPop());
-          }
+            FifoPopToBlitBuffer(words_to_copy);
 
           Log_DebugPrintf("Added %u words to polyline", words_to_copy);
           if (found_terminator)
@@ -429,12 +431,7 @@ bool GPU::HandleRenderPolyLineCommand()
   m_render_command.bits = rc.bits;
   m_fifo.RemoveOne();
 
-  const u32 words_to_pop = min_words - 1;
-  // m_blit_buffer.resize(words_to_pop);
-  // FifoPopRange(m_blit_buffer.data(), words_to_pop);
-  m_blit_buffer.reserve(words_to_pop);
-  for (u32 i = 0; i < words_to_pop; i++)
-    m_blit_buffer.push_back(Truncate32(FifoPop()));
+  FifoPopToBlitBuffer(min_words - 1);
 
   // polyline goes via a different path through the blit buffer
   m_blitter_state = BlitterState::DrawingPolyLine;
@@ -0,0 +1,263 @@
+#include "gpu_dump.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "gpu.h"
+#include "gpu_types.h"
+#include <cstring>
+#include <optional>
+Log_SetChannel(GPUDump);
+
+namespace GPUDump {
+
+static constexpr u32 HEADER_WORDS = 3;
+static constexpr u32 VRAM_WORDS = (VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16)) / sizeof(u32);
+
+// Large enough to hold a typical frame's worth of commands in one packet.
+static constexpr u32 MAX_GP0_BUFFER_WORDS = 64 * 1024;
+
+Recorder::Recorder(std::FILE* fp, std::string filename, u32 max_frames)
+  : m_fp(fp), m_filename(std::move(filename)), m_max_frames(max_frames)
+{
+  m_gp0_buffer.reserve(MAX_GP0_BUFFER_WORDS);
+}
+
+Recorder::~Recorder()
+{
+  if (m_fp)
+    Close();
+}
+
+std::unique_ptr<Recorder> Recorder::Create(const char* filename, bool pal, u32 max_frames)
+{
+  std::FILE* fp = FileSystem::OpenCFile(filename, "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open GPU dump '%s' for writing", filename);
+    return {};
+  }
+
+  const u32 header[HEADER_WORDS] = {FILE_MAGIC, FILE_VERSION, pal ? FILE_FLAG_PAL : 0u};
+  if (std::fwrite(header, sizeof(header), 1, fp) != 1)
+  {
+    Log_ErrorPrintf("Failed to write GPU dump header to '%s'", filename);
+    std::fclose(fp);
+    return {};
+  }
+
+  return std::unique_ptr<Recorder>(new Recorder(fp, filename, max_frames));
+}
+
+void Recorder::WriteVRAM(const u16* pixels)
+{
+  FlushGP0();
+  FlushGPUREAD();
+  WritePacket(PacketType::VRAM, reinterpret_cast<const u32*>(pixels), VRAM_WORDS);
+}
+
+void Recorder::WriteGP0(u32 value)
+{
+  FlushGPUREAD();
+  m_gp0_buffer.push_back(value);
+  if (m_gp0_buffer.size() >= MAX_GP0_BUFFER_WORDS)
+    FlushGP0();
+}
+
+void Recorder::WriteGP0(const u32* words, u32 word_count)
+{
+  FlushGPUREAD();
+  m_gp0_buffer.insert(m_gp0_buffer.end(), words, words + word_count);
+  if (m_gp0_buffer.size() >= MAX_GP0_BUFFER_WORDS)
+    FlushGP0();
+}
+
+void Recorder::WriteGP1(u32 value)
+{
+  FlushGP0();
+  FlushGPUREAD();
+  WritePacket(PacketType::GP1, &value, 1);
+}
+
+void Recorder::WriteGPUREAD(u32 word_count)
+{
+  FlushGP0();
+  m_gpuread_count += word_count;
+}
+
+void Recorder::WriteVSync(u32 field_bits)
+{
+  FlushGP0();
+  FlushGPUREAD();
+  WritePacket(PacketType::VSync, &field_bits, 1);
+  m_frame_count++;
+}
+
+bool Recorder::Close()
+{
+  FlushGP0();
+  FlushGPUREAD();
+
+  const bool result = (std::fflush(m_fp) == 0 && std::ferror(m_fp) == 0);
+  std::fclose(m_fp);
+  m_fp = nullptr;
+
+  if (result)
+    Log_InfoPrintf("Wrote %u frames to GPU dump '%s'", m_frame_count, m_filename.c_str());
+  else
+    Log_ErrorPrintf("Failed to write GPU dump '%s'", m_filename.c_str());
+
+  return result;
+}
+
+void Recorder::FlushGP0()
+{
+  if (m_gp0_buffer.empty())
+    return;
+
+  WritePacket(PacketType::GP0, m_gp0_buffer.data(), static_cast<u32>(m_gp0_buffer.size()));
+  m_gp0_buffer.clear();
+}
+
+void Recorder::FlushGPUREAD()
+{
+  if (m_gpuread_count == 0)
+    return;
+
+  WritePacket(PacketType::GPUREAD, &m_gpuread_count, 1);
+  m_gpuread_count = 0;
+}
+
+void Recorder::WritePacket(PacketType type, const u32* words, u32 word_count)
+{
+  DebugAssert(word_count <= MAX_PACKET_WORDS);
+  const u32 header = (static_cast<u32>(type) << 24) | word_count;
+  std::fwrite(&header, sizeof(header), 1, m_fp);
+  std::fwrite(words, sizeof(u32), word_count, m_fp);
+}
+
+Player::Player(std::vector<u32> data, u32 flags, u32 frame_count)
+  : m_data(std::move(data)), m_flags(flags), m_frame_count(frame_count)
+{
+}
+
+Player::~Player() = default;
+
+std::unique_ptr<Player> Player::Open(const char* filename)
+{
+  // read the whole dump up front, so file access doesn't show up in the frame timings
+  std::optional<std::vector<u8>> bytes = FileSystem::ReadBinaryFile(filename);
+  if (!bytes.has_value())
+  {
+    Log_ErrorPrintf("Failed to read GPU dump '%s'", filename);
+    return {};
+  }
+
+  if (bytes->size() < (HEADER_WORDS * sizeof(u32)) || (bytes->size() % sizeof(u32)) != 0)
+  {
+    Log_ErrorPrintf("GPU dump '%s' is truncated", filename);
+    return {};
+  }
+
+  u32 header[HEADER_WORDS];
+  std::memcpy(header, bytes->data(), sizeof(header));
+  if (header[0] != FILE_MAGIC || header[1] != FILE_VERSION)
+  {
+    Log_ErrorPrintf("GPU dump '%s' has an invalid header or unsupported version", filename);
+    return {};
+  }
+
+  std::vector<u32> data((bytes->size() / sizeof(u32)) - HEADER_WORDS);
+  std::memcpy(data.data(), bytes->data() + sizeof(header), data.size() * sizeof(u32));
+  bytes.reset();
+
+  // validate packets now, so playback doesn't have to
+  u32 frame_count = 0;
+  size_t position = 0;
+  while (position < data.size())
+  {
+    const PacketType type = static_cast<PacketType>(data[position] >> 24);
+    const u32 word_count = data[position] & MAX_PACKET_WORDS;
+    bool valid;
+    switch (type)
+    {
+      case PacketType::VRAM:
+        valid = (word_count == VRAM_WORDS);
+        break;
+
+      case PacketType::GP0:
+      case PacketType::GP1:
+        valid = true;
+        break;
+
+      case PacketType::GPUREAD:
+      case PacketType::VSync:
+        valid = (word_count == 1);
+        frame_count += BoolToUInt32(type == PacketType::VSync);
+        break;
+
+      default:
+        valid = false;
+        break;
+    }
+
+    if (!valid || (data.size() - position - 1) < word_count)
+    {
+      Log_ErrorPrintf("GPU dump '%s' has an invalid packet at offset %zu", filename,
+                      (position + HEADER_WORDS) * sizeof(u32));
+      return {};
+    }
+
+    position += 1 + word_count;
+  }
+
+  if (frame_count == 0)
+  {
+    Log_ErrorPrintf("GPU dump '%s' does not contain any frames", filename);
+    return {};
+  }
+
+  Log_InfoPrintf("Loaded GPU dump '%s' with %u frames", filename, frame_count);
+  return std::unique_ptr<Player>(new Player(std::move(data), header[2], frame_count));
+}
+
+void Player::Execute()
+{
+  for (;;)
+  {
+    // loop back to the start, which resets the GPU and reloads VRAM
+    if (m_position == m_data.size())
+      m_position = 0;
+
+    const PacketType type = static_cast<PacketType>(m_data[m_position] >> 24);
+    const u32 word_count = m_data[m_position] & MAX_PACKET_WORDS;
+    const u32* words = m_data.data() + m_position + 1;
+    m_position += 1 + word_count;
+
+    switch (type)
+    {
+      case PacketType::VRAM:
+        g_gpu->ReplayVRAM(reinterpret_cast<const u16*>(words));
+        break;
+
+      case PacketType::GP0:
+        g_gpu->ReplayGP0(words, word_count);
+        break;
+
+      case PacketType::GP1:
+      {
+        for (u32 i = 0; i < word_count; i++)
+          g_gpu->ReplayGP1(words[i]);
+      }
+      break;
+
+      case PacketType::GPUREAD:
+        g_gpu->ReplayGPUREAD(words[0]);
+        break;
+
+      case PacketType::VSync:
+        g_gpu->ReplayVSync(words[0]);
+        return;
+    }
+  }
+}
+
+} // namespace GPUDump
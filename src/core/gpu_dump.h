@@ -0,0 +1,110 @@
+#pragma once
+#include "types.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// GPU dumps record everything the CPU sends to the GPU, so a sequence of frames can be replayed through any renderer
+// without emulating the rest of the system.
+//
+// File layout, all values little-endian:
+//   u32 magic ('DGPU'), u32 version, u32 flags (FileFlags)
+//   packets, each a u32 header of (type << 24) | word_count, followed by word_count u32s.
+//
+// The first packets restore the state at the start of the recording: the contents of VRAM, followed by GP1 and GP0
+// register writes which reproduce the display configuration and drawing state.
+namespace GPUDump {
+
+enum : u32
+{
+  FILE_MAGIC = 0x55504744, // DGPU
+  FILE_VERSION = 1,
+  MAX_PACKET_WORDS = 0x00FFFFFF,
+};
+
+enum FileFlags : u32
+{
+  FILE_FLAG_PAL = (1u << 0),
+};
+
+enum class PacketType : u8
+{
+  VRAM = 0,    // initial VRAM contents, VRAM_WIDTH * VRAM_HEIGHT pixels
+  GP0 = 1,     // words written to GP0, via MMIO or DMA
+  GP1 = 2,     // words written to GP1
+  GPUREAD = 3, // one word, the number of words read from GPUREAD
+  VSync = 4,   // start of vblank, one word of CRTC field state (VSyncFieldBits)
+};
+
+enum VSyncFieldBits : u32
+{
+  VSYNC_INTERLACED_FIELD = (1u << 0),
+  VSYNC_INTERLACED_DISPLAY_FIELD = (1u << 1),
+  VSYNC_ACTIVE_LINE_LSB = (1u << 2),
+};
+
+class Recorder
+{
+public:
+  ~Recorder();
+
+  static std::unique_ptr<Recorder> Create(const char* filename, bool pal, u32 max_frames);
+
+  ALWAYS_INLINE const std::string& GetFileName() const { return m_filename; }
+  ALWAYS_INLINE u32 GetFrameCount() const { return m_frame_count; }
+
+  /// Returns true once the requested number of frames have been recorded.
+  ALWAYS_INLINE bool IsFinished() const { return (m_max_frames > 0 && m_frame_count >= m_max_frames); }
+
+  void WriteVRAM(const u16* pixels);
+  void WriteGP0(u32 value);
+  void WriteGP0(const u32* words, u32 word_count);
+  void WriteGP1(u32 value);
+  void WriteGPUREAD(u32 word_count);
+  void WriteVSync(u32 field_bits);
+
+  /// Writes any buffered data, returns false if the file could not be written.
+  bool Close();
+
+private:
+  Recorder(std::FILE* fp, std::string filename, u32 max_frames);
+
+  void FlushGP0();
+  void FlushGPUREAD();
+  void WritePacket(PacketType type, const u32* words, u32 word_count);
+
+  std::FILE* m_fp;
+  std::string m_filename;
+  std::vector<u32> m_gp0_buffer;
+  u32 m_gpuread_count = 0;
+  u32 m_frame_count = 0;
+  u32 m_max_frames;
+};
+
+class Player
+{
+public:
+  ~Player();
+
+  static std::unique_ptr<Player> Open(const char* filename);
+
+  ALWAYS_INLINE bool IsPAL() const { return (m_flags & FILE_FLAG_PAL) != 0; }
+  ALWAYS_INLINE u32 GetFrameCount() const { return m_frame_count; }
+
+  /// Replays packets up to and including the next vsync. Restarts from the beginning at the end of the dump.
+  void Execute();
+
+  /// Restarts playback from the first frame.
+  ALWAYS_INLINE void Reset() { m_position = 0; }
+
+private:
+  Player(std::vector<u32> data, u32 flags, u32 frame_count);
+
+  std::vector<u32> m_data;
+  u32 m_flags;
+  u32 m_frame_count;
+  size_t m_position = 0;
+};
+
+} // namespace GPUDump
@@ -255,10 +255,125 @@ void GPU_HW::PrintSettingsToLog()
   Log_InfoPrintf("Downsampling: %s", Settings::GetDownsampleModeDisplayName(m_downsample_mode));
 }
 
-void GPU_HW::UpdateVRAMReadTexture()
+void GPU_HW::SetFullVRAMDirtyRectangle()
 {
+  for (u32 page_y = 0; page_y < VRAM_DIRTY_PAGES_Y; page_y++)
+  {
+    for (u32 page_x = 0; page_x < VRAM_DIRTY_PAGES_X; page_x++)
+    {
+      m_vram_dirty_pages[page_y * VRAM_DIRTY_PAGES_X + page_x] = Common::Rectangle<u32>::FromExtents(
+        page_x * VRAM_DIRTY_PAGE_WIDTH, page_y * VRAM_DIRTY_PAGE_HEIGHT, VRAM_DIRTY_PAGE_WIDTH, VRAM_DIRTY_PAGE_HEIGHT);
+    }
+  }
+
+  m_vram_dirty_page_mask = (NUM_VRAM_DIRTY_PAGES == 32) ? UINT32_C(0xFFFFFFFF) : ((1u << NUM_VRAM_DIRTY_PAGES) - 1u);
+  m_draw_mode.SetTexturePageChanged();
+}
+
+void GPU_HW::ClearVRAMDirtyRectangle()
+{
+  for (Common::Rectangle<u32>& rect : m_vram_dirty_pages)
+    rect.SetInvalid();
+  m_vram_dirty_page_mask = 0;
+}
+
+void GPU_HW::IncludeVRAMDirtyPages(const Common::Rectangle<u32>& rect)
+{
+  if (!rect.HasExtents())
+    return;
+
+  const u32 start_page_x = rect.left / VRAM_DIRTY_PAGE_WIDTH;
+  const u32 end_page_x = std::min<u32>((rect.right - 1) / VRAM_DIRTY_PAGE_WIDTH, VRAM_DIRTY_PAGES_X - 1);
+  const u32 start_page_y = rect.top / VRAM_DIRTY_PAGE_HEIGHT;
+  const u32 end_page_y = std::min<u32>((rect.bottom - 1) / VRAM_DIRTY_PAGE_HEIGHT, VRAM_DIRTY_PAGES_Y - 1);
+  for (u32 page_y = start_page_y; page_y <= end_page_y; page_y++)
+  {
+    const u32 page_top = page_y * VRAM_DIRTY_PAGE_HEIGHT;
+    for (u32 page_x = start_page_x; page_x <= end_page_x; page_x++)
+    {
+      const u32 page_left = page_x * VRAM_DIRTY_PAGE_WIDTH;
+      const u32 page_index = page_y * VRAM_DIRTY_PAGES_X + page_x;
+      m_vram_dirty_pages[page_index].Include(
+        rect.Clamped(page_left, page_top, page_left + VRAM_DIRTY_PAGE_WIDTH, page_top + VRAM_DIRTY_PAGE_HEIGHT));
+      m_vram_dirty_page_mask |= (1u << page_index);
+    }
+  }
+}
+
+u32 GPU_HW::GetVRAMDirtyPageMask(const Common::Rectangle<u32>& area) const
+{
+  if (m_vram_dirty_page_mask == 0 || !area.HasExtents())
+    return 0;
+
+  // texture pages and palettes can run off the right edge of VRAM, in which case they wrap around to the left
+  if (area.right > VRAM_WIDTH)
+  {
+    const u32 wrapped_right = std::min<u32>(area.right - VRAM_WIDTH, VRAM_WIDTH);
+    return GetVRAMDirtyPageMask(Common::Rectangle<u32>(area.left, area.top, VRAM_WIDTH, area.bottom)) |
+           GetVRAMDirtyPageMask(Common::Rectangle<u32>(0, area.top, wrapped_right, area.bottom));
+  }
+
+  const Common::Rectangle<u32> clamped_area = area.Clamped(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  if (!clamped_area.HasExtents())
+    return 0;
+
+  const u32 start_page_x = clamped_area.left / VRAM_DIRTY_PAGE_WIDTH;
+  const u32 end_page_x = (clamped_area.right - 1) / VRAM_DIRTY_PAGE_WIDTH;
+  const u32 start_page_y = clamped_area.top / VRAM_DIRTY_PAGE_HEIGHT;
+  const u32 end_page_y = (clamped_area.bottom - 1) / VRAM_DIRTY_PAGE_HEIGHT;
+
+  u32 mask = 0;
+  for (u32 page_y = start_page_y; page_y <= end_page_y; page_y++)
+  {
+    for (u32 page_x = start_page_x; page_x <= end_page_x; page_x++)
+    {
+      const u32 page_index = page_y * VRAM_DIRTY_PAGES_X + page_x;
+      if ((m_vram_dirty_page_mask & (1u << page_index)) && m_vram_dirty_pages[page_index].Intersects(clamped_area))
+        mask |= (1u << page_index);
+    }
+  }
+
+  return mask;
+}
+
+void GPU_HW::UpdateVRAMReadTexture(u32 page_mask)
+{
+  page_mask &= m_vram_dirty_page_mask;
+  if (page_mask == 0)
+    return;
+
+  // pages are visited in row-major order, so a rectangle which was split across pages can be stitched back together
+  // by merging with neighbours which share an edge
+  std::array<Common::Rectangle<u32>, NUM_VRAM_DIRTY_PAGES> rects;
+  u32 num_rects = 0;
+  for (u32 page_index = 0; page_index < NUM_VRAM_DIRTY_PAGES; page_index++)
+  {
+    if (!(page_mask & (1u << page_index)))
+      continue;
+
+    Common::Rectangle<u32>& page_rect = m_vram_dirty_pages[page_index];
+    bool merged = false;
+    for (u32 i = 0; i < num_rects; i++)
+    {
+      Common::Rectangle<u32>& rect = rects[i];
+      if ((rect.right == page_rect.left && rect.top == page_rect.top && rect.bottom == page_rect.bottom) ||
+          (rect.bottom == page_rect.top && rect.left == page_rect.left && rect.right == page_rect.right))
+      {
+        rect.Include(page_rect);
+        merged = true;
+        break;
+      }
+    }
+    if (!merged)
+      rects[num_rects++] = page_rect;
+
+    page_rect.SetInvalid();
+  }
+
+  m_vram_dirty_page_mask &= ~page_mask;
+
+  CopyVRAMToReadTexture(rects.data(), num_rects);
   m_renderer_stats.num_vram_read_texture_updates++;
-  ClearVRAMDirtyRectangle();
 }
 
 void GPU_HW::HandleFlippedQuadTextureCoordinates(BatchVertex* vertices)
@@ -378,7 +493,7 @@ void GPU_HW::SetBatchDepthBuffer(bool enabled)
 
   if (GetBatchVertexCount() > 0)
   {
-    FlushRender();
+    FlushRender(BatchFlushReason::DepthBufferChanged);
     EnsureVertexBufferSpaceForCurrentCommand();
   }
 
@@ -398,7 +513,7 @@ void GPU_HW::CheckForDepthClear(const BatchVertex* vertices, u32 num_vertices)
   {
     if (GetBatchVertexCount() > 0)
     {
-      FlushRender();
+      FlushRender(BatchFlushReason::DepthClear);
       EnsureVertexBufferSpaceForCurrentCommand();
     }
 
@@ -532,6 +647,8 @@ void GPU_HW::LoadVertices()
   if (m_GPUSTAT.check_mask_before_draw)
     m_current_depth++;
 
+  m_primitive_bounds.SetInvalid();
+
   const GPURenderCommand rc{m_render_command.bits};
   const u32 texpage = ZeroExtend32(m_draw_mode.mode_reg.bits) | (ZeroExtend32(m_draw_mode.palette_reg) << 16);
   const float depth = GetCurrentNormalizedVertexDepth();
@@ -554,8 +671,8 @@ void GPU_HW::LoadVertices()
       for (u32 i = 0; i < num_vertices; i++)
       {
         const u32 color = (shaded && i > 0) ? (FifoPop() & UINT32_C(0x00FFFFFF)) : first_color;
-        const u64 maddr_and_pos = m_fifo.Pop();
-        const GPUVertexPosition vp{Truncate32(maddr_and_pos)};
+        u32 vertex_address;
+        const GPUVertexPosition vp{FifoPopWithAddress(&vertex_address)};
         const u16 texcoord = textured ? Truncate16(FifoPop()) : 0;
         const s32 native_x = m_drawing_offset.x + vp.x;
         const s32 native_y = m_drawing_offset.y + vp.y;
@@ -567,7 +684,7 @@ void GPU_HW::LoadVertices()
         if (pgxp)
         {
           valid_w &=
-            PGXP::GetPreciseVertex(Truncate32(maddr_and_pos >> 32), vp.bits, native_x, native_y, m_drawing_offset.x,
+            PGXP::GetPreciseVertex(vertex_address, vp.bits, native_x, native_y, m_drawing_offset.x,
                                    m_drawing_offset.y, &vertices[i].x, &vertices[i].y, &vertices[i].w);
         }
       }
@@ -617,7 +734,7 @@ void GPU_HW::LoadVertices()
         const u32 clip_bottom =
           static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-        m_vram_dirty_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+        IncludePrimitiveBounds(clip_left, clip_top, clip_right, clip_bottom);
         AddDrawTriangleTicks(native_vertex_positions[0][0], native_vertex_positions[0][1],
                              native_vertex_positions[1][0], native_vertex_positions[1][1],
                              native_vertex_positions[2][0], native_vertex_positions[2][1], rc.shading_enable,
@@ -651,7 +768,7 @@ void GPU_HW::LoadVertices()
           const u32 clip_bottom =
             static_cast<u32>(std::clamp<s32>(max_y_123, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-          m_vram_dirty_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+          IncludePrimitiveBounds(clip_left, clip_top, clip_right, clip_bottom);
           AddDrawTriangleTicks(native_vertex_positions[2][0], native_vertex_positions[2][1],
                                native_vertex_positions[1][0], native_vertex_positions[1][1],
                                native_vertex_positions[3][0], native_vertex_positions[3][1], rc.shading_enable,
@@ -755,7 +872,7 @@ void GPU_HW::LoadVertices()
       const u32 clip_bottom =
         static_cast<u32>(std::clamp<s32>(pos_y + rectangle_height, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-      m_vram_dirty_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+      IncludePrimitiveBounds(clip_left, clip_top, clip_right, clip_bottom);
       AddDrawRectangleTicks(clip_right - clip_left, clip_bottom - clip_top, rc.texture_enable, rc.transparency_enable);
     }
     break;
@@ -805,7 +922,7 @@ void GPU_HW::LoadVertices()
         const u32 clip_bottom =
           static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-        m_vram_dirty_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+        IncludePrimitiveBounds(clip_left, clip_top, clip_right, clip_bottom);
         AddDrawLineTicks(clip_right - clip_left, clip_bottom - clip_top, rc.shading_enable);
 
         // TODO: Should we do a PGXP lookup here? Most lines are 2D.
@@ -851,7 +968,7 @@ void GPU_HW::LoadVertices()
             const u32 clip_bottom =
               static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-            m_vram_dirty_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+            IncludePrimitiveBounds(clip_left, clip_top, clip_right, clip_bottom);
             AddDrawLineTicks(clip_right - clip_left, clip_bottom - clip_top, rc.shading_enable);
 
             // TODO: Should we do a PGXP lookup here? Most lines are 2D.
@@ -949,7 +1066,7 @@ GPU_HW::VRAMCopyUBOData GPU_HW::GetVRAMCopyUBOData(u32 src_x, u32 src_y, u32 dst
 
 void GPU_HW::IncludeVRAMDirtyRectangle(const Common::Rectangle<u32>& rect)
 {
-  m_vram_dirty_rect.Include(rect);
+  IncludeVRAMDirtyPages(rect);
 
   // the vram area can include the texture page, but the game can leave it as-is. in this case, set it as dirty so the
   // shadow texture is updated
@@ -968,28 +1085,29 @@ void GPU_HW::EnsureVertexBufferSpace(u32 required_vertices)
     if (GetBatchVertexSpace() >= required_vertices)
       return;
 
-    FlushRender();
+    FlushRender(BatchFlushReason::VertexBufferFull);
   }
 
   MapBatchVertexPointer(required_vertices);
 }
 
-void GPU_HW::EnsureVertexBufferSpaceForCurrentCommand()
+u32 GPU_HW::GetRequiredVerticesForCurrentCommand() const
 {
-  u32 required_vertices;
   switch (m_render_command.primitive)
   {
     case GPUPrimitive::Polygon:
-      required_vertices = m_render_command.quad_polygon ? 6 : 3;
-      break;
+      return m_render_command.quad_polygon ? 6 : 3;
     case GPUPrimitive::Rectangle:
-      required_vertices = MAX_VERTICES_FOR_RECTANGLE;
-      break;
+      return MAX_VERTICES_FOR_RECTANGLE;
     case GPUPrimitive::Line:
     default:
-      required_vertices = m_render_command.polyline ? (GetPolyLineVertexCount() * 6u) : 6u;
-      break;
+      return m_render_command.polyline ? (GetPolyLineVertexCount() * 6u) : 6u;
   }
+}
+
+void GPU_HW::EnsureVertexBufferSpaceForCurrentCommand()
+{
+  const u32 required_vertices = GetRequiredVerticesForCurrentCommand();
 
   // can we fit these vertices in the current depth buffer range?
   if ((m_current_depth + required_vertices) > MAX_BATCH_VERTEX_COUNTER_IDS)
@@ -1002,7 +1120,7 @@ void GPU_HW::EnsureVertexBufferSpaceForCurrentCommand()
     if (GetBatchVertexSpace() >= required_vertices)
       return;
 
-    FlushRender();
+    FlushRender(BatchFlushReason::VertexBufferFull);
   }
 
   MapBatchVertexPointer(required_vertices);
@@ -1014,7 +1132,7 @@ void GPU_HW::ResetBatchVertexDepth()
     return;
 
   Log_PerfPrint("Resetting batch vertex depth");
-  FlushRender();
+  FlushRender(BatchFlushReason::DepthCounterExhausted);
   UpdateDepthBufferFromMaskBit();
 
   m_current_depth = 1;
@@ -1061,15 +1179,16 @@ void GPU_HW::DispatchRenderCommand()
     if (m_draw_mode.IsTexturePageChanged())
     {
       m_draw_mode.ClearTexturePageChangedFlag();
-      if (m_vram_dirty_rect.Valid() && (m_draw_mode.mode_reg.GetTexturePageRectangle().Intersects(m_vram_dirty_rect) ||
-                                        (m_draw_mode.mode_reg.IsUsingPalette() &&
-                                         m_draw_mode.GetTexturePaletteRectangle().Intersects(m_vram_dirty_rect))))
+      u32 dirty_page_mask = GetVRAMDirtyPageMask(m_draw_mode.mode_reg.GetTexturePageRectangle());
+      if (m_draw_mode.mode_reg.IsUsingPalette())
+        dirty_page_mask |= GetVRAMDirtyPageMask(m_draw_mode.GetTexturePaletteRectangle());
+      if (dirty_page_mask != 0)
       {
         // Log_DevPrintf("Invalidating VRAM read cache due to drawing area overlap");
         if (!IsFlushed())
-          FlushRender();
+          FlushRender(BatchFlushReason::VRAMReadDependency);
 
-        UpdateVRAMReadTexture();
+        UpdateVRAMReadTexture(dirty_page_mask);
       }
     }
 
@@ -1089,21 +1208,34 @@ void GPU_HW::DispatchRenderCommand()
   const GPUTransparencyMode transparency_mode =
     rc.transparency_enable ? m_draw_mode.mode_reg.transparency_mode : GPUTransparencyMode::Disabled;
   const bool dithering_enable = (!m_true_color && rc.IsDitheringEnabled()) ? m_GPUSTAT.dither_enable : false;
+  bool defer_primitive = false;
   if (texture_mode != m_batch.texture_mode || transparency_mode != m_batch.transparency_mode ||
-      transparency_mode == GPUTransparencyMode::BackgroundMinusForeground || dithering_enable != m_batch.dithering)
+      dithering_enable != m_batch.dithering)
+  {
+    defer_primitive = CanDeferPrimitive(texture_mode, transparency_mode, dithering_enable);
+    if (!defer_primitive)
+    {
+      FlushRender((texture_mode != m_batch.texture_mode) ?
+                    BatchFlushReason::TextureModeChanged :
+                    ((transparency_mode != m_batch.transparency_mode) ? BatchFlushReason::TransparencyModeChanged :
+                                                                        BatchFlushReason::DitheringChanged));
+    }
+  }
+  else if (transparency_mode == GPUTransparencyMode::BackgroundMinusForeground)
   {
-    FlushRender();
+    FlushRender(BatchFlushReason::SubtractiveBlending);
   }
 
   EnsureVertexBufferSpaceForCurrentCommand();
 
+  // the current batch may have been flushed to make space, in which case there's nothing to reorder around
+  defer_primitive &= !IsFlushed();
+
   // transparency mode change
-  if (m_batch.transparency_mode != transparency_mode && transparency_mode != GPUTransparencyMode::Disabled)
+  if (!defer_primitive && m_batch.transparency_mode != transparency_mode &&
+      transparency_mode != GPUTransparencyMode::Disabled)
   {
-    static constexpr float transparent_alpha[4][2] = {{0.5f, 0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f}, {0.25f, 1.0f}};
-    m_batch_ubo_data.u_src_alpha_factor = transparent_alpha[static_cast<u32>(transparency_mode)][0];
-    m_batch_ubo_data.u_dst_alpha_factor = transparent_alpha[static_cast<u32>(transparency_mode)][1];
-    m_batch_ubo_dirty = true;
+    SetBatchTransparencyUniforms(transparency_mode);
   }
 
   if (m_batch.check_mask_before_draw != m_GPUSTAT.check_mask_before_draw ||
@@ -1124,9 +1256,12 @@ void GPU_HW::DispatchRenderCommand()
   }
 
   // update state
-  m_batch.texture_mode = texture_mode;
-  m_batch.transparency_mode = transparency_mode;
-  m_batch.dithering = dithering_enable;
+  if (!defer_primitive)
+  {
+    m_batch.texture_mode = texture_mode;
+    m_batch.transparency_mode = transparency_mode;
+    m_batch.dithering = dithering_enable;
+  }
 
   if (m_draw_mode.IsTextureWindowChanged())
   {
@@ -1139,10 +1274,117 @@ void GPU_HW::DispatchRenderCommand()
     m_batch_ubo_dirty = true;
   }
 
+  if (defer_primitive)
+    LoadDeferredPrimitive(texture_mode, transparency_mode, dithering_enable);
+  else if (!m_deferred_batch_vertices.empty())
+    LoadPrimitiveAheadOfDeferredBatch();
+  else
+    LoadVertices();
+}
+
+bool GPU_HW::CanDeferPrimitive(GPUTextureMode texture_mode, GPUTransparencyMode transparency_mode,
+                               bool dithering) const
+{
+  // Subtractive blending always breaks the batch, and the PGXP depth buffer paths can flush in the middle of loading
+  // a primitive. Reordering is pointless if there's nothing in the current batch to merge with.
+  if (!g_settings.gpu_reorder_batches || m_pgxp_depth_buffer || IsFlushed() ||
+      transparency_mode == GPUTransparencyMode::BackgroundMinusForeground)
+  {
+    return false;
+  }
+
+  if (m_deferred_batch_vertices.empty())
+    return true;
+
+  return (m_deferred_batch.texture_mode == texture_mode && m_deferred_batch.transparency_mode == transparency_mode &&
+          m_deferred_batch.dithering == dithering &&
+          (m_deferred_batch_vertices.size() + GetRequiredVerticesForCurrentCommand()) <=
+            MAX_DEFERRED_BATCH_VERTEX_COUNT);
+}
+
+void GPU_HW::LoadDeferredPrimitive(GPUTextureMode texture_mode, GPUTransparencyMode transparency_mode, bool dithering)
+{
+  // Load into the vertex buffer as normal, then move it out to the deferred batch. Since the deferred batch is always
+  // drawn after the current batch, the primitive stays in order relative to everything drawn before it.
+  BatchVertex* const start_ptr = m_batch_current_vertex_ptr;
+  LoadVertices();
+  if (m_batch_current_vertex_ptr == start_ptr)
+    return;
+
+  if (m_deferred_batch_vertices.empty())
+  {
+    m_deferred_batch = m_batch;
+    m_deferred_batch.texture_mode = texture_mode;
+    m_deferred_batch.transparency_mode = transparency_mode;
+    m_deferred_batch.dithering = dithering;
+    m_deferred_batch_bounds.SetInvalid();
+  }
+
+  m_deferred_batch_vertices.insert(m_deferred_batch_vertices.end(), start_ptr, m_batch_current_vertex_ptr);
+  m_deferred_batch_bounds.Include(m_primitive_bounds);
+  m_batch_current_vertex_ptr = start_ptr;
+}
+
+void GPU_HW::LoadPrimitiveAheadOfDeferredBatch()
+{
+  BatchVertex* const start_ptr = m_batch_current_vertex_ptr;
   LoadVertices();
+  if (m_batch_current_vertex_ptr == start_ptr)
+    return;
+
+  if (!m_primitive_bounds.Intersects(m_deferred_batch_bounds))
+  {
+    m_renderer_stats.num_reordered_primitives++;
+    return;
+  }
+
+  // The primitive overlaps something in the deferred batch, so it has to be drawn after it. Pull it back out of the
+  // current batch, draw both batches, then start a new batch with it.
+  const u32 num_vertices = static_cast<u32>(m_batch_current_vertex_ptr - start_ptr);
+  m_reorder_scratch_vertices.assign(start_ptr, m_batch_current_vertex_ptr);
+  m_batch_current_vertex_ptr = start_ptr;
+
+  const BatchConfig batch = m_batch;
+  FlushRender(BatchFlushReason::ReorderOverlap);
+  SetBatchConfig(batch);
+
+  EnsureVertexBufferSpace(num_vertices);
+  std::memcpy(m_batch_current_vertex_ptr, m_reorder_scratch_vertices.data(), sizeof(BatchVertex) * num_vertices);
+  m_batch_current_vertex_ptr += num_vertices;
+}
+
+void GPU_HW::SetBatchTransparencyUniforms(GPUTransparencyMode transparency_mode)
+{
+  static constexpr float transparent_alpha[4][2] = {{0.5f, 0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f}, {0.25f, 1.0f}};
+  m_batch_ubo_data.u_src_alpha_factor = transparent_alpha[static_cast<u32>(transparency_mode)][0];
+  m_batch_ubo_data.u_dst_alpha_factor = transparent_alpha[static_cast<u32>(transparency_mode)][1];
+  m_batch_ubo_dirty = true;
+}
+
+void GPU_HW::SetBatchConfig(const BatchConfig& config)
+{
+  if (m_batch.transparency_mode != config.transparency_mode &&
+      config.transparency_mode != GPUTransparencyMode::Disabled)
+  {
+    SetBatchTransparencyUniforms(config.transparency_mode);
+  }
+
+  m_batch = config;
 }
 
 void GPU_HW::FlushRender()
+{
+  FlushRender(BatchFlushReason::GPUCommand);
+}
+
+void GPU_HW::FlushRender(BatchFlushReason reason)
+{
+  DrawCurrentBatch(reason);
+  if (!m_deferred_batch_vertices.empty())
+    DrawDeferredBatch(reason);
+}
+
+void GPU_HW::DrawCurrentBatch(BatchFlushReason reason)
 {
   if (!m_batch_current_vertex_ptr)
     return;
@@ -1168,6 +1410,8 @@ void GPU_HW::FlushRender()
     m_batch_ubo_dirty = false;
   }
 
+  m_renderer_stats.num_batch_flushes[static_cast<size_t>(reason)]++;
+  m_renderer_stats.num_batch_vertices += vertex_count;
   if (NeedsTwoPassRendering())
   {
     m_renderer_stats.num_batches += 2;
@@ -1181,6 +1425,26 @@ void GPU_HW::FlushRender()
   }
 }
 
+void GPU_HW::DrawDeferredBatch(BatchFlushReason reason)
+{
+  const u32 num_vertices = static_cast<u32>(m_deferred_batch_vertices.size());
+  MapBatchVertexPointer(num_vertices);
+  std::memcpy(m_batch_current_vertex_ptr, m_deferred_batch_vertices.data(), sizeof(BatchVertex) * num_vertices);
+  m_batch_current_vertex_ptr += num_vertices;
+  m_deferred_batch_vertices.clear();
+
+  SetBatchConfig(m_deferred_batch);
+  DrawCurrentBatch(reason);
+}
+
+const char* GPU_HW::GetBatchFlushReasonName(BatchFlushReason reason)
+{
+  static constexpr std::array<const char*, static_cast<size_t>(BatchFlushReason::Count)> names = {
+    {"GPU Command", "Texture Mode", "Transparency Mode", "Dithering", "Subtractive Blending", "VRAM Read Dependency",
+     "Vertex Buffer Full", "Depth Counter Exhausted", "Depth Buffer Toggle", "Depth Clear", "Reorder Overlap"}};
+  return names[static_cast<size_t>(reason)];
+}
+
 void GPU_HW::DrawRendererStats(bool is_idle_frame)
 {
   if (!is_idle_frame)
@@ -1246,6 +1510,19 @@ void GPU_HW::DrawRendererStats(bool is_idle_frame)
     ImGui::Text("%u", stats.num_batches);
     ImGui::NextColumn();
 
+    ImGui::TextUnformatted("Vertices Per Batch:");
+    ImGui::NextColumn();
+    ImGui::Text("%.1f", (stats.num_batches > 0) ?
+                          (static_cast<float>(stats.num_batch_vertices) / static_cast<float>(stats.num_batches)) :
+                          0.0f);
+    ImGui::NextColumn();
+
+    ImGui::TextUnformatted("Batch Reordering:");
+    ImGui::NextColumn();
+    ImGui::TextColored(g_settings.gpu_reorder_batches ? active_color : inactive_color, "%u primitives reordered",
+                       stats.num_reordered_primitives);
+    ImGui::NextColumn();
+
     ImGui::TextUnformatted("VRAM Read Texture Updates:");
     ImGui::NextColumn();
     ImGui::Text("%u", stats.num_vram_read_texture_updates);
@@ -1257,6 +1534,27 @@ void GPU_HW::DrawRendererStats(bool is_idle_frame)
     ImGui::NextColumn();
 
     ImGui::Columns(1);
+
+    // why each batch was flushed, so the biggest sources of draw calls stand out
+    if (ImGui::TreeNodeEx("Batch Breaks", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+      ImGui::Columns(2);
+      ImGui::SetColumnWidth(0, 200.0f * ImGui::GetIO().DisplayFramebufferScale.x);
+
+      for (size_t i = 0; i < stats.num_batch_flushes.size(); i++)
+      {
+        if (stats.num_batch_flushes[i] == 0)
+          continue;
+
+        ImGui::Text("%s:", GetBatchFlushReasonName(static_cast<BatchFlushReason>(i)));
+        ImGui::NextColumn();
+        ImGui::Text("%u", stats.num_batch_flushes[i]);
+        ImGui::NextColumn();
+      }
+
+      ImGui::Columns(1);
+      ImGui::TreePop();
+    }
   }
 #endif
 }
@@ -2,6 +2,7 @@
 #include "common/heap_array.h"
 #include "gpu.h"
 #include "host_display.h"
+#include <array>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -46,8 +47,16 @@ protected:
     UNIFORM_BUFFER_SIZE = 512 * 1024,
     MAX_BATCH_VERTEX_COUNTER_IDS = 65536 - 2,
     MAX_VERTICES_FOR_RECTANGLE = 6 * (((MAX_PRIMITIVE_WIDTH + (TEXTURE_PAGE_WIDTH - 1)) / TEXTURE_PAGE_WIDTH) + 1u) *
-                                 (((MAX_PRIMITIVE_HEIGHT + (TEXTURE_PAGE_HEIGHT - 1)) / TEXTURE_PAGE_HEIGHT) + 1u)
+                                 (((MAX_PRIMITIVE_HEIGHT + (TEXTURE_PAGE_HEIGHT - 1)) / TEXTURE_PAGE_HEIGHT) + 1u),
+
+    // Granularity of VRAM read texture invalidation. 64 pixels is the width of a 4-bit texture page.
+    VRAM_DIRTY_PAGE_WIDTH = TEXTURE_PAGE_WIDTH / 4,
+    VRAM_DIRTY_PAGE_HEIGHT = TEXTURE_PAGE_HEIGHT,
+    VRAM_DIRTY_PAGES_X = VRAM_WIDTH / VRAM_DIRTY_PAGE_WIDTH,
+    VRAM_DIRTY_PAGES_Y = VRAM_HEIGHT / VRAM_DIRTY_PAGE_HEIGHT,
+    NUM_VRAM_DIRTY_PAGES = VRAM_DIRTY_PAGES_X * VRAM_DIRTY_PAGES_Y
   };
+  static_assert(NUM_VRAM_DIRTY_PAGES <= 32, "dirty page mask fits in 32 bits");
 
   struct BatchVertex
   {
@@ -153,11 +162,30 @@ protected:
     float u_depth_value;
   };
 
+  enum class BatchFlushReason : u8
+  {
+    GPUCommand, // drawing area/offset, texture window, mask bit, VRAM transfers, end of frame
+    TextureModeChanged,
+    TransparencyModeChanged,
+    DitheringChanged,
+    SubtractiveBlending,
+    VRAMReadDependency,
+    VertexBufferFull,
+    DepthCounterExhausted,
+    DepthBufferChanged,
+    DepthClear,
+    ReorderOverlap,
+    Count
+  };
+
   struct RendererStats
   {
     u32 num_batches;
+    u32 num_batch_vertices;
+    u32 num_reordered_primitives;
     u32 num_vram_read_texture_updates;
     u32 num_uniform_buffer_updates;
+    std::array<u32, static_cast<size_t>(BatchFlushReason::Count)> num_batch_flushes;
   };
 
   static constexpr std::tuple<float, float, float, float> RGBA8ToFloat(u32 rgba)
@@ -170,7 +198,7 @@ protected:
 
   void UpdateHWSettings(bool* framebuffer_changed, bool* shaders_changed);
 
-  virtual void UpdateVRAMReadTexture();
+  virtual void CopyVRAMToReadTexture(const Common::Rectangle<u32>* rects, u32 num_rects) = 0;
   virtual void UpdateDepthBufferFromMaskBit() = 0;
   virtual void ClearDepthBuffer() = 0;
   virtual void SetScissorFromDrawingArea() = 0;
@@ -188,13 +216,21 @@ protected:
     return (m_downsample_mode != GPUDownsampleMode::Disabled && !m_GPUSTAT.display_area_color_depth_24);
   }
 
-  void SetFullVRAMDirtyRectangle()
-  {
-    m_vram_dirty_rect.Set(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
-    m_draw_mode.SetTexturePageChanged();
-  }
-  void ClearVRAMDirtyRectangle() { m_vram_dirty_rect.SetInvalid(); }
+  void SetFullVRAMDirtyRectangle();
+  void ClearVRAMDirtyRectangle();
   void IncludeVRAMDirtyRectangle(const Common::Rectangle<u32>& rect);
+  void IncludeVRAMDirtyPages(const Common::Rectangle<u32>& rect);
+
+  /// Returns the mask of dirty pages which overlap the specified area. The area can wrap around horizontally.
+  u32 GetVRAMDirtyPageMask(const Common::Rectangle<u32>& area) const;
+  bool IsVRAMDirty(const Common::Rectangle<u32>& area) const { return GetVRAMDirtyPageMask(area) != 0; }
+
+  /// Copies the dirty parts of the specified pages to the VRAM read texture.
+  void UpdateVRAMReadTexture(u32 page_mask);
+  void UpdateVRAMReadTexture(const Common::Rectangle<u32>& area) { UpdateVRAMReadTexture(GetVRAMDirtyPageMask(area)); }
+  void UpdateVRAMReadTexture() { UpdateVRAMReadTexture(m_vram_dirty_page_mask); }
+
+  static const char* GetBatchFlushReasonName(BatchFlushReason reason);
 
   bool IsFlushed() const { return m_batch_current_vertex_ptr == m_batch_start_vertex_ptr; }
 
@@ -202,6 +238,7 @@ protected:
   u32 GetBatchVertexCount() const { return static_cast<u32>(m_batch_current_vertex_ptr - m_batch_start_vertex_ptr); }
   void EnsureVertexBufferSpace(u32 required_vertices);
   void EnsureVertexBufferSpaceForCurrentCommand();
+  u32 GetRequiredVerticesForCurrentCommand() const;
   void ResetBatchVertexDepth();
 
   /// Returns the value to be written to the depth buffer for the current operation for mask bit emulation.
@@ -260,6 +297,7 @@ protected:
   void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height) override;
   void DispatchRenderCommand() override;
   void FlushRender() override;
+  void FlushRender(BatchFlushReason reason);
   void DrawRendererStats(bool is_idle_frame) override;
 
   void CalcScissorRect(int* left, int* top, int* right, int* bottom);
@@ -344,8 +382,20 @@ protected:
   BatchConfig m_batch = {};
   BatchUBOData m_batch_ubo_data = {};
 
-  // Bounding box of VRAM area that the GPU has drawn into.
-  Common::Rectangle<u32> m_vram_dirty_rect;
+  // Batch which was deferred so that later primitives with the current state can be merged into the current batch.
+  // Only used with batch reordering, always drawn after the current batch.
+  BatchConfig m_deferred_batch = {};
+  Common::Rectangle<u32> m_deferred_batch_bounds;
+  std::vector<BatchVertex> m_deferred_batch_vertices;
+  std::vector<BatchVertex> m_reorder_scratch_vertices;
+
+  // Area drawn by the last primitive loaded.
+  Common::Rectangle<u32> m_primitive_bounds;
+
+  // Bounding box of the VRAM area that the GPU has drawn into, per page. Only pages which are sampled from are copied
+  // to the read texture, so drawing to one page doesn't force the whole framebuffer to be copied.
+  std::array<Common::Rectangle<u32>, NUM_VRAM_DIRTY_PAGES> m_vram_dirty_pages;
+  u32 m_vram_dirty_page_mask = 0;
 
   // Statistics
   RendererStats m_renderer_stats = {};
@@ -358,10 +408,26 @@ private:
   enum : u32
   {
     MIN_BATCH_VERTEX_COUNT = 6,
-    MAX_BATCH_VERTEX_COUNT = VERTEX_BUFFER_SIZE / sizeof(BatchVertex)
+    MAX_BATCH_VERTEX_COUNT = VERTEX_BUFFER_SIZE / sizeof(BatchVertex),
+    MAX_DEFERRED_BATCH_VERTEX_COUNT = MAX_BATCH_VERTEX_COUNT / 4
   };
 
   void LoadVertices();
+  void LoadDeferredPrimitive(GPUTextureMode texture_mode, GPUTransparencyMode transparency_mode, bool dithering);
+  void LoadPrimitiveAheadOfDeferredBatch();
+  bool CanDeferPrimitive(GPUTextureMode texture_mode, GPUTransparencyMode transparency_mode, bool dithering) const;
+
+  void SetBatchConfig(const BatchConfig& config);
+  void SetBatchTransparencyUniforms(GPUTransparencyMode transparency_mode);
+  void DrawCurrentBatch(BatchFlushReason reason);
+  void DrawDeferredBatch(BatchFlushReason reason);
+
+  ALWAYS_INLINE void IncludePrimitiveBounds(u32 left, u32 top, u32 right, u32 bottom)
+  {
+    const Common::Rectangle<u32> rect(left, top, right, bottom);
+    IncludeVRAMDirtyPages(rect);
+    m_primitive_bounds.Include(rect);
+  }
 
   ALWAYS_INLINE void AddVertex(const BatchVertex& v)
   {
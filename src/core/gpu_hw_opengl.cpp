@@ -1168,12 +1168,10 @@ void GPU_HW_OpenGL::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wid
 {
   const Common::Rectangle<u32> dst_bounds = GetVRAMTransferBounds(dst_x, dst_y, width, height);
   const Common::Rectangle<u32> src_bounds = GetVRAMTransferBounds(src_x, src_y, width, height);
-  const bool src_dirty = m_vram_dirty_rect.Intersects(src_bounds);
 
   if (UseVRAMCopyShader(src_x, src_y, dst_x, dst_y, width, height))
   {
-    if (src_dirty)
-      UpdateVRAMReadTexture();
+    UpdateVRAMReadTexture(src_bounds);
     IncludeVRAMDirtyRectangle(dst_bounds);
 
     VRAMCopyUBOData uniforms = GetVRAMCopyUBOData(src_x, src_y, dst_x, dst_y, width, height);
@@ -1233,8 +1231,7 @@ void GPU_HW_OpenGL::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wid
   {
     // glBlitFramebufer with same source/destination should be legal, but on Mali (at least Bifrost) it breaks.
     // So, blit from the shadow texture, like in the other renderers.
-    if (src_dirty)
-      UpdateVRAMReadTexture();
+    UpdateVRAMReadTexture(src_bounds);
 
     glDisable(GL_SCISSOR_TEST);
     m_vram_read_texture.BindFramebuffer(GL_READ_FRAMEBUFFER);
@@ -1246,41 +1243,51 @@ void GPU_HW_OpenGL::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wid
   IncludeVRAMDirtyRectangle(dst_bounds);
 }
 
-void GPU_HW_OpenGL::UpdateVRAMReadTexture()
+void GPU_HW_OpenGL::CopyVRAMToReadTexture(const Common::Rectangle<u32>* rects, u32 num_rects)
 {
-  const auto scaled_rect = m_vram_dirty_rect * m_resolution_scale;
-  const u32 width = scaled_rect.GetWidth();
-  const u32 height = scaled_rect.GetHeight();
-  const u32 x = scaled_rect.left;
-  const u32 y = m_vram_texture.GetHeight() - scaled_rect.top - height;
   const bool multisampled = m_vram_texture.IsMultisampled();
-
-  if (!multisampled && GLAD_GL_VERSION_4_3)
+  const bool use_blit = multisampled || (!GLAD_GL_VERSION_4_3 && !GLAD_GL_EXT_copy_image && !GLAD_GL_OES_copy_image);
+  if (use_blit)
   {
-    glCopyImageSubData(m_vram_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0,
-                       m_vram_read_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0, width, height, 1);
-  }
-  else if (!multisampled && GLAD_GL_EXT_copy_image)
-  {
-    glCopyImageSubDataEXT(m_vram_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0,
-                          m_vram_read_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0, width, height, 1);
+    m_vram_read_texture.BindFramebuffer(GL_DRAW_FRAMEBUFFER);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_vram_fbo_id);
+    glDisable(GL_SCISSOR_TEST);
   }
-  else if (!multisampled && GLAD_GL_OES_copy_image)
+
+  for (u32 i = 0; i < num_rects; i++)
   {
-    glCopyImageSubDataOES(m_vram_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0,
-                          m_vram_read_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0, width, height, 1);
+    const auto scaled_rect = rects[i] * m_resolution_scale;
+    const u32 width = scaled_rect.GetWidth();
+    const u32 height = scaled_rect.GetHeight();
+    const u32 x = scaled_rect.left;
+    const u32 y = m_vram_texture.GetHeight() - scaled_rect.top - height;
+
+    if (use_blit)
+    {
+      glBlitFramebuffer(x, y, x + width, y + height, x, y, x + width, y + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+    else if (GLAD_GL_VERSION_4_3)
+    {
+      glCopyImageSubData(m_vram_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0,
+                         m_vram_read_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0, width, height, 1);
+    }
+    else if (GLAD_GL_EXT_copy_image)
+    {
+      glCopyImageSubDataEXT(m_vram_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0,
+                            m_vram_read_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0, width, height, 1);
+    }
+    else
+    {
+      glCopyImageSubDataOES(m_vram_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0,
+                            m_vram_read_texture.GetGLId(), m_vram_texture.GetGLTarget(), 0, x, y, 0, width, height, 1);
+    }
   }
-  else
+
+  if (use_blit)
   {
-    m_vram_read_texture.BindFramebuffer(GL_DRAW_FRAMEBUFFER);
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_vram_fbo_id);
-    glDisable(GL_SCISSOR_TEST);
-    glBlitFramebuffer(x, y, x + width, y + height, x, y, x + width, y + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
     glEnable(GL_SCISSOR_TEST);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_vram_fbo_id);
   }
-
-  GPU_HW::UpdateVRAMReadTexture();
 }
 
 void GPU_HW_OpenGL::UpdateDepthBufferFromMaskBit()
@@ -1310,9 +1310,9 @@ void GPU_HW_Vulkan::UpdateDisplay()
   {
     if (IsUsingMultisampling())
     {
-      if (m_vram_dirty_rect.Intersects(
-            Common::Rectangle<u32>::FromExtents(m_crtc_state.display_vram_left, m_crtc_state.display_vram_top,
-                                                m_crtc_state.display_vram_width, m_crtc_state.display_vram_height)))
+      if (IsVRAMDirty(Common::Rectangle<u32>::FromExtents(m_crtc_state.display_vram_left, m_crtc_state.display_vram_top,
+                                                          m_crtc_state.display_vram_width,
+                                                          m_crtc_state.display_vram_height)))
       {
         UpdateVRAMReadTexture();
       }
@@ -1555,8 +1555,7 @@ void GPU_HW_Vulkan::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wid
   {
     const Common::Rectangle<u32> src_bounds = GetVRAMTransferBounds(src_x, src_y, width, height);
     const Common::Rectangle<u32> dst_bounds = GetVRAMTransferBounds(dst_x, dst_y, width, height);
-    if (m_vram_dirty_rect.Intersects(src_bounds))
-      UpdateVRAMReadTexture();
+    UpdateVRAMReadTexture(src_bounds);
     IncludeVRAMDirtyRectangle(dst_bounds);
 
     const VRAMCopyUBOData uniforms(GetVRAMCopyUBOData(src_x, src_y, dst_x, dst_y, width, height));
@@ -1608,7 +1607,7 @@ void GPU_HW_Vulkan::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wid
   m_vram_texture.TransitionToLayout(cmdbuf, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 }
 
-void GPU_HW_Vulkan::UpdateVRAMReadTexture()
+void GPU_HW_Vulkan::CopyVRAMToReadTexture(const Common::Rectangle<u32>* rects, u32 num_rects)
 {
   EndRenderPass();
 
@@ -1616,34 +1615,41 @@ void GPU_HW_Vulkan::UpdateVRAMReadTexture()
   m_vram_texture.TransitionToLayout(cmdbuf, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
   m_vram_read_texture.TransitionToLayout(cmdbuf, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
-  const auto scaled_rect = m_vram_dirty_rect * m_resolution_scale;
-
   if (m_vram_texture.GetSamples() > VK_SAMPLE_COUNT_1_BIT)
   {
-    const VkImageResolve resolve{{VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
-                                 {static_cast<s32>(scaled_rect.left), static_cast<s32>(scaled_rect.top), 0},
-                                 {VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
-                                 {static_cast<s32>(scaled_rect.left), static_cast<s32>(scaled_rect.top), 0},
-                                 {scaled_rect.GetWidth(), scaled_rect.GetHeight(), 1u}};
+    std::array<VkImageResolve, NUM_VRAM_DIRTY_PAGES> resolves;
+    for (u32 i = 0; i < num_rects; i++)
+    {
+      const auto scaled_rect = rects[i] * m_resolution_scale;
+      resolves[i] = {{VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
+                     {static_cast<s32>(scaled_rect.left), static_cast<s32>(scaled_rect.top), 0},
+                     {VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
+                     {static_cast<s32>(scaled_rect.left), static_cast<s32>(scaled_rect.top), 0},
+                     {scaled_rect.GetWidth(), scaled_rect.GetHeight(), 1u}};
+    }
+
     vkCmdResolveImage(cmdbuf, m_vram_texture.GetImage(), m_vram_texture.GetLayout(), m_vram_read_texture.GetImage(),
-                      m_vram_read_texture.GetLayout(), 1, &resolve);
+                      m_vram_read_texture.GetLayout(), num_rects, resolves.data());
   }
   else
   {
-    const VkImageCopy copy{{VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
-                           {static_cast<s32>(scaled_rect.left), static_cast<s32>(scaled_rect.top), 0},
-                           {VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
-                           {static_cast<s32>(scaled_rect.left), static_cast<s32>(scaled_rect.top), 0},
-                           {scaled_rect.GetWidth(), scaled_rect.GetHeight(), 1u}};
+    std::array<VkImageCopy, NUM_VRAM_DIRTY_PAGES> copies;
+    for (u32 i = 0; i < num_rects; i++)
+    {
+      const auto scaled_rect = rects[i] * m_resolution_scale;
+      copies[i] = {{VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
+                   {static_cast<s32>(scaled_rect.left), static_cast<s32>(scaled_rect.top), 0},
+                   {VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
+                   {static_cast<s32>(scaled_rect.left), static_cast<s32>(scaled_rect.top), 0},
+                   {scaled_rect.GetWidth(), scaled_rect.GetHeight(), 1u}};
+    }
 
     vkCmdCopyImage(cmdbuf, m_vram_texture.GetImage(), m_vram_texture.GetLayout(), m_vram_read_texture.GetImage(),
-                   m_vram_read_texture.GetLayout(), 1u, &copy);
+                   m_vram_read_texture.GetLayout(), num_rects, copies.data());
   }
 
   m_vram_read_texture.TransitionToLayout(cmdbuf, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
   m_vram_texture.TransitionToLayout(cmdbuf, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-
-  GPU_HW::UpdateVRAMReadTexture();
 }
 
 void GPU_HW_Vulkan::UpdateDepthBufferFromMaskBit()
@@ -1,10 +1,13 @@
-#include "gpu_sw_backend.h"
 #include "common/assert.h"
 #include "common/log.h"
 #include "gpu_sw_backend.h"
+#include "gpu_sw_kernels.h"
 #include "host_display.h"
+#include "settings.h"
 #include "system.h"
 #include <algorithm>
+#include <cstring>
+#include <limits>
 Log_SetChannel(GPU_SW_Backend);
 
 GPU_SW_Backend::GPU_SW_Backend() : GPUBackend()
@@ -13,11 +16,29 @@ GPU_SW_Backend::GPU_SW_Backend() : GPUBackend()
   m_vram_ptr = m_vram.data();
 }
 
-GPU_SW_Backend::~GPU_SW_Backend() = default;
+GPU_SW_Backend::~GPU_SW_Backend()
+{
+  StopRenderThreads();
+}
 
 bool GPU_SW_Backend::Initialize()
 {
-  return GPUBackend::Initialize();
+  if (!GPUBackend::Initialize())
+    return false;
+
+  StartRenderThreads(g_settings.gpu_sw_render_threads);
+  return true;
+}
+
+void GPU_SW_Backend::UpdateSettings()
+{
+  GPUBackend::UpdateSettings();
+
+  if (GetRenderThreadCount() != std::max(g_settings.gpu_sw_render_threads, 1u))
+  {
+    StopRenderThreads();
+    StartRenderThreads(g_settings.gpu_sw_render_threads);
+  }
 }
 
 void GPU_SW_Backend::Reset(bool clear_vram)
@@ -28,7 +49,37 @@ void GPU_SW_Backend::Reset(bool clear_vram)
     m_vram.fill(0);
 }
 
+void GPU_SW_Backend::Shutdown()
+{
+  GPUBackend::Shutdown();
+  StopRenderThreads();
+}
+
 void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
+{
+  if (!m_render_threads.empty())
+    QueueDrawCommand(cmd);
+  else
+    DrawPolygon(cmd, m_drawing_area);
+}
+
+void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+{
+  if (!m_render_threads.empty())
+    QueueDrawCommand(cmd);
+  else
+    DrawRectangle(cmd, m_drawing_area);
+}
+
+void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd)
+{
+  if (!m_render_threads.empty())
+    QueueDrawCommand(cmd);
+  else
+    DrawLine(cmd, m_drawing_area);
+}
+
+void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const GPURenderCommand rc{cmd->rc.bits};
   const bool dithering_enable = rc.IsDitheringEnabled() && cmd->draw_mode.dither_enable;
@@ -36,28 +87,28 @@ void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
   const DrawTriangleFunction DrawFunction = GetDrawTriangleFunction(
     rc.shading_enable, rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable, dithering_enable);
 
-  (this->*DrawFunction)(cmd, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
+  (this->*DrawFunction)(cmd, clip, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
   if (rc.quad_polygon)
-    (this->*DrawFunction)(cmd, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
+    (this->*DrawFunction)(cmd, clip, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
 }
 
-void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const GPURenderCommand rc{cmd->rc.bits};
 
   const DrawRectangleFunction DrawFunction =
     GetDrawRectangleFunction(rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable);
 
-  (this->*DrawFunction)(cmd);
+  (this->*DrawFunction)(cmd, clip);
 }
 
-void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd)
+void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const DrawLineFunction DrawFunction =
     GetDrawLineFunction(cmd->rc.shading_enable, cmd->rc.transparency_enable, cmd->IsDitheringEnabled());
 
   for (u16 i = 1; i < cmd->num_vertices; i++)
-    (this->*DrawFunction)(cmd, &cmd->vertices[i - 1], &cmd->vertices[i]);
+    (this->*DrawFunction)(cmd, clip, &cmd->vertices[i - 1], &cmd->vertices[i]);
 }
 
 constexpr GPU_SW_Backend::DitherLUT GPU_SW_Backend::ComputeDitherLUT()
@@ -79,6 +130,43 @@ constexpr GPU_SW_Backend::DitherLUT GPU_SW_Backend::ComputeDitherLUT()
 
 static constexpr GPU_SW_Backend::DitherLUT s_dither_lut = GPU_SW_Backend::ComputeDitherLUT();
 
+u16 ALWAYS_INLINE_RELEASE GPU_SW_Backend::SampleTexture(const GPUBackendDrawCommand* cmd, u8 texcoord_x,
+                                                       u8 texcoord_y) const
+{
+  // Apply texture window
+  // TODO: Precompute the second half
+  texcoord_x = (texcoord_x & cmd->window.and_x) | cmd->window.or_x;
+  texcoord_y = (texcoord_y & cmd->window.and_y) | cmd->window.or_y;
+
+  switch (cmd->draw_mode.texture_mode)
+  {
+    case GPUTextureMode::Palette4Bit:
+    {
+      const u16 palette_value =
+        GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
+                 (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+      const u16 palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
+
+      return GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
+    }
+
+    case GPUTextureMode::Palette8Bit:
+    {
+      const u16 palette_value =
+        GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
+                 (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+      const u16 palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
+      return GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
+    }
+
+    default:
+    {
+      return GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x)) % VRAM_WIDTH,
+                      (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+    }
+  }
+}
+
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
 void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r,
                                                       u8 color_g, u8 color_b, u8 texcoord_x, u8 texcoord_y)
@@ -87,44 +175,8 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
   bool transparent;
   if constexpr (texture_enable)
   {
-    // Apply texture window
-    // TODO: Precompute the second half
-    texcoord_x = (texcoord_x & cmd->window.and_x) | cmd->window.or_x;
-    texcoord_y = (texcoord_y & cmd->window.and_y) | cmd->window.or_y;
-
     VRAMPixel texture_color;
-    switch (cmd->draw_mode.texture_mode)
-    {
-      case GPUTextureMode::Palette4Bit:
-      {
-        const u16 palette_value =
-          GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
-                   (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-        const u16 palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
-
-        texture_color.bits =
-          GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
-      }
-      break;
-
-      case GPUTextureMode::Palette8Bit:
-      {
-        const u16 palette_value =
-          GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
-                   (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-        const u16 palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
-        texture_color.bits =
-          GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
-      }
-      break;
-
-      default:
-      {
-        texture_color.bits = GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x)) % VRAM_WIDTH,
-                                      (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-      }
-      break;
-    }
+    texture_color.bits = SampleTexture(cmd, texcoord_x, texcoord_y);
 
     if (texture_color.bits == 0)
       return;
@@ -211,7 +263,7 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
 }
 
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
-void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const s32 origin_x = cmd->x;
   const s32 origin_y = cmd->y;
@@ -221,7 +273,7 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
   for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
-    if (y < static_cast<s32>(m_drawing_area.top) || y > static_cast<s32>(m_drawing_area.bottom) ||
+    if (y < static_cast<s32>(clip.top) || y > static_cast<s32>(clip.bottom) ||
         (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u)))
     {
       continue;
@@ -232,7 +284,7 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
     for (u32 offset_x = 0; offset_x < cmd->width; offset_x++)
     {
       const s32 x = origin_x + static_cast<s32>(offset_x);
-      if (x < static_cast<s32>(m_drawing_area.left) || x > static_cast<s32>(m_drawing_area.right))
+      if (x < static_cast<s32>(clip.left) || x > static_cast<s32>(clip.right))
         continue;
 
       const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + offset_x);
@@ -349,10 +401,88 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::AddIDeltas_DY(i_group& ig, const i_de
   }
 }
 
+static_assert(GPUSWKernels::INTERPOLATION_FRACTION_BITS == (COORD_FBS + COORD_POST_PADDING));
+
+void GPU_SW_Backend::SampleTextureSpan(const GPUBackendDrawCommand* cmd, u32 u, u32 du, u32 v, u32 dv,
+                                       u16* texels) const
+{
+  // Same as SampleTexture(), with the texture mode and window checked once for the whole span.
+  const u32 page_x = cmd->draw_mode.GetTexturePageBaseX();
+  const u32 page_y = cmd->draw_mode.GetTexturePageBaseY();
+  const u32 palette_x = cmd->palette.GetXBase();
+  const u32 palette_y = cmd->palette.GetYBase();
+  const GPUTextureWindow window = cmd->window;
+
+  const auto get_texcoords = [&window, &u, &v, du, dv](u8* texcoord_x, u8* texcoord_y) {
+    *texcoord_x = (Truncate8(u >> (COORD_FBS + COORD_POST_PADDING)) & window.and_x) | window.or_x;
+    *texcoord_y = (Truncate8(v >> (COORD_FBS + COORD_POST_PADDING)) & window.and_y) | window.or_y;
+    u += du;
+    v += dv;
+  };
+
+  u8 texcoord_x, texcoord_y;
+  switch (cmd->draw_mode.texture_mode)
+  {
+    case GPUTextureMode::Palette4Bit:
+    {
+      for (u32 i = 0; i < GPUSWKernels::SPAN_PIXELS; i++)
+      {
+        get_texcoords(&texcoord_x, &texcoord_y);
+        const u16 palette_value = GetPixel((page_x + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
+                                           (page_y + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+        const u16 palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
+        texels[i] = GetPixel((palette_x + ZeroExtend32(palette_index)) % VRAM_WIDTH, palette_y);
+      }
+    }
+    break;
+
+    case GPUTextureMode::Palette8Bit:
+    {
+      for (u32 i = 0; i < GPUSWKernels::SPAN_PIXELS; i++)
+      {
+        get_texcoords(&texcoord_x, &texcoord_y);
+        const u16 palette_value = GetPixel((page_x + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
+                                           (page_y + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+        const u16 palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
+        texels[i] = GetPixel((palette_x + ZeroExtend32(palette_index)) % VRAM_WIDTH, palette_y);
+      }
+    }
+    break;
+
+    default:
+    {
+      for (u32 i = 0; i < GPUSWKernels::SPAN_PIXELS; i++)
+      {
+        get_texcoords(&texcoord_x, &texcoord_y);
+        texels[i] = GetPixel((page_x + ZeroExtend32(texcoord_x)) % VRAM_WIDTH,
+                             (page_y + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+      }
+    }
+    break;
+  }
+}
+
+bool GPU_SW_Backend::SpanOverlapsTexture(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u32 width) const
+{
+  // reads wrap around horizontally
+  const auto overlaps = [x, width](u32 read_x, u32 read_width) {
+    return ((x - read_x) % VRAM_WIDTH) < read_width || ((read_x - x) % VRAM_WIDTH) < width;
+  };
+
+  const Common::Rectangle<u32> page = cmd->draw_mode.GetTexturePageRectangle();
+  if (y >= page.top && y < page.bottom && overlaps(page.left, page.GetWidth()))
+    return true;
+
+  if (!cmd->draw_mode.IsUsingPalette() || y != cmd->palette.GetYBase())
+    return false;
+
+  return overlaps(cmd->palette.GetXBase(), (cmd->draw_mode.texture_mode == GPUTextureMode::Palette4Bit) ? 16 : 256);
+}
+
 template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
          bool dithering_enable>
-void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s32 x_start, s32 x_bound, i_group ig,
-                              const i_deltas& idl)
+void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip, s32 y,
+                              s32 x_start, s32 x_bound, i_group ig, const i_deltas& idl)
 {
   if (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u))
     return;
@@ -361,16 +491,16 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
   s32 w = x_bound - x_start;
   s32 x = TruncateGPUVertexPosition(x_start);
 
-  if (x < static_cast<s32>(m_drawing_area.left))
+  if (x < static_cast<s32>(clip.left))
   {
-    s32 delta = static_cast<s32>(m_drawing_area.left) - x;
+    s32 delta = static_cast<s32>(clip.left) - x;
     x_ig_adjust += delta;
     x += delta;
     w -= delta;
   }
 
-  if ((x + w) > (static_cast<s32>(m_drawing_area.right) + 1))
-    w = static_cast<s32>(m_drawing_area.right) + 1 - x;
+  if ((x + w) > (static_cast<s32>(clip.right) + 1))
+    w = static_cast<s32>(clip.right) + 1 - x;
 
   if (w <= 0)
     return;
@@ -378,6 +508,39 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
   AddIDeltas_DX<shading_enable, texture_enable>(ig, idl, x_ig_adjust);
   AddIDeltas_DY<shading_enable, texture_enable>(ig, idl, y);
 
+  // The vectorized path samples a whole chunk before writing it, so it can't be used when the span overwrites texels.
+  if (GPUSWKernels::HAS_VECTORIZED_SHADE_SPAN && w >= static_cast<s32>(GPUSWKernels::SPAN_PIXELS) &&
+      (!texture_enable || !SpanOverlapsTexture(cmd, static_cast<u32>(x), static_cast<u32>(y), static_cast<u32>(w))))
+  {
+    std::array<s16, GPUSWKernels::SPAN_PIXELS> dither;
+    for (u32 i = 0; i < GPUSWKernels::SPAN_PIXELS; i++)
+    {
+      dither[i] = static_cast<s16>(dithering_enable ? DITHER_MATRIX[y & 3][(static_cast<u32>(x) + i) & 3u] :
+                                                      DITHER_MATRIX[2][3]);
+    }
+
+    const u32 dr = shading_enable ? idl.dr_dx : 0;
+    const u32 dg = shading_enable ? idl.dg_dx : 0;
+    const u32 db = shading_enable ? idl.db_dx : 0;
+    std::array<u16, GPUSWKernels::SPAN_PIXELS> texels;
+    do
+    {
+      if constexpr (texture_enable)
+        SampleTextureSpan(cmd, ig.u, idl.du_dx, ig.v, idl.dv_dx, texels.data());
+
+      GPUSWKernels::ShadeSpan<texture_enable, raw_texture_enable, transparency_enable>(
+        &m_vram[VRAM_WIDTH * static_cast<u32>(y) + static_cast<u32>(x)], texels.data(), ig.r, dr, ig.g, dg, ig.b, db,
+        dither.data(), cmd->draw_mode.transparency_mode, cmd->params.GetMaskAND(), cmd->params.GetMaskOR());
+
+      x += GPUSWKernels::SPAN_PIXELS;
+      w -= GPUSWKernels::SPAN_PIXELS;
+      AddIDeltas_DX<shading_enable, texture_enable>(ig, idl, GPUSWKernels::SPAN_PIXELS);
+    } while (w >= static_cast<s32>(GPUSWKernels::SPAN_PIXELS));
+
+    if (w == 0)
+      return;
+  }
+
   do
   {
     const u32 r = ig.r >> (COORD_FBS + COORD_POST_PADDING);
@@ -397,7 +560,7 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
 
 template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
          bool dithering_enable>
-void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
+void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip,
                                   const GPUBackendDrawPolygonCommand::Vertex* v0,
                                   const GPUBackendDrawPolygonCommand::Vertex* v1,
                                   const GPUBackendDrawPolygonCommand::Vertex* v2)
@@ -555,14 +718,14 @@ void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
 
         s32 y = TruncateGPUVertexPosition(yi);
 
-        if (y < static_cast<s32>(m_drawing_area.top))
+        if (y < static_cast<s32>(clip.top))
           break;
 
-        if (y > static_cast<s32>(m_drawing_area.bottom))
+        if (y > static_cast<s32>(clip.bottom))
           continue;
 
         DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
-          cmd, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
+          cmd, clip, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
       }
     }
     else
@@ -571,14 +734,14 @@ void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
       {
         s32 y = TruncateGPUVertexPosition(yi);
 
-        if (y > static_cast<s32>(m_drawing_area.bottom))
+        if (y > static_cast<s32>(clip.bottom))
           break;
 
-        if (y >= static_cast<s32>(m_drawing_area.top))
+        if (y >= static_cast<s32>(clip.top))
         {
 
           DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
-            cmd, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
+            cmd, clip, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
         }
 
         yi++;
@@ -655,8 +818,8 @@ static ALWAYS_INLINE_RELEASE s64 LineDivide(s64 delta, s32 dk)
 }
 
 template<bool shading_enable, bool transparency_enable, bool dithering_enable>
-void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
-                              const GPUBackendDrawLineCommand::Vertex* p1)
+void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip,
+                              const GPUBackendDrawLineCommand::Vertex* p0, const GPUBackendDrawLineCommand::Vertex* p1)
 {
   const s32 i_dx = std::abs(p1->x - p0->x);
   const s32 i_dy = std::abs(p1->y - p0->y);
@@ -716,8 +879,8 @@ void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBac
     const s32 y = (cur_point.y >> Line_XY_FractBits) & 2047;
 
     if ((!cmd->params.interlaced_rendering || cmd->params.active_line_lsb != (Truncate8(static_cast<u32>(y)) & 1u)) &&
-        x >= static_cast<s32>(m_drawing_area.left) && x <= static_cast<s32>(m_drawing_area.right) &&
-        y >= static_cast<s32>(m_drawing_area.top) && y <= static_cast<s32>(m_drawing_area.bottom))
+        x >= static_cast<s32>(clip.left) && x <= static_cast<s32>(clip.right) &&
+        y >= static_cast<s32>(clip.top) && y <= static_cast<s32>(clip.bottom))
     {
       const u8 r = shading_enable ? static_cast<u8>(cur_point.r >> Line_RGB_FractBits) : p0->r;
       const u8 g = shading_enable ? static_cast<u8>(cur_point.g >> Line_RGB_FractBits) : p0->g;
@@ -921,6 +1084,310 @@ void GPU_SW_Backend::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wi
   }
 }
 
-void GPU_SW_Backend::FlushRender() {}
+void GPU_SW_Backend::StartRenderThreads(u32 count)
+{
+  // the GPU thread (or the CPU thread, when not using it) is one of the rasterizer threads
+  if (count <= 1)
+    return;
+
+  m_render_threads_shutdown = false;
+  m_render_threads_busy = 0;
+  for (u32 i = 0; i < (count - 1); i++)
+    m_render_threads.emplace_back(&GPU_SW_Backend::RenderThreadEntryPoint, this);
+
+  Log_InfoPrintf("Using %u threads for software rendering", count);
+}
+
+void GPU_SW_Backend::StopRenderThreads()
+{
+  if (m_render_threads.empty())
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(m_render_mutex);
+    m_render_threads_shutdown = true;
+    m_render_start_cv.notify_all();
+  }
+
+  for (std::thread& thread : m_render_threads)
+    thread.join();
+  m_render_threads.clear();
+}
+
+void GPU_SW_Backend::RenderThreadEntryPoint()
+{
+  std::unique_lock<std::mutex> lock(m_render_mutex);
+  u32 last_generation = m_render_generation;
+  for (;;)
+  {
+    m_render_start_cv.wait(
+      lock, [this, last_generation]() { return m_render_threads_shutdown || m_render_generation != last_generation; });
+    if (m_render_threads_shutdown)
+      break;
+
+    last_generation = m_render_generation;
+    lock.unlock();
+    DrawBatchBands();
+    lock.lock();
+
+    if (--m_render_threads_busy == 0)
+      m_render_done_cv.notify_one();
+  }
+}
+
+Common::Rectangle<u32> GPU_SW_Backend::GetDrawCommandBounds(const GPUBackendCommand* cmd) const
+{
+  // Half-open rectangle of pixels the command can write, with a pixel of slack for rounding in the rasterizer.
+  // Commands with coordinates that wrap around are treated as covering the whole drawing area.
+  s32 min_x = std::numeric_limits<s32>::max(), max_x = std::numeric_limits<s32>::min();
+  s32 min_y = std::numeric_limits<s32>::max(), max_y = std::numeric_limits<s32>::min();
+  s32 min_valid = -1024, max_valid = 1023;
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::DrawPolygon:
+    {
+      const GPUBackendDrawPolygonCommand* pcmd = static_cast<const GPUBackendDrawPolygonCommand*>(cmd);
+      for (u16 i = 0; i < pcmd->num_vertices; i++)
+      {
+        min_x = std::min(min_x, pcmd->vertices[i].x - 1);
+        max_x = std::max(max_x, pcmd->vertices[i].x + 1);
+        min_y = std::min(min_y, pcmd->vertices[i].y - 1);
+        max_y = std::max(max_y, pcmd->vertices[i].y + 1);
+      }
+    }
+    break;
+
+    case GPUBackendCommandType::DrawRectangle:
+    {
+      const GPUBackendDrawRectangleCommand* rcmd = static_cast<const GPUBackendDrawRectangleCommand*>(cmd);
+      min_x = rcmd->x;
+      max_x = rcmd->x + static_cast<s32>(rcmd->width) - 1;
+      min_y = rcmd->y;
+      max_y = rcmd->y + static_cast<s32>(rcmd->height) - 1;
+      min_valid = std::numeric_limits<s32>::min();
+      max_valid = std::numeric_limits<s32>::max();
+    }
+    break;
+
+    case GPUBackendCommandType::DrawLine:
+    {
+      // lines wrap at 2048 rather than sign extending, so negative coordinates are never drawn in place
+      const GPUBackendDrawLineCommand* lcmd = static_cast<const GPUBackendDrawLineCommand*>(cmd);
+      for (u16 i = 0; i < lcmd->num_vertices; i++)
+      {
+        min_x = std::min(min_x, lcmd->vertices[i].x - 1);
+        max_x = std::max(max_x, lcmd->vertices[i].x + 1);
+        min_y = std::min(min_y, lcmd->vertices[i].y - 1);
+        max_y = std::max(max_y, lcmd->vertices[i].y + 1);
+      }
+      min_valid = -1;
+      max_valid = 1024;
+    }
+    break;
+
+    default:
+      break;
+  }
+
+  const s32 area_left = static_cast<s32>(m_drawing_area.left);
+  const s32 area_top = static_cast<s32>(m_drawing_area.top);
+  const s32 area_right = static_cast<s32>(m_drawing_area.right) + 1;
+  const s32 area_bottom = static_cast<s32>(m_drawing_area.bottom) + 1;
+  if (min_x < min_valid || max_x > max_valid || min_y < min_valid || max_y > max_valid)
+    return Common::Rectangle<u32>(area_left, area_top, area_right, area_bottom);
+
+  const s32 left = std::max(min_x, area_left);
+  const s32 top = std::max(min_y, area_top);
+  const s32 right = std::min(max_x + 1, area_right);
+  const s32 bottom = std::min(max_y + 1, area_bottom);
+  if (left >= right || top >= bottom)
+    return {};
+
+  return Common::Rectangle<u32>(left, top, right, bottom);
+}
+
+std::array<Common::Rectangle<u32>, 2> GPU_SW_Backend::GetTextureReadAreas(const GPUBackendDrawCommand* cmd)
+{
+  const auto make_area = [](u32 left, u32 top, u32 width, u32 height) {
+    // reads wrap around horizontally
+    if ((left + width) > VRAM_WIDTH)
+    {
+      left = 0;
+      width = VRAM_WIDTH;
+    }
+
+    return Common::Rectangle<u32>::FromExtents(left, top, width, height);
+  };
+
+  std::array<Common::Rectangle<u32>, 2> areas;
+  if (cmd->type == GPUBackendCommandType::DrawLine || !cmd->rc.texture_enable)
+    return areas;
+
+  const Common::Rectangle<u32> page = cmd->draw_mode.GetTexturePageRectangle();
+  areas[0] = make_area(page.left, page.top, page.GetWidth(), page.GetHeight());
+
+  if (cmd->draw_mode.IsUsingPalette())
+  {
+    const u32 palette_size = (cmd->draw_mode.texture_mode == GPUTextureMode::Palette4Bit) ? 16 : 256;
+    areas[1] = make_area(cmd->palette.GetXBase(), cmd->palette.GetYBase(), palette_size, 1);
+  }
+
+  return areas;
+}
+
+bool GPU_SW_Backend::BatchReadsOverlap(const Common::Rectangle<u32>& area) const
+{
+  for (const Common::Rectangle<u32>& read_area : m_batch_read_areas)
+  {
+    if (read_area.Intersects(area))
+      return true;
+  }
+
+  return false;
+}
+
+void GPU_SW_Backend::AddBatchReadArea(const Common::Rectangle<u32>& area)
+{
+  if (!area.Valid())
+    return;
+
+  // most draws in a batch share a handful of pages and palettes
+  for (const Common::Rectangle<u32>& read_area : m_batch_read_areas)
+  {
+    if (area.left >= read_area.left && area.right <= read_area.right && area.top >= read_area.top &&
+        area.bottom <= read_area.bottom)
+    {
+      return;
+    }
+  }
+
+  if (m_batch_read_areas.size() < MAX_BATCH_READ_AREAS)
+    m_batch_read_areas.push_back(area);
+  else
+    m_batch_read_areas.back().Include(area);
+}
+
+void GPU_SW_Backend::QueueDrawCommand(const GPUBackendDrawCommand* cmd)
+{
+  const Common::Rectangle<u32> bounds = GetDrawCommandBounds(cmd);
+  if (!bounds.Valid())
+    return;
+
+  // Each band only sees its own writes until the batch is flushed, and the bands run in any order. So a texture which
+  // was drawn to in this batch, or a draw over a texture which an earlier command in the batch reads, has to wait for
+  // the batch to be rendered out. Mask and blending only read the pixel being written, which always stays in one band.
+  const std::array<Common::Rectangle<u32>, 2> read_areas = GetTextureReadAreas(cmd);
+  if (!m_batch_commands.empty() && (read_areas[0].Intersects(m_batch_area) ||
+                                    read_areas[1].Intersects(m_batch_area) || BatchReadsOverlap(bounds)))
+  {
+    FlushRender();
+  }
+
+  // A draw which samples its own output depends on the order its pixels are written in, so can't be split up.
+  if (read_areas[0].Intersects(bounds) || read_areas[1].Intersects(bounds))
+  {
+    FlushRender();
+    DrawBatchedCommand(cmd, m_drawing_area);
+    return;
+  }
+
+  AddBatchReadArea(read_areas[0]);
+  AddBatchReadArea(read_areas[1]);
+
+  const u32 offset = static_cast<u32>(m_batch_buffer.size());
+  m_batch_buffer.resize(offset + cmd->size);
+  std::memcpy(&m_batch_buffer[offset], cmd, cmd->size);
+  m_batch_commands.push_back(BatchedCommand{offset, bounds.top, bounds.bottom});
+
+  if (m_batch_commands.size() == 1)
+    m_batch_area = bounds;
+  else
+    m_batch_area.Include(bounds);
+
+  if (m_batch_commands.size() >= MAX_BATCH_COMMANDS)
+    FlushRender();
+}
+
+void GPU_SW_Backend::DrawBatchedCommand(const GPUBackendCommand* cmd, const Common::Rectangle<u32>& clip)
+{
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::DrawPolygon:
+      DrawPolygon(static_cast<const GPUBackendDrawPolygonCommand*>(cmd), clip);
+      break;
+
+    case GPUBackendCommandType::DrawRectangle:
+      DrawRectangle(static_cast<const GPUBackendDrawRectangleCommand*>(cmd), clip);
+      break;
+
+    case GPUBackendCommandType::DrawLine:
+      DrawLine(static_cast<const GPUBackendDrawLineCommand*>(cmd), clip);
+      break;
+
+    default:
+      break;
+  }
+}
+
+void GPU_SW_Backend::DrawBatchBands()
+{
+  // Every band draws the whole batch in order, clipped to its rows, so draw order within a pixel is preserved.
+  for (;;)
+  {
+    const u32 band = m_next_band.fetch_add(1);
+    if (band >= m_band_count)
+      break;
+
+    Common::Rectangle<u32> clip = m_drawing_area;
+    clip.top = m_batch_area.top + band * m_band_height;
+    clip.bottom = std::min(clip.top + m_band_height, m_batch_area.bottom) - 1;
+
+    for (const BatchedCommand& bc : m_batch_commands)
+    {
+      if (bc.bottom <= clip.top || bc.top > clip.bottom)
+        continue;
+
+      DrawBatchedCommand(reinterpret_cast<const GPUBackendCommand*>(&m_batch_buffer[bc.offset]), clip);
+    }
+  }
+}
+
+void GPU_SW_Backend::FlushRender()
+{
+  if (m_batch_commands.empty())
+    return;
+
+  const u32 rows = m_batch_area.GetHeight();
+  const u32 thread_count = GetRenderThreadCount();
+  m_band_height = std::max((rows + (thread_count * BANDS_PER_THREAD) - 1) / (thread_count * BANDS_PER_THREAD),
+                           static_cast<u32>(MIN_BAND_HEIGHT));
+  m_band_count = (rows + m_band_height - 1) / m_band_height;
+
+  if (m_band_count <= 1)
+  {
+    // not worth waking the other threads
+    for (const BatchedCommand& bc : m_batch_commands)
+      DrawBatchedCommand(reinterpret_cast<const GPUBackendCommand*>(&m_batch_buffer[bc.offset]), m_drawing_area);
+  }
+  else
+  {
+    m_next_band.store(0);
+    {
+      std::unique_lock<std::mutex> lock(m_render_mutex);
+      m_render_generation++;
+      m_render_threads_busy = static_cast<u32>(m_render_threads.size());
+      m_render_start_cv.notify_all();
+    }
+
+    DrawBatchBands();
+
+    std::unique_lock<std::mutex> lock(m_render_mutex);
+    m_render_done_cv.wait(lock, [this]() { return m_render_threads_busy == 0; });
+  }
+
+  m_batch_buffer.clear();
+  m_batch_commands.clear();
+  m_batch_read_areas.clear();
+}
 
 void GPU_SW_Backend::DrawingAreaChanged() {}
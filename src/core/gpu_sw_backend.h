@@ -1,7 +1,11 @@
 #pragma once
 #include "gpu_backend.h"
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 class GPU_SW_Backend final : public GPUBackend
@@ -11,7 +15,9 @@ public:
   ~GPU_SW_Backend() override;
 
   bool Initialize() override;
+  void UpdateSettings() override;
   void Reset(bool clear_vram) override;
+  void Shutdown() override;
 
   ALWAYS_INLINE_RELEASE u16 GetPixel(const u32 x, const u32 y) const { return m_vram[VRAM_WIDTH * y + x]; }
   ALWAYS_INLINE_RELEASE const u16* GetPixelPtr(const u32 x, const u32 y) const { return &m_vram[VRAM_WIDTH * y + x]; }
@@ -102,17 +108,59 @@ protected:
   void FlushRender() override;
   void DrawingAreaChanged() override;
 
+  //////////////////////////////////////////////////////////////////////////
+  // Multithreaded rasterization
+  //////////////////////////////////////////////////////////////////////////
+  enum : u32
+  {
+    MAX_BATCH_COMMANDS = 4096,
+    BANDS_PER_THREAD = 4,
+    MIN_BAND_HEIGHT = 8,
+    MAX_BATCH_READ_AREAS = 16
+  };
+
+  struct BatchedCommand
+  {
+    u32 offset;
+    u32 top;
+    u32 bottom;
+  };
+
+  u32 GetRenderThreadCount() const { return static_cast<u32>(m_render_threads.size()) + 1; }
+  void StartRenderThreads(u32 count);
+  void StopRenderThreads();
+  void RenderThreadEntryPoint();
+
+  Common::Rectangle<u32> GetDrawCommandBounds(const GPUBackendCommand* cmd) const;
+  static std::array<Common::Rectangle<u32>, 2> GetTextureReadAreas(const GPUBackendDrawCommand* cmd);
+  bool BatchReadsOverlap(const Common::Rectangle<u32>& area) const;
+  void AddBatchReadArea(const Common::Rectangle<u32>& area);
+  void QueueDrawCommand(const GPUBackendDrawCommand* cmd);
+  void DrawBatchedCommand(const GPUBackendCommand* cmd, const Common::Rectangle<u32>& clip);
+  void DrawBatchBands();
+
   //////////////////////////////////////////////////////////////////////////
   // Rasterization
   //////////////////////////////////////////////////////////////////////////
+  // The clip rectangle is inclusive, like the drawing area. It is narrower than the drawing area when rendering bands.
+  void DrawPolygon(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip);
+  void DrawLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip);
+  void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip);
+
+  u16 SampleTexture(const GPUBackendDrawCommand* cmd, u8 texcoord_x, u8 texcoord_y) const;
+
+  /// Samples GPUSWKernels::SPAN_PIXELS texels, with the texture coordinates in the same format as i_group.
+  void SampleTextureSpan(const GPUBackendDrawCommand* cmd, u32 u, u32 du, u32 v, u32 dv, u16* texels) const;
+
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
   void ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r, u8 color_g, u8 color_b, u8 texcoord_x,
                   u8 texcoord_y);
 
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
-  void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd);
+  void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip);
 
-  using DrawRectangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawRectangleCommand* cmd);
+  using DrawRectangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawRectangleCommand* cmd,
+                                                         const Common::Rectangle<u32>& clip);
   DrawRectangleFunction GetDrawRectangleFunction(bool texture_enable, bool raw_texture_enable,
                                                  bool transparency_enable);
 
@@ -144,17 +192,22 @@ protected:
   template<bool shading_enable, bool texture_enable>
   void AddIDeltas_DY(i_group& ig, const i_deltas& idl, u32 count = 1);
 
+  /// Returns true if drawing the span could overwrite texels or palette entries that the span itself samples.
+  bool SpanOverlapsTexture(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u32 width) const;
+
   template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
            bool dithering_enable>
-  void DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s32 x_start, s32 x_bound, i_group ig,
-                const i_deltas& idl);
+  void DrawSpan(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip, s32 y, s32 x_start,
+                s32 x_bound, i_group ig, const i_deltas& idl);
 
   template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
            bool dithering_enable>
-  void DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const GPUBackendDrawPolygonCommand::Vertex* v0,
-                    const GPUBackendDrawPolygonCommand::Vertex* v1, const GPUBackendDrawPolygonCommand::Vertex* v2);
+  void DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip,
+                    const GPUBackendDrawPolygonCommand::Vertex* v0, const GPUBackendDrawPolygonCommand::Vertex* v1,
+                    const GPUBackendDrawPolygonCommand::Vertex* v2);
 
   using DrawTriangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawPolygonCommand* cmd,
+                                                        const Common::Rectangle<u32>& clip,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v0,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v1,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v2);
@@ -162,13 +215,33 @@ protected:
                                                bool transparency_enable, bool dithering_enable);
 
   template<bool shading_enable, bool transparency_enable, bool dithering_enable>
-  void DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
-                const GPUBackendDrawLineCommand::Vertex* p1);
+  void DrawLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip,
+                const GPUBackendDrawLineCommand::Vertex* p0, const GPUBackendDrawLineCommand::Vertex* p1);
 
   using DrawLineFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawLineCommand* cmd,
+                                                    const Common::Rectangle<u32>& clip,
                                                     const GPUBackendDrawLineCommand::Vertex* p0,
                                                     const GPUBackendDrawLineCommand::Vertex* p1);
   DrawLineFunction GetDrawLineFunction(bool shading_enable, bool transparency_enable, bool dithering_enable);
 
   std::array<u16, VRAM_WIDTH * VRAM_HEIGHT> m_vram;
+
+  // Draw commands waiting to be rendered in bands, the area they write, and the texture pages and palettes they read.
+  // Read areas are kept separately rather than as one union, since pages and palettes are usually far apart in VRAM
+  // and their bounding box would cover the framebuffer.
+  std::vector<u8> m_batch_buffer;
+  std::vector<BatchedCommand> m_batch_commands;
+  Common::Rectangle<u32> m_batch_area;
+  std::vector<Common::Rectangle<u32>> m_batch_read_areas;
+  u32 m_band_height = 0;
+  u32 m_band_count = 0;
+  std::atomic<u32> m_next_band{0};
+
+  std::vector<std::thread> m_render_threads;
+  std::mutex m_render_mutex;
+  std::condition_variable m_render_start_cv;
+  std::condition_variable m_render_done_cv;
+  u32 m_render_generation = 0;
+  u32 m_render_threads_busy = 0;
+  bool m_render_threads_shutdown = false;
 };
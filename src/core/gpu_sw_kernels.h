@@ -0,0 +1,354 @@
+#pragma once
+#include "common/cpu_detect.h"
+#include "gpu_types.h"
+#include "types.h"
+#include <algorithm>
+
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#define GPU_SW_KERNELS_SSE2 1
+#elif defined(CPU_AARCH64) && defined(WITH_NEON_KERNELS)
+// Not yet verified against the reference versions on hardware, so only used when explicitly requested.
+#include <arm_neon.h>
+#define GPU_SW_KERNELS_NEON 1
+#endif
+
+// Span shading for the software renderer, processing SPAN_PIXELS pixels at a time. The texels are fetched by the
+// caller, since there is no gather in SSE2 or NEON. The vectorized versions must be bit-exact with the reference
+// versions, which do the same thing as GPU_SW_Backend::ShadePixel().
+namespace GPUSWKernels {
+
+enum : u32
+{
+  SPAN_PIXELS = 8,
+
+  // Interpolated colours are 8.24 fixed point.
+  INTERPOLATION_FRACTION_BITS = 24
+};
+
+/// Without a vectorized version, spans are shaded a pixel at a time instead.
+#if defined(GPU_SW_KERNELS_SSE2) || defined(GPU_SW_KERNELS_NEON)
+static constexpr bool HAS_VECTORIZED_SHADE_SPAN = true;
+#else
+static constexpr bool HAS_VECTORIZED_SHADE_SPAN = false;
+#endif
+
+// Reference versions.
+
+/// Texels are only read when texture_enable is set, and colours and dither offsets when raw_texture_enable is not.
+/// Colours are interpolated from the first pixel's value and the per-pixel step, which is zero for flat shading.
+template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
+static inline void ShadeSpan_Reference(u16* vram_ptr, const u16* texels, u32 r, u32 dr, u32 g, u32 dg, u32 b, u32 db,
+                                       const s16* dither, GPUTransparencyMode transparency_mode, u16 mask_and,
+                                       u16 mask_or)
+{
+  const auto dither_channel = [](u32 value, s16 offset) {
+    return static_cast<u16>(std::clamp<s32>((static_cast<s32>(value) + offset) >> 3, 0, 31));
+  };
+
+  for (u32 i = 0; i < SPAN_PIXELS; i++)
+  {
+    const u8 color_r = Truncate8((r + dr * i) >> INTERPOLATION_FRACTION_BITS);
+    const u8 color_g = Truncate8((g + dg * i) >> INTERPOLATION_FRACTION_BITS);
+    const u8 color_b = Truncate8((b + db * i) >> INTERPOLATION_FRACTION_BITS);
+
+    u16 color;
+    bool transparent;
+    if constexpr (texture_enable)
+    {
+      const u16 texel = texels[i];
+      if (texel == 0)
+        continue;
+
+      transparent = (texel & 0x8000u) != 0;
+      if constexpr (raw_texture_enable)
+      {
+        color = texel;
+      }
+      else
+      {
+        color = dither_channel((ZeroExtend32(texel & 0x1Fu) * color_r) >> 4, dither[i]) |
+                (dither_channel((ZeroExtend32((texel >> 5) & 0x1Fu) * color_g) >> 4, dither[i]) << 5) |
+                (dither_channel((ZeroExtend32((texel >> 10) & 0x1Fu) * color_b) >> 4, dither[i]) << 10) |
+                (texel & 0x8000u);
+      }
+    }
+    else
+    {
+      transparent = true;
+      color = dither_channel(color_r, dither[i]) | (dither_channel(color_g, dither[i]) << 5) |
+              (dither_channel(color_b, dither[i]) << 10);
+    }
+
+    const u16 bg_color = vram_ptr[i];
+    if constexpr (transparency_enable)
+    {
+      if (transparent)
+      {
+        u16 blended = color & 0x8000u;
+        for (u32 shift = 0; shift < 15; shift += 5)
+        {
+          const u32 bg = (bg_color >> shift) & 0x1Fu;
+          const u32 fg = (color >> shift) & 0x1Fu;
+          u32 result;
+          switch (transparency_mode)
+          {
+            case GPUTransparencyMode::HalfBackgroundPlusHalfForeground:
+              result = std::min<u32>((bg / 2) + (fg / 2), 0x1F);
+              break;
+            case GPUTransparencyMode::BackgroundPlusForeground:
+              result = std::min<u32>(bg + fg, 0x1F);
+              break;
+            case GPUTransparencyMode::BackgroundMinusForeground:
+              result = (bg > fg) ? (bg - fg) : 0;
+              break;
+            case GPUTransparencyMode::BackgroundPlusQuarterForeground:
+            default:
+              result = std::min<u32>(bg + (fg / 4), 0x1F);
+              break;
+          }
+          blended |= static_cast<u16>(result << shift);
+        }
+        color = blended;
+      }
+    }
+
+    if ((bg_color & mask_and) != 0)
+      continue;
+
+    vram_ptr[i] = color | mask_or;
+  }
+}
+
+#if defined(GPU_SW_KERNELS_SSE2)
+
+static inline __m128i InterpolateSpan_SSE2(u32 value, u32 step)
+{
+  const __m128i lo = _mm_setr_epi32(static_cast<s32>(value), static_cast<s32>(value + step),
+                                    static_cast<s32>(value + step * 2), static_cast<s32>(value + step * 3));
+  const __m128i hi = _mm_add_epi32(lo, _mm_set1_epi32(static_cast<s32>(step * 4)));
+  return _mm_packs_epi32(_mm_srli_epi32(lo, INTERPOLATION_FRACTION_BITS),
+                         _mm_srli_epi32(hi, INTERPOLATION_FRACTION_BITS));
+}
+
+template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
+static inline void ShadeSpan_SSE2(u16* vram_ptr, const u16* texels, u32 r, u32 dr, u32 g, u32 dg, u32 b, u32 db,
+                                  const s16* dither, GPUTransparencyMode transparency_mode, u16 mask_and, u16 mask_or)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i all_ones = _mm_cmpeq_epi16(zero, zero);
+  const __m128i channel_mask = _mm_set1_epi16(0x1F);
+  const __m128i c_mask = _mm_set1_epi16(static_cast<s16>(0x8000));
+
+  __m128i texel = zero;
+  __m128i write = all_ones;
+  __m128i transparent = all_ones;
+  if constexpr (texture_enable)
+  {
+    texel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels));
+    write = _mm_andnot_si128(_mm_cmpeq_epi16(texel, zero), all_ones);
+    transparent = _mm_srai_epi16(texel, 15);
+  }
+
+  __m128i color;
+  if constexpr (texture_enable && raw_texture_enable)
+  {
+    color = texel;
+  }
+  else
+  {
+    __m128i cr = InterpolateSpan_SSE2(r, dr);
+    __m128i cg = InterpolateSpan_SSE2(g, dg);
+    __m128i cb = InterpolateSpan_SSE2(b, db);
+    if constexpr (texture_enable)
+    {
+      // at most 31 * 255, so this fits in 16 bits
+      cr = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(texel, channel_mask), cr), 4);
+      cg = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(texel, 5), channel_mask), cg), 4);
+      cb = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(texel, 10), channel_mask), cb), 4);
+    }
+
+    const __m128i dither_offset = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dither));
+    cr = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(_mm_add_epi16(cr, dither_offset), 3), zero), channel_mask);
+    cg = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(_mm_add_epi16(cg, dither_offset), 3), zero), channel_mask);
+    cb = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(_mm_add_epi16(cb, dither_offset), 3), zero), channel_mask);
+    color = _mm_or_si128(_mm_or_si128(cr, _mm_slli_epi16(cg, 5)), _mm_slli_epi16(cb, 10));
+    if constexpr (texture_enable)
+      color = _mm_or_si128(color, _mm_and_si128(texel, c_mask));
+  }
+
+  const __m128i bg_color = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vram_ptr));
+  if constexpr (transparency_enable)
+  {
+    const __m128i bg_r = _mm_and_si128(bg_color, channel_mask);
+    const __m128i bg_g = _mm_and_si128(_mm_srli_epi16(bg_color, 5), channel_mask);
+    const __m128i bg_b = _mm_and_si128(_mm_srli_epi16(bg_color, 10), channel_mask);
+    const __m128i fg_r = _mm_and_si128(color, channel_mask);
+    const __m128i fg_g = _mm_and_si128(_mm_srli_epi16(color, 5), channel_mask);
+    const __m128i fg_b = _mm_and_si128(_mm_srli_epi16(color, 10), channel_mask);
+
+    __m128i blend_r, blend_g, blend_b;
+    switch (transparency_mode)
+    {
+      case GPUTransparencyMode::HalfBackgroundPlusHalfForeground:
+        blend_r = _mm_min_epi16(_mm_add_epi16(_mm_srli_epi16(bg_r, 1), _mm_srli_epi16(fg_r, 1)), channel_mask);
+        blend_g = _mm_min_epi16(_mm_add_epi16(_mm_srli_epi16(bg_g, 1), _mm_srli_epi16(fg_g, 1)), channel_mask);
+        blend_b = _mm_min_epi16(_mm_add_epi16(_mm_srli_epi16(bg_b, 1), _mm_srli_epi16(fg_b, 1)), channel_mask);
+        break;
+      case GPUTransparencyMode::BackgroundPlusForeground:
+        blend_r = _mm_min_epi16(_mm_add_epi16(bg_r, fg_r), channel_mask);
+        blend_g = _mm_min_epi16(_mm_add_epi16(bg_g, fg_g), channel_mask);
+        blend_b = _mm_min_epi16(_mm_add_epi16(bg_b, fg_b), channel_mask);
+        break;
+      case GPUTransparencyMode::BackgroundMinusForeground:
+        blend_r = _mm_subs_epu16(bg_r, fg_r);
+        blend_g = _mm_subs_epu16(bg_g, fg_g);
+        blend_b = _mm_subs_epu16(bg_b, fg_b);
+        break;
+      case GPUTransparencyMode::BackgroundPlusQuarterForeground:
+      default:
+        blend_r = _mm_min_epi16(_mm_add_epi16(bg_r, _mm_srli_epi16(fg_r, 2)), channel_mask);
+        blend_g = _mm_min_epi16(_mm_add_epi16(bg_g, _mm_srli_epi16(fg_g, 2)), channel_mask);
+        blend_b = _mm_min_epi16(_mm_add_epi16(bg_b, _mm_srli_epi16(fg_b, 2)), channel_mask);
+        break;
+    }
+
+    const __m128i blended =
+      _mm_or_si128(_mm_or_si128(blend_r, _mm_slli_epi16(blend_g, 5)),
+                   _mm_or_si128(_mm_slli_epi16(blend_b, 10), _mm_and_si128(color, c_mask)));
+    color = _mm_or_si128(_mm_and_si128(transparent, blended), _mm_andnot_si128(transparent, color));
+  }
+
+  write = _mm_and_si128(write, _mm_cmpeq_epi16(_mm_and_si128(bg_color, _mm_set1_epi16(static_cast<s16>(mask_and))),
+                                               zero));
+  color = _mm_or_si128(color, _mm_set1_epi16(static_cast<s16>(mask_or)));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(vram_ptr),
+                   _mm_or_si128(_mm_and_si128(write, color), _mm_andnot_si128(write, bg_color)));
+}
+
+#elif defined(GPU_SW_KERNELS_NEON)
+
+static inline uint16x8_t InterpolateSpan_NEON(u32 value, u32 step)
+{
+  const u32 lo_values[4] = {value, value + step, value + step * 2, value + step * 3};
+  const uint32x4_t lo = vld1q_u32(lo_values);
+  const uint32x4_t hi = vaddq_u32(lo, vdupq_n_u32(step * 4));
+  return vcombine_u16(vmovn_u32(vshrq_n_u32(lo, INTERPOLATION_FRACTION_BITS)),
+                      vmovn_u32(vshrq_n_u32(hi, INTERPOLATION_FRACTION_BITS)));
+}
+
+template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
+static inline void ShadeSpan_NEON(u16* vram_ptr, const u16* texels, u32 r, u32 dr, u32 g, u32 dg, u32 b, u32 db,
+                                  const s16* dither, GPUTransparencyMode transparency_mode, u16 mask_and, u16 mask_or)
+{
+  const uint16x8_t channel_mask = vdupq_n_u16(0x1F);
+  const uint16x8_t c_mask = vdupq_n_u16(0x8000);
+
+  uint16x8_t texel = vdupq_n_u16(0);
+  uint16x8_t write = vdupq_n_u16(0xFFFF);
+  uint16x8_t transparent = vdupq_n_u16(0xFFFF);
+  if constexpr (texture_enable)
+  {
+    texel = vld1q_u16(texels);
+    write = vtstq_u16(texel, texel);
+    transparent = vtstq_u16(texel, c_mask);
+  }
+
+  uint16x8_t color;
+  if constexpr (texture_enable && raw_texture_enable)
+  {
+    color = texel;
+  }
+  else
+  {
+    uint16x8_t cr = InterpolateSpan_NEON(r, dr);
+    uint16x8_t cg = InterpolateSpan_NEON(g, dg);
+    uint16x8_t cb = InterpolateSpan_NEON(b, db);
+    if constexpr (texture_enable)
+    {
+      // at most 31 * 255, so this fits in 16 bits
+      cr = vshrq_n_u16(vmulq_u16(vandq_u16(texel, channel_mask), cr), 4);
+      cg = vshrq_n_u16(vmulq_u16(vandq_u16(vshrq_n_u16(texel, 5), channel_mask), cg), 4);
+      cb = vshrq_n_u16(vmulq_u16(vandq_u16(vshrq_n_u16(texel, 10), channel_mask), cb), 4);
+    }
+
+    const int16x8_t dither_offset = vld1q_s16(dither);
+    const int16x8_t min_value = vdupq_n_s16(0);
+    const int16x8_t max_value = vdupq_n_s16(0x1F);
+    const auto dither_channel = [&](uint16x8_t value) {
+      const int16x8_t dithered = vshrq_n_s16(vaddq_s16(vreinterpretq_s16_u16(value), dither_offset), 3);
+      return vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(dithered, min_value), max_value));
+    };
+    cr = dither_channel(cr);
+    cg = dither_channel(cg);
+    cb = dither_channel(cb);
+    color = vorrq_u16(vorrq_u16(cr, vshlq_n_u16(cg, 5)), vshlq_n_u16(cb, 10));
+    if constexpr (texture_enable)
+      color = vorrq_u16(color, vandq_u16(texel, c_mask));
+  }
+
+  const uint16x8_t bg_color = vld1q_u16(vram_ptr);
+  if constexpr (transparency_enable)
+  {
+    const uint16x8_t bg_r = vandq_u16(bg_color, channel_mask);
+    const uint16x8_t bg_g = vandq_u16(vshrq_n_u16(bg_color, 5), channel_mask);
+    const uint16x8_t bg_b = vandq_u16(vshrq_n_u16(bg_color, 10), channel_mask);
+    const uint16x8_t fg_r = vandq_u16(color, channel_mask);
+    const uint16x8_t fg_g = vandq_u16(vshrq_n_u16(color, 5), channel_mask);
+    const uint16x8_t fg_b = vandq_u16(vshrq_n_u16(color, 10), channel_mask);
+
+    uint16x8_t blend_r, blend_g, blend_b;
+    switch (transparency_mode)
+    {
+      case GPUTransparencyMode::HalfBackgroundPlusHalfForeground:
+        blend_r = vminq_u16(vaddq_u16(vshrq_n_u16(bg_r, 1), vshrq_n_u16(fg_r, 1)), channel_mask);
+        blend_g = vminq_u16(vaddq_u16(vshrq_n_u16(bg_g, 1), vshrq_n_u16(fg_g, 1)), channel_mask);
+        blend_b = vminq_u16(vaddq_u16(vshrq_n_u16(bg_b, 1), vshrq_n_u16(fg_b, 1)), channel_mask);
+        break;
+      case GPUTransparencyMode::BackgroundPlusForeground:
+        blend_r = vminq_u16(vaddq_u16(bg_r, fg_r), channel_mask);
+        blend_g = vminq_u16(vaddq_u16(bg_g, fg_g), channel_mask);
+        blend_b = vminq_u16(vaddq_u16(bg_b, fg_b), channel_mask);
+        break;
+      case GPUTransparencyMode::BackgroundMinusForeground:
+        blend_r = vqsubq_u16(bg_r, fg_r);
+        blend_g = vqsubq_u16(bg_g, fg_g);
+        blend_b = vqsubq_u16(bg_b, fg_b);
+        break;
+      case GPUTransparencyMode::BackgroundPlusQuarterForeground:
+      default:
+        blend_r = vminq_u16(vaddq_u16(bg_r, vshrq_n_u16(fg_r, 2)), channel_mask);
+        blend_g = vminq_u16(vaddq_u16(bg_g, vshrq_n_u16(fg_g, 2)), channel_mask);
+        blend_b = vminq_u16(vaddq_u16(bg_b, vshrq_n_u16(fg_b, 2)), channel_mask);
+        break;
+    }
+
+    const uint16x8_t blended = vorrq_u16(vorrq_u16(blend_r, vshlq_n_u16(blend_g, 5)),
+                                         vorrq_u16(vshlq_n_u16(blend_b, 10), vandq_u16(color, c_mask)));
+    color = vbslq_u16(transparent, blended, color);
+  }
+
+  write = vandq_u16(write, vceqq_u16(vandq_u16(bg_color, vdupq_n_u16(mask_and)), vdupq_n_u16(0)));
+  color = vorrq_u16(color, vdupq_n_u16(mask_or));
+  vst1q_u16(vram_ptr, vbslq_u16(write, color, bg_color));
+}
+
+#endif
+
+template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
+static inline void ShadeSpan(u16* vram_ptr, const u16* texels, u32 r, u32 dr, u32 g, u32 dg, u32 b, u32 db,
+                             const s16* dither, GPUTransparencyMode transparency_mode, u16 mask_and, u16 mask_or)
+{
+#if defined(GPU_SW_KERNELS_SSE2)
+  ShadeSpan_SSE2<texture_enable, raw_texture_enable, transparency_enable>(
+    vram_ptr, texels, r, dr, g, dg, b, db, dither, transparency_mode, mask_and, mask_or);
+#elif defined(GPU_SW_KERNELS_NEON)
+  ShadeSpan_NEON<texture_enable, raw_texture_enable, transparency_enable>(
+    vram_ptr, texels, r, dr, g, dg, b, db, dither, transparency_mode, mask_and, mask_or);
+#else
+  ShadeSpan_Reference<texture_enable, raw_texture_enable, transparency_enable>(
+    vram_ptr, texels, r, dr, g, dg, b, db, dither, transparency_mode, mask_and, mask_or);
+#endif
+}
+
+} // namespace GPUSWKernels
@@ -3,6 +3,7 @@
 #include "common/bitutils.h"
 #include "common/state_wrapper.h"
 #include "cpu_core.h"
+#include "gte_kernels.h"
 #include "pgxp.h"
 #include "settings.h"
 #include <algorithm>
@@ -440,6 +441,15 @@ static void MulMatVec(const s16 M[3][3], const s32 T[3], const s16 Vx, const s16
 #undef dot3
 }
 
+// MVMVA's rows don't depend on each other, so they're computed together. The lighting commands feed IR from one
+// product into the next, where the scalar versions above have the shorter dependency chain.
+static void MulMatVecRows(const s16 M[3][3], const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift,
+                          bool lm)
+{
+  REGS.FLAG.bits |= GTEKernels::MulMatVec(M, T, Vx, Vy, Vz, shift, lm, reinterpret_cast<s32*>(&REGS.dr32[25]),
+                                          reinterpret_cast<s32*>(&REGS.dr32[9]));
+}
+
 static void MulMatVecBuggy(const s16 M[3][3], const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift,
                            bool lm)
 {
@@ -523,16 +533,16 @@ static void Execute_MVMVA(Instruction inst)
   switch (inst.mvmva_translation_vector)
   {
     case 0:
-      MulMatVec(M, REGS.TR, Vx, Vy, Vz, inst.GetShift(), inst.lm);
+      MulMatVecRows(M, REGS.TR, Vx, Vy, Vz, inst.GetShift(), inst.lm);
       break;
     case 1:
-      MulMatVec(M, REGS.BK, Vx, Vy, Vz, inst.GetShift(), inst.lm);
+      MulMatVecRows(M, REGS.BK, Vx, Vy, Vz, inst.GetShift(), inst.lm);
       break;
     case 2:
       MulMatVecBuggy(M, REGS.FC, Vx, Vy, Vz, inst.GetShift(), inst.lm);
       break;
     default:
-      MulMatVec(M, zero_T, Vx, Vy, Vz, inst.GetShift(), inst.lm);
+      MulMatVecRows(M, zero_T, Vx, Vy, Vz, inst.GetShift(), inst.lm);
       break;
   }
 
@@ -580,35 +590,8 @@ static void Execute_OP(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
-static void RTPS(const s16 V[3], u8 shift, bool lm, bool last)
+void RTPSProject(bool last)
 {
-#define dot3(i)                                                                                                        \
-  SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>((s64(REGS.TR[i]) << 12) + (s64(REGS.RT[i][0]) * s64(V[0]))) +  \
-                             (s64(REGS.RT[i][1]) * s64(V[1]))) +                                                       \
-    (s64(REGS.RT[i][2]) * s64(V[2]))
-
-  // IR1 = MAC1 = (TRX*1000h + RT11*VX0 + RT12*VY0 + RT13*VZ0) SAR (sf*12)
-  // IR2 = MAC2 = (TRY*1000h + RT21*VX0 + RT22*VY0 + RT23*VZ0) SAR (sf*12)
-  // IR3 = MAC3 = (TRZ*1000h + RT31*VX0 + RT32*VY0 + RT33*VZ0) SAR (sf*12)
-  const s64 x = dot3(0);
-  const s64 y = dot3(1);
-  const s64 z = dot3(2);
-  TruncateAndSetMAC<1>(x, shift);
-  TruncateAndSetMAC<2>(y, shift);
-  TruncateAndSetMAC<3>(z, shift);
-  TruncateAndSetIR<1>(REGS.MAC1, lm);
-  TruncateAndSetIR<2>(REGS.MAC2, lm);
-
-  // The command does saturate IR1,IR2,IR3 to -8000h..+7FFFh (regardless of lm bit). When using RTP with sf=0, then the
-  // IR3 saturation flag (FLAG.22) gets set <only> if "MAC3 SAR 12" exceeds -8000h..+7FFFh (although IR3 is saturated
-  // when "MAC3" exceeds -8000h..+7FFFh).
-  TruncateAndSetIR<3>(s32(z >> 12), false);
-  REGS.dr32[11] = std::clamp(REGS.MAC3, lm ? 0 : IR123_MIN_VALUE, IR123_MAX_VALUE);
-#undef dot3
-
-  // SZ3 = MAC3 SAR ((1-sf)*12)                           ;ScreenZ FIFO 0..+FFFFh
-  PushSZ(s32(z >> 12));
-
   // MAC0=(((H*20000h/SZ3)+1)/2)*IR1+OFX, SX2=MAC0/10000h ;ScrX FIFO -400h..+3FFh
   // MAC0=(((H*20000h/SZ3)+1)/2)*IR2+OFY, SY2=MAC0/10000h ;ScrY FIFO -400h..+3FFh
   const s64 result = static_cast<s64>(ZeroExtend64(UNRDivide(REGS.H, REGS.SZ3)));
@@ -681,6 +664,46 @@ static void RTPS(const s16 V[3], u8 shift, bool lm, bool last)
   CheckMACOverflow<0>(Sy);
   PushSXY(s32(Sx >> 16), s32(Sy >> 16));
 
+  if (last)
+  {
+    // MAC0=(((H*20000h/SZ3)+1)/2)*DQA+DQB, IR0=MAC0/1000h  ;Depth cueing 0..+1000h
+    const s64 Sz = s64(result) * s64(REGS.DQA) + s64(REGS.DQB);
+    TruncateAndSetMAC<0>(Sz, 0);
+    TruncateAndSetIR<0>(s32(Sz >> 12), true);
+  }
+}
+
+static void RTPS(const s16 V[3], u8 shift, bool lm, bool last)
+{
+#define dot3(i)                                                                                                        \
+  SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>((s64(REGS.TR[i]) << 12) + (s64(REGS.RT[i][0]) * s64(V[0]))) +  \
+                             (s64(REGS.RT[i][1]) * s64(V[1]))) +                                                       \
+    (s64(REGS.RT[i][2]) * s64(V[2]))
+
+  // IR1 = MAC1 = (TRX*1000h + RT11*VX0 + RT12*VY0 + RT13*VZ0) SAR (sf*12)
+  // IR2 = MAC2 = (TRY*1000h + RT21*VX0 + RT22*VY0 + RT23*VZ0) SAR (sf*12)
+  // IR3 = MAC3 = (TRZ*1000h + RT31*VX0 + RT32*VY0 + RT33*VZ0) SAR (sf*12)
+  const s64 x = dot3(0);
+  const s64 y = dot3(1);
+  const s64 z = dot3(2);
+  TruncateAndSetMAC<1>(x, shift);
+  TruncateAndSetMAC<2>(y, shift);
+  TruncateAndSetMAC<3>(z, shift);
+  TruncateAndSetIR<1>(REGS.MAC1, lm);
+  TruncateAndSetIR<2>(REGS.MAC2, lm);
+
+  // The command does saturate IR1,IR2,IR3 to -8000h..+7FFFh (regardless of lm bit). When using RTP with sf=0, then the
+  // IR3 saturation flag (FLAG.22) gets set <only> if "MAC3 SAR 12" exceeds -8000h..+7FFFh (although IR3 is saturated
+  // when "MAC3" exceeds -8000h..+7FFFh).
+  TruncateAndSetIR<3>(s32(z >> 12), false);
+  REGS.dr32[11] = std::clamp(REGS.MAC3, lm ? 0 : IR123_MIN_VALUE, IR123_MAX_VALUE);
+#undef dot3
+
+  // SZ3 = MAC3 SAR ((1-sf)*12)                           ;ScreenZ FIFO 0..+FFFFh
+  PushSZ(s32(z >> 12));
+
+  RTPSProject(last);
+
   if (g_settings.gpu_pgxp_enable)
   {
     float precise_sz3, precise_ir1, precise_ir2;
@@ -783,14 +806,6 @@ static void RTPS(const s16 V[3], u8 shift, bool lm, bool last)
     precise_y = std::clamp<float>(precise_y, -1024.0f, 1023.0f);
     PGXP::GTE_PushSXYZ2f(precise_x, precise_y, precise_z, REGS.dr32[14]);
   }
-
-  if (last)
-  {
-    // MAC0=(((H*20000h/SZ3)+1)/2)*DQA+DQB, IR0=MAC0/1000h  ;Depth cueing 0..+1000h
-    const s64 Sz = s64(result) * s64(REGS.DQA) + s64(REGS.DQB);
-    TruncateAndSetMAC<0>(Sz, 0);
-    TruncateAndSetIR<0>(s32(Sz >> 12), true);
-  }
 }
 
 static void Execute_RTPS(Instruction inst)
@@ -862,19 +877,16 @@ static void Execute_AVSZ4(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
-static ALWAYS_INLINE void InterpolateColor(s64 in_MAC1, s64 in_MAC2, s64 in_MAC3, u8 shift, bool lm)
+static ALWAYS_INLINE void InterpolateColor(s32 in_MAC1, s32 in_MAC2, s32 in_MAC3, u8 shift, bool lm)
 {
   // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
   //   [IR1,IR2,IR3] = (([RFC,GFC,BFC] SHL 12) - [MAC1,MAC2,MAC3]) SAR (sf*12)
-  TruncateAndSetMACAndIR<1>((s64(REGS.FC[0]) << 12) - in_MAC1, shift, false);
-  TruncateAndSetMACAndIR<2>((s64(REGS.FC[1]) << 12) - in_MAC2, shift, false);
-  TruncateAndSetMACAndIR<3>((s64(REGS.FC[2]) << 12) - in_MAC3, shift, false);
-
   //   [MAC1,MAC2,MAC3] = (([IR1,IR2,IR3] * IR0) + [MAC1,MAC2,MAC3])
   // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)
-  TruncateAndSetMACAndIR<1>(s64(s32(REGS.IR1) * s32(REGS.IR0)) + in_MAC1, shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(s32(REGS.IR2) * s32(REGS.IR0)) + in_MAC2, shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(s32(REGS.IR3) * s32(REGS.IR0)) + in_MAC3, shift, lm);
+  const s32 in_MAC[3] = {in_MAC1, in_MAC2, in_MAC3};
+  REGS.FLAG.bits |= GTEKernels::InterpolateColor(in_MAC, REGS.FC, REGS.IR0, shift, lm,
+                                                 reinterpret_cast<s32*>(&REGS.dr32[25]),
+                                                 reinterpret_cast<s32*>(&REGS.dr32[9]));
 }
 
 static void NCS(const s16 V[3], u8 shift, bool lm)
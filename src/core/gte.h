@@ -21,4 +21,8 @@ void ExecuteInstruction(u32 inst_bits);
 using InstructionImpl = void (*)(Instruction);
 InstructionImpl GetInstructionImpl(u32 inst_bits);
 
+// Perspective division and depth cueing for one RTPS/RTPT vertex, once it has been transformed to IR1-3 and pushed to
+// the SZ FIFO. The recompiler generates the transform inline and calls this for the rest.
+void RTPSProject(bool last);
+
 } // namespace GTE
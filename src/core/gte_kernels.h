@@ -0,0 +1,419 @@
+#pragma once
+#include "common/bitutils.h"
+#include "common/cpu_detect.h"
+#include "types.h"
+#include <algorithm>
+
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#define GTE_KERNELS_SSE2 1
+#elif defined(CPU_AARCH64) && defined(WITH_NEON_KERNELS)
+// Not yet verified against the reference versions on hardware, so only used when explicitly requested.
+#include <arm_neon.h>
+#define GTE_KERNELS_NEON 1
+#endif
+
+// Matrix-vector products and colour interpolation for the GTE, computing all three components at once. The
+// vectorized versions must be bit-exact with the reference versions for any register values, including the FLAG bits.
+//
+// MAC1-3 hold 44-bit values. The vectorized versions keep them as the top 32 bits and the low 12 bits, so everything
+// can be done in 32-bit lanes: a 44-bit value overflows exactly when its top 32 bits do, and letting the top part
+// wrap around is the same as the GTE sign extending the value from 44 bits. The overflow checks after each addition
+// are done side by side rather than one after another, to keep the dependency chain short.
+namespace GTEKernels {
+
+enum : u32
+{
+  MAC_FRACTION_BITS = 12,
+  MAC_FRACTION_MASK = (1u << MAC_FRACTION_BITS) - 1,
+
+  // FLAG bit of each error for component 3, component 2 and 1 are the next two bits up.
+  FLAG_MAC_OVERFLOW_SHIFT = 28,
+  FLAG_MAC_UNDERFLOW_SHIFT = 25,
+  FLAG_IR_SATURATED_SHIFT = 22,
+};
+
+// Reference versions, these do the same thing as the scalar code in gte.cpp.
+
+static inline u32 CheckMACOverflow_Reference(s64 value, u32 index)
+{
+  if (value < -(INT64_C(1) << 43))
+    return (1u << FLAG_MAC_UNDERFLOW_SHIFT) << (2 - index);
+  else if (value > ((INT64_C(1) << 43) - 1))
+    return (1u << FLAG_MAC_OVERFLOW_SHIFT) << (2 - index);
+  else
+    return 0;
+}
+
+static inline u32 SetMACAndIR_Reference(s64 value, u32 index, u8 shift, bool lm, s32* MAC, s32* IR)
+{
+  u32 flags = CheckMACOverflow_Reference(value, index);
+
+  // shift should be done before truncating to avoid losing precision
+  const s32 value32 = static_cast<s32>(value >> shift);
+  const s32 min_value = lm ? 0 : -0x8000;
+  const s32 max_value = 0x7FFF;
+  if (value32 < min_value || value32 > max_value)
+    flags |= (1u << FLAG_IR_SATURATED_SHIFT) << (2 - index);
+
+  MAC[index] = value32;
+  IR[index] = std::clamp(value32, min_value, max_value);
+  return flags;
+}
+
+/// [MAC1,MAC2,MAC3] = (T*1000h + M*V) SAR shift, [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] saturated to -8000h/0..7FFFh.
+/// The sums are checked for overflow after each addition. Shift must be 0 or 12. Returns the FLAG bits which should be set.
+static inline u32 MulMatVec_Reference(const s16 M[3][3], const s32 T[3], s16 Vx, s16 Vy, s16 Vz, u8 shift, bool lm,
+                                      s32 MAC[3], s32 IR[3])
+{
+  u32 flags = 0;
+  for (u32 i = 0; i < 3; i++)
+  {
+    s64 value = (s64(T[i]) << 12) + (s64(M[i][0]) * s64(Vx));
+    flags |= CheckMACOverflow_Reference(value, i);
+    value = SignExtendN<44>(value) + (s64(M[i][1]) * s64(Vy));
+    flags |= CheckMACOverflow_Reference(value, i);
+    value = SignExtendN<44>(value) + (s64(M[i][2]) * s64(Vz));
+
+    flags |= SetMACAndIR_Reference(value, i, shift, lm, MAC, IR);
+  }
+
+  return flags;
+}
+
+/// [IR1,IR2,IR3] = ((FC*1000h) - in_MAC) SAR shift, then [MAC1,MAC2,MAC3] = (IR * IR0 + in_MAC) SAR shift.
+/// Shift must be 0 or 12. Returns the FLAG bits which should be set.
+static inline u32 InterpolateColor_Reference(const s32 in_MAC[3], const s32 FC[3], s16 IR0, u8 shift, bool lm,
+                                             s32 MAC[3], s32 IR[3])
+{
+  u32 flags = 0;
+  for (u32 i = 0; i < 3; i++)
+    flags |= SetMACAndIR_Reference((s64(FC[i]) << 12) - in_MAC[i], i, shift, false, MAC, IR);
+  for (u32 i = 0; i < 3; i++)
+    flags |= SetMACAndIR_Reference(s64(IR[i] * s32(IR0)) + in_MAC[i], i, shift, lm, MAC, IR);
+
+  return flags;
+}
+
+#if defined(GTE_KERNELS_SSE2)
+
+// Products of the 16-bit values in the low half of each lane of lhs and the value broadcast by Broadcast16_SSE2().
+static inline __m128i Multiply16_SSE2(__m128i lhs, __m128i rhs)
+{
+  return _mm_madd_epi16(lhs, rhs);
+}
+
+// The top half of each lane is zero, so Multiply16_SSE2() ignores the top half of each lane of the other operand.
+static inline __m128i Broadcast16_SSE2(s16 value)
+{
+  return _mm_set1_epi32(static_cast<u16>(value));
+}
+
+// Records which components of lhs + addend = sum left the 32-bit range, i.e. the 44-bit range for a split MAC.
+static inline void CheckAdd_SSE2(__m128i lhs, __m128i addend, __m128i sum, __m128i& overflow, __m128i& underflow)
+{
+  // signed overflow when both sides have the same sign, and the sign of the result is different
+  const __m128i wrapped = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(lhs, addend), _mm_xor_si128(lhs, sum)), 31);
+  const __m128i negative = _mm_srai_epi32(addend, 31);
+  overflow = _mm_or_si128(overflow, _mm_andnot_si128(negative, wrapped));
+  underflow = _mm_or_si128(underflow, _mm_and_si128(negative, wrapped));
+}
+
+// Records which components of lhs - subtrahend = difference left the 32-bit range.
+static inline void CheckSub_SSE2(__m128i lhs, __m128i subtrahend, __m128i difference, __m128i& overflow,
+                                 __m128i& underflow)
+{
+  // signed overflow when the sides have different signs, and the sign of the result is different to the lhs
+  const __m128i wrapped =
+    _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(lhs, subtrahend), _mm_xor_si128(lhs, difference)), 31);
+  const __m128i negative = _mm_srai_epi32(subtrahend, 31);
+  overflow = _mm_or_si128(overflow, _mm_and_si128(negative, wrapped));
+  underflow = _mm_or_si128(underflow, _mm_andnot_si128(negative, wrapped));
+}
+
+// Saturates MAC to -8000h/0..7FFFh, recording which components were saturated.
+static inline __m128i SaturateIR_SSE2(__m128i mac, bool lm, __m128i& saturated)
+{
+  __m128i ir = _mm_packs_epi32(mac, mac);
+  if (lm)
+    ir = _mm_max_epi16(ir, _mm_setzero_si128());
+
+  ir = _mm_srai_epi32(_mm_unpacklo_epi16(ir, ir), 16);
+  saturated = _mm_andnot_si128(_mm_cmpeq_epi32(mac, ir), _mm_set1_epi32(-1));
+  return ir;
+}
+
+// FLAG bits of each component, OR them together with ReduceFlags_SSE2().
+static inline __m128i GetFlags_SSE2(__m128i overflow, __m128i underflow, __m128i saturated)
+{
+  const auto component_bits = [](u32 shift) {
+    return _mm_setr_epi32(static_cast<int>(4u << shift), static_cast<int>(2u << shift), static_cast<int>(1u << shift),
+                          0);
+  };
+  return _mm_or_si128(_mm_or_si128(_mm_and_si128(overflow, component_bits(FLAG_MAC_OVERFLOW_SHIFT)),
+                                   _mm_and_si128(underflow, component_bits(FLAG_MAC_UNDERFLOW_SHIFT))),
+                      _mm_and_si128(saturated, component_bits(FLAG_IR_SATURATED_SHIFT)));
+}
+
+static inline u32 ReduceFlags_SSE2(__m128i flags)
+{
+  flags = _mm_or_si128(flags, _mm_shuffle_epi32(flags, _MM_SHUFFLE(1, 0, 3, 2)));
+  flags = _mm_or_si128(flags, _mm_shuffle_epi32(flags, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<u32>(_mm_cvtsi128_si32(flags));
+}
+
+// Stores the first three 32-bit lanes of value, without touching dst[3].
+static inline void Store3_SSE2(s32* dst, __m128i value)
+{
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), value);
+  dst[2] = _mm_cvtsi128_si32(_mm_shuffle_epi32(value, _MM_SHUFFLE(2, 2, 2, 2)));
+}
+
+static inline u32 MulMatVec_SSE2(const s16 M[3][3], const s32 T[3], s16 Vx, s16 Vy, s16 Vz, u8 shift, bool lm,
+                                 s32 MAC[3], s32 IR[3])
+{
+  const __m128i fraction_mask = _mm_set1_epi32(MAC_FRACTION_MASK);
+  const __m128i t = _mm_setr_epi32(T[0], T[1], T[2], 0);
+  const __m128i p0 = Multiply16_SSE2(_mm_setr_epi32(M[0][0], M[1][0], M[2][0], 0), Broadcast16_SSE2(Vx));
+  const __m128i p1 = Multiply16_SSE2(_mm_setr_epi32(M[0][1], M[1][1], M[2][1], 0), Broadcast16_SSE2(Vy));
+  const __m128i p2 = Multiply16_SSE2(_mm_setr_epi32(M[0][2], M[1][2], M[2][2], 0), Broadcast16_SSE2(Vz));
+
+  // Fractions and top 32 bits of the products summed so far, these are small enough to never wrap.
+  const __m128i lo1 = _mm_add_epi32(_mm_and_si128(p0, fraction_mask), _mm_and_si128(p1, fraction_mask));
+  const __m128i lo2 = _mm_add_epi32(lo1, _mm_and_si128(p2, fraction_mask));
+  const __m128i sum0 = _mm_srai_epi32(p0, MAC_FRACTION_BITS);
+  const __m128i sum01 = _mm_add_epi32(sum0, _mm_srai_epi32(p1, MAC_FRACTION_BITS));
+  const __m128i sum1 = _mm_add_epi32(sum01, _mm_srli_epi32(lo1, MAC_FRACTION_BITS));
+  const __m128i sum2 = _mm_add_epi32(_mm_add_epi32(sum01, _mm_srai_epi32(p2, MAC_FRACTION_BITS)),
+                                     _mm_srli_epi32(lo2, MAC_FRACTION_BITS));
+
+  // Wrapping additions are associative, so the top 32 bits after each step don't depend on the previous step.
+  const __m128i hi0 = _mm_add_epi32(t, sum0);
+  const __m128i hi1 = _mm_add_epi32(t, sum1);
+  const __m128i hi2 = _mm_add_epi32(t, sum2);
+  __m128i overflow = _mm_setzero_si128();
+  __m128i underflow = _mm_setzero_si128();
+  CheckAdd_SSE2(t, sum0, hi0, overflow, underflow);
+  CheckAdd_SSE2(hi0, _mm_sub_epi32(sum1, sum0), hi1, overflow, underflow);
+  CheckAdd_SSE2(hi1, _mm_sub_epi32(sum2, sum1), hi2, overflow, underflow);
+
+  // The low 32 bits are just the wrapping sum.
+  const __m128i mac =
+    (shift == MAC_FRACTION_BITS) ?
+      hi2 :
+      _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(t, MAC_FRACTION_BITS), p0), _mm_add_epi32(p1, p2));
+  __m128i saturated;
+  const __m128i ir = SaturateIR_SSE2(mac, lm, saturated);
+  Store3_SSE2(MAC, mac);
+  Store3_SSE2(IR, ir);
+  return ReduceFlags_SSE2(GetFlags_SSE2(overflow, underflow, saturated));
+}
+
+static inline u32 InterpolateColor_SSE2(const s32 in_MAC[3], const s32 FC[3], s16 IR0, u8 shift, bool lm, s32 MAC[3],
+                                        s32 IR[3])
+{
+  const __m128i fraction_mask = _mm_set1_epi32(MAC_FRACTION_MASK);
+  const __m128i in_mac = _mm_setr_epi32(in_MAC[0], in_MAC[1], in_MAC[2], 0);
+  const __m128i fc = _mm_setr_epi32(FC[0], FC[1], FC[2], 0);
+  const __m128i in_mac_hi = _mm_srai_epi32(in_mac, MAC_FRACTION_BITS);
+  const __m128i in_mac_lo = _mm_and_si128(in_mac, fraction_mask);
+
+  // FC SHL 12 has no fraction, so the fraction of in_MAC borrows from the top 32 bits.
+  const __m128i subtrahend =
+    _mm_sub_epi32(in_mac_hi, _mm_srai_epi32(_mm_sub_epi32(_mm_setzero_si128(), in_mac_lo), MAC_FRACTION_BITS));
+  const __m128i hi = _mm_sub_epi32(fc, subtrahend);
+  __m128i overflow = _mm_setzero_si128();
+  __m128i underflow = _mm_setzero_si128();
+  __m128i saturated;
+  CheckSub_SSE2(fc, subtrahend, hi, overflow, underflow);
+  const __m128i mac =
+    (shift == MAC_FRACTION_BITS) ? hi : _mm_sub_epi32(_mm_slli_epi32(fc, MAC_FRACTION_BITS), in_mac);
+  const __m128i ir = SaturateIR_SSE2(mac, false, saturated);
+  __m128i flags = GetFlags_SSE2(overflow, underflow, saturated);
+
+  // MAC and IR from the first step are overwritten by the second, so they're never stored. The second step adds a
+  // 32-bit value to a 32-bit product, which can't leave the 44-bit range, so there's no need to check it.
+  const __m128i product = Multiply16_SSE2(ir, Broadcast16_SSE2(IR0));
+  const __m128i result_mac =
+    (shift == MAC_FRACTION_BITS) ?
+      _mm_add_epi32(_mm_add_epi32(in_mac_hi, _mm_srai_epi32(product, MAC_FRACTION_BITS)),
+                    _mm_srli_epi32(_mm_add_epi32(in_mac_lo, _mm_and_si128(product, fraction_mask)),
+                                   MAC_FRACTION_BITS)) :
+      _mm_add_epi32(in_mac, product);
+  const __m128i result_ir = SaturateIR_SSE2(result_mac, lm, saturated);
+  Store3_SSE2(MAC, result_mac);
+  Store3_SSE2(IR, result_ir);
+  flags = _mm_or_si128(flags, GetFlags_SSE2(_mm_setzero_si128(), _mm_setzero_si128(), saturated));
+  return ReduceFlags_SSE2(flags);
+}
+
+#elif defined(GTE_KERNELS_NEON)
+
+// Records which components of lhs + addend = sum left the 32-bit range, i.e. the 44-bit range for a split MAC.
+static inline void CheckAdd_NEON(int32x4_t lhs, int32x4_t addend, int32x4_t sum, uint32x4_t& overflow,
+                                 uint32x4_t& underflow)
+{
+  // signed overflow when both sides have the same sign, and the sign of the result is different
+  const uint32x4_t wrapped =
+    vreinterpretq_u32_s32(vshrq_n_s32(vbicq_s32(veorq_s32(lhs, sum), veorq_s32(lhs, addend)), 31));
+  const uint32x4_t negative = vreinterpretq_u32_s32(vshrq_n_s32(addend, 31));
+  overflow = vorrq_u32(overflow, vbicq_u32(wrapped, negative));
+  underflow = vorrq_u32(underflow, vandq_u32(wrapped, negative));
+}
+
+// Records which components of lhs - subtrahend = difference left the 32-bit range.
+static inline void CheckSub_NEON(int32x4_t lhs, int32x4_t subtrahend, int32x4_t difference, uint32x4_t& overflow,
+                                 uint32x4_t& underflow)
+{
+  // signed overflow when the sides have different signs, and the sign of the result is different to the lhs
+  const uint32x4_t wrapped =
+    vreinterpretq_u32_s32(vshrq_n_s32(vandq_s32(veorq_s32(lhs, subtrahend), veorq_s32(lhs, difference)), 31));
+  const uint32x4_t negative = vreinterpretq_u32_s32(vshrq_n_s32(subtrahend, 31));
+  overflow = vorrq_u32(overflow, vandq_u32(wrapped, negative));
+  underflow = vorrq_u32(underflow, vbicq_u32(wrapped, negative));
+}
+
+// Saturates MAC to -8000h/0..7FFFh, recording which components were saturated.
+static inline int16x4_t SaturateIR_NEON(int32x4_t mac, bool lm, uint32x4_t& saturated)
+{
+  int16x4_t ir = vqmovn_s32(mac);
+  if (lm)
+    ir = vmax_s16(ir, vdup_n_s16(0));
+
+  saturated = vmvnq_u32(vceqq_s32(mac, vmovl_s16(ir)));
+  return ir;
+}
+
+// FLAG bits of each component, OR them together with ReduceFlags_NEON().
+static inline uint32x4_t GetFlags_NEON(uint32x4_t overflow, uint32x4_t underflow, uint32x4_t saturated)
+{
+  const auto component_bits = [](u32 shift) {
+    const u32 bits[4] = {4u << shift, 2u << shift, 1u << shift, 0};
+    return vld1q_u32(bits);
+  };
+  return vorrq_u32(vorrq_u32(vandq_u32(overflow, component_bits(FLAG_MAC_OVERFLOW_SHIFT)),
+                             vandq_u32(underflow, component_bits(FLAG_MAC_UNDERFLOW_SHIFT))),
+                   vandq_u32(saturated, component_bits(FLAG_IR_SATURATED_SHIFT)));
+}
+
+static inline u32 ReduceFlags_NEON(uint32x4_t flags)
+{
+  // each bit only appears in one lane, so adding is the same as OR
+  return vaddvq_u32(flags);
+}
+
+// Stores the first three 32-bit lanes of value, without touching dst[3].
+static inline void Store3_NEON(s32* dst, int32x4_t value)
+{
+  vst1_s32(dst, vget_low_s32(value));
+  vst1q_lane_s32(dst + 2, value, 2);
+}
+
+static inline u32 MulMatVec_NEON(const s16 M[3][3], const s32 T[3], s16 Vx, s16 Vy, s16 Vz, u8 shift, bool lm,
+                                 s32 MAC[3], s32 IR[3])
+{
+  const s32 t_values[4] = {T[0], T[1], T[2], 0};
+  const s16 m_values[3][4] = {
+    {M[0][0], M[1][0], M[2][0], 0}, {M[0][1], M[1][1], M[2][1], 0}, {M[0][2], M[1][2], M[2][2], 0}};
+
+  const int32x4_t fraction_mask = vdupq_n_s32(MAC_FRACTION_MASK);
+  const int32x4_t t = vld1q_s32(t_values);
+  const int32x4_t p0 = vmull_s16(vld1_s16(m_values[0]), vdup_n_s16(Vx));
+  const int32x4_t p1 = vmull_s16(vld1_s16(m_values[1]), vdup_n_s16(Vy));
+  const int32x4_t p2 = vmull_s16(vld1_s16(m_values[2]), vdup_n_s16(Vz));
+
+  // Fractions and top 32 bits of the products summed so far, these are small enough to never wrap.
+  const int32x4_t lo1 = vaddq_s32(vandq_s32(p0, fraction_mask), vandq_s32(p1, fraction_mask));
+  const int32x4_t lo2 = vaddq_s32(lo1, vandq_s32(p2, fraction_mask));
+  const int32x4_t sum0 = vshrq_n_s32(p0, MAC_FRACTION_BITS);
+  const int32x4_t sum01 = vaddq_s32(sum0, vshrq_n_s32(p1, MAC_FRACTION_BITS));
+  const int32x4_t sum1 = vaddq_s32(sum01, vshrq_n_s32(lo1, MAC_FRACTION_BITS));
+  const int32x4_t sum2 =
+    vaddq_s32(vaddq_s32(sum01, vshrq_n_s32(p2, MAC_FRACTION_BITS)), vshrq_n_s32(lo2, MAC_FRACTION_BITS));
+
+  // Wrapping additions are associative, so the top 32 bits after each step don't depend on the previous step.
+  const int32x4_t hi0 = vaddq_s32(t, sum0);
+  const int32x4_t hi1 = vaddq_s32(t, sum1);
+  const int32x4_t hi2 = vaddq_s32(t, sum2);
+  uint32x4_t overflow = vdupq_n_u32(0);
+  uint32x4_t underflow = vdupq_n_u32(0);
+  CheckAdd_NEON(t, sum0, hi0, overflow, underflow);
+  CheckAdd_NEON(hi0, vsubq_s32(sum1, sum0), hi1, overflow, underflow);
+  CheckAdd_NEON(hi1, vsubq_s32(sum2, sum1), hi2, overflow, underflow);
+
+  // The low 32 bits are just the wrapping sum.
+  const int32x4_t mac = (shift == MAC_FRACTION_BITS) ?
+                          hi2 :
+                          vaddq_s32(vaddq_s32(vshlq_n_s32(t, MAC_FRACTION_BITS), p0), vaddq_s32(p1, p2));
+  uint32x4_t saturated;
+  const int16x4_t ir = SaturateIR_NEON(mac, lm, saturated);
+  Store3_NEON(MAC, mac);
+  Store3_NEON(IR, vmovl_s16(ir));
+  return ReduceFlags_NEON(GetFlags_NEON(overflow, underflow, saturated));
+}
+
+static inline u32 InterpolateColor_NEON(const s32 in_MAC[3], const s32 FC[3], s16 IR0, u8 shift, bool lm, s32 MAC[3],
+                                        s32 IR[3])
+{
+  const s32 in_mac_values[4] = {in_MAC[0], in_MAC[1], in_MAC[2], 0};
+  const s32 fc_values[4] = {FC[0], FC[1], FC[2], 0};
+
+  const int32x4_t fraction_mask = vdupq_n_s32(MAC_FRACTION_MASK);
+  const int32x4_t in_mac = vld1q_s32(in_mac_values);
+  const int32x4_t fc = vld1q_s32(fc_values);
+  const int32x4_t in_mac_hi = vshrq_n_s32(in_mac, MAC_FRACTION_BITS);
+  const int32x4_t in_mac_lo = vandq_s32(in_mac, fraction_mask);
+
+  // FC SHL 12 has no fraction, so the fraction of in_MAC borrows from the top 32 bits.
+  const int32x4_t subtrahend = vsubq_s32(in_mac_hi, vshrq_n_s32(vnegq_s32(in_mac_lo), MAC_FRACTION_BITS));
+  const int32x4_t hi = vsubq_s32(fc, subtrahend);
+  uint32x4_t overflow = vdupq_n_u32(0);
+  uint32x4_t underflow = vdupq_n_u32(0);
+  uint32x4_t saturated;
+  CheckSub_NEON(fc, subtrahend, hi, overflow, underflow);
+  const int32x4_t mac = (shift == MAC_FRACTION_BITS) ? hi : vsubq_s32(vshlq_n_s32(fc, MAC_FRACTION_BITS), in_mac);
+  const int16x4_t ir = SaturateIR_NEON(mac, false, saturated);
+  uint32x4_t flags = GetFlags_NEON(overflow, underflow, saturated);
+
+  // MAC and IR from the first step are overwritten by the second, so they're never stored. The second step adds a
+  // 32-bit value to a 32-bit product, which can't leave the 44-bit range, so there's no need to check it.
+  const int32x4_t product = vmull_s16(ir, vdup_n_s16(IR0));
+  const int32x4_t result_mac =
+    (shift == MAC_FRACTION_BITS) ?
+      vaddq_s32(vaddq_s32(in_mac_hi, vshrq_n_s32(product, MAC_FRACTION_BITS)),
+                vshrq_n_s32(vaddq_s32(in_mac_lo, vandq_s32(product, fraction_mask)), MAC_FRACTION_BITS)) :
+      vaddq_s32(in_mac, product);
+  const int16x4_t result_ir = SaturateIR_NEON(result_mac, lm, saturated);
+  Store3_NEON(MAC, result_mac);
+  Store3_NEON(IR, vmovl_s16(result_ir));
+  flags = vorrq_u32(flags, GetFlags_NEON(vdupq_n_u32(0), vdupq_n_u32(0), saturated));
+  return ReduceFlags_NEON(flags);
+}
+
+#endif
+
+static inline u32 MulMatVec(const s16 M[3][3], const s32 T[3], s16 Vx, s16 Vy, s16 Vz, u8 shift, bool lm, s32 MAC[3],
+                            s32 IR[3])
+{
+#if defined(GTE_KERNELS_SSE2)
+  return MulMatVec_SSE2(M, T, Vx, Vy, Vz, shift, lm, MAC, IR);
+#elif defined(GTE_KERNELS_NEON)
+  return MulMatVec_NEON(M, T, Vx, Vy, Vz, shift, lm, MAC, IR);
+#else
+  return MulMatVec_Reference(M, T, Vx, Vy, Vz, shift, lm, MAC, IR);
+#endif
+}
+
+static inline u32 InterpolateColor(const s32 in_MAC[3], const s32 FC[3], s16 IR0, u8 shift, bool lm, s32 MAC[3],
+                                   s32 IR[3])
+{
+#if defined(GTE_KERNELS_SSE2)
+  return InterpolateColor_SSE2(in_MAC, FC, IR0, shift, lm, MAC, IR);
+#elif defined(GTE_KERNELS_NEON)
+  return InterpolateColor_NEON(in_MAC, FC, IR0, shift, lm, MAC, IR);
+#else
+  return InterpolateColor_Reference(in_MAC, FC, IR0, shift, lm, MAC, IR);
+#endif
+}
+
+} // namespace GTEKernels
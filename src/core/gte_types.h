@@ -38,10 +38,24 @@ union FLAGS
 
   static constexpr u32 WRITE_MASK = UINT32_C(0xFFFFF000);
 
+  // Bits 30..23, 18..13
+  static constexpr u32 ERROR_MASK = UINT32_C(0x7F87E000);
+  static constexpr u32 ERROR_BIT = UINT32_C(0x80000000);
+
+  // Flags with the error bit included, for the recompiler.
+  static constexpr u32 MAC0_OVERFLOW_BITS = UINT32_C(0x80010000);
+  static constexpr u32 MAC0_UNDERFLOW_BITS = UINT32_C(0x80008000);
+  static constexpr u32 SZ1_OTZ_SATURATED_BITS = UINT32_C(0x80040000);
+
+  // Flags for MAC1-3/IR1-3 by index, for the recompiler.
+  static constexpr u32 GetMACOverflowBit(u32 index) { return UINT32_C(1) << (31 - index); }
+  static constexpr u32 GetMACUnderflowBit(u32 index) { return UINT32_C(1) << (28 - index); }
+  static constexpr u32 GetIRSaturatedBit(u32 index) { return UINT32_C(1) << (25 - index); }
+
   ALWAYS_INLINE void Clear() { bits = 0; }
 
   // Bits 30..23, 18..13 OR'ed
-  ALWAYS_INLINE void UpdateError() { error = (bits & UINT32_C(0x7F87E000)) != UINT32_C(0); }
+  ALWAYS_INLINE void UpdateError() { error = (bits & ERROR_MASK) != UINT32_C(0); }
 };
 
 union Regs
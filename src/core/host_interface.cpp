@@ -44,6 +44,8 @@ HostInterface::HostInterface()
 
 HostInterface::~HostInterface()
 {
+  WaitForSaveStateWrite();
+
   // system should be shut down prior to the destructor
   Assert(System::IsShutdown() && !m_audio_stream && !m_display);
   Assert(g_host_interface == this);
@@ -57,6 +59,8 @@ bool HostInterface::Initialize()
 
 void HostInterface::Shutdown()
 {
+  WaitForSaveStateWrite();
+
   if (!System::IsShutdown())
     System::Shutdown();
 }
@@ -91,6 +95,9 @@ s32 HostInterface::GetAudioOutputVolume() const
 
 bool HostInterface::BootSystem(const SystemBootParameters& parameters)
 {
+  // we might be resuming from a state which is still being written
+  WaitForSaveStateWrite();
+
   if (!parameters.state_stream)
   {
     if (parameters.filename.empty())
@@ -406,10 +413,18 @@ bool HostInterface::HasAnyBIOSImages()
 
 bool HostInterface::LoadState(const char* filename)
 {
+  WaitForSaveStateWrite();
+
   std::unique_ptr<ByteStream> stream = FileSystem::OpenFile(filename, BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
   if (!stream)
     return false;
 
+  if (System::IsPlayingGPUDump())
+  {
+    ReportError(TranslateString("OSDMessage", "Save states can't be loaded while playing a GPU dump."));
+    return false;
+  }
+
   AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "Loading state from '%s'..."), filename);
 
   if (!System::IsShutdown())
@@ -435,25 +450,69 @@ bool HostInterface::LoadState(const char* filename)
 
 bool HostInterface::SaveState(const char* filename)
 {
-  std::unique_ptr<ByteStream> stream =
-    FileSystem::OpenFile(filename, BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE |
-                                     BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_STREAMED);
-  if (!stream)
+  // Only serialization has to happen on the emulation thread, compression and the disk write happen on a worker.
+  if (System::IsPlayingGPUDump())
+  {
+    ReportError(TranslateString("OSDMessage", "Save states can't be created while playing a GPU dump."));
     return false;
+  }
 
-  const bool result = System::SaveState(stream.get());
-  if (!result)
+  std::unique_ptr<GrowableMemoryByteStream> buffer =
+    ByteStream_CreateGrowableMemoryStream(nullptr, System::MAX_SAVE_STATE_SIZE);
+  if (!System::SaveState(buffer.get()))
   {
     ReportFormattedError(TranslateString("OSDMessage", "Saving state to '%s' failed."), filename);
-    stream->Discard();
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(m_save_state_write_lock);
+  if (m_save_state_write_thread.joinable())
+    m_save_state_write_thread.join();
+
+  m_save_state_write_thread = std::thread(&HostInterface::WriteSaveStateFile, this, std::move(buffer),
+                                          std::string(filename), g_settings.save_state_compression);
+  return true;
+}
+
+void HostInterface::WaitForSaveStateWrite()
+{
+  std::unique_lock<std::mutex> lock(m_save_state_write_lock);
+  if (m_save_state_write_thread.joinable())
+    m_save_state_write_thread.join();
+}
+
+void HostInterface::WriteSaveStateFile(std::unique_ptr<GrowableMemoryByteStream> buffer, std::string filename,
+                                       bool compress)
+{
+  Common::Timer timer;
+
+  std::unique_ptr<ByteStream> stream = FileSystem::OpenFile(
+    filename.c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE |
+                        BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_STREAMED);
+
+  bool result = static_cast<bool>(stream);
+  if (result)
+  {
+    const u32 size = static_cast<u32>(buffer->GetSize());
+    if (compress)
+      result = System::CompressSaveState(buffer->GetMemoryPointer(), size, stream.get());
+    else
+      result = stream->Write2(buffer->GetMemoryPointer(), size);
+  }
+
+  if (!result)
+  {
+    AddFormattedOSDMessage(15.0f, TranslateString("OSDMessage", "Saving state to '%s' failed."), filename.c_str());
+    if (stream)
+      stream->Discard();
   }
   else
   {
-    AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "State saved to '%s'."), filename);
+    AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "State saved to '%s'."), filename.c_str());
     stream->Commit();
   }
 
-  return result;
+  Log_DevPrintf("Writing save state to '%s' took %.2f ms", filename.c_str(), timer.GetTimeMilliseconds());
 }
 
 void HostInterface::OnSystemCreated() {}
@@ -495,19 +554,24 @@ void HostInterface::SetDefaultSettings(SettingsInterface& si)
   si.SetBoolValue("Main", "RewindEnable", false);
   si.SetFloatValue("Main", "RewindFrequency", 10.0f);
   si.SetIntValue("Main", "RewindSaveSlots", 10);
+  si.SetIntValue("Main", "RewindMemoryBudget", 256);
+  si.SetBoolValue("Main", "CompressSaveStates", true);
   si.SetFloatValue("Main", "RunaheadFrameCount", 0);
 
   si.SetStringValue("CPU", "ExecutionMode", Settings::GetCPUExecutionModeName(Settings::DEFAULT_CPU_EXECUTION_MODE));
   si.SetBoolValue("CPU", "RecompilerMemoryExceptions", false);
   si.SetBoolValue("CPU", "ICache", false);
+  si.SetBoolValue("CPU", "RecompilerBlockProfiling", false);
   si.SetBoolValue("CPU", "FastmemMode", Settings::GetCPUFastmemModeName(Settings::DEFAULT_CPU_FASTMEM_MODE));
 
   si.SetStringValue("GPU", "Renderer", Settings::GetRendererName(Settings::DEFAULT_GPU_RENDERER));
   si.SetIntValue("GPU", "ResolutionScale", 1);
   si.SetIntValue("GPU", "Multisamples", 1);
   si.SetBoolValue("GPU", "UseDebugDevice", false);
+  si.SetBoolValue("GPU", "ReorderBatches", false);
   si.SetBoolValue("GPU", "PerSampleShading", false);
   si.SetBoolValue("GPU", "UseThread", true);
+  si.SetIntValue("GPU", "SWRenderThreads", static_cast<int>(Settings::DEFAULT_GPU_SW_RENDER_THREADS));
   si.SetBoolValue("GPU", "ThreadedPresentation", true);
   si.SetBoolValue("GPU", "TrueColor", false);
   si.SetBoolValue("GPU", "ScaledDithering", true);
@@ -543,6 +607,7 @@ void HostInterface::SetDefaultSettings(SettingsInterface& si)
   si.SetBoolValue("Display", "ShowVPS", false);
   si.SetBoolValue("Display", "ShowSpeed", false);
   si.SetBoolValue("Display", "ShowResolution", false);
+  si.SetBoolValue("Display", "ShowFrameTimings", false);
   si.SetBoolValue("Display", "Fullscreen", false);
   si.SetBoolValue("Display", "VSync", true);
   si.SetBoolValue("Display", "DisplayAllFrames", false);
@@ -554,6 +619,8 @@ void HostInterface::SetDefaultSettings(SettingsInterface& si)
   si.SetBoolValue("CDROM", "LoadImageToRAM", false);
   si.SetBoolValue("CDROM", "MuteCDAudio", false);
   si.SetIntValue("CDROM", "ReadSpeedup", 1);
+  si.SetIntValue("CDROM", "CHDHunkCacheSize", static_cast<int>(Settings::DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE));
+  si.SetIntValue("CDROM", "ReadaheadSectors", static_cast<int>(Settings::DEFAULT_CDROM_READAHEAD_SECTORS));
 
   si.SetStringValue("Audio", "Backend", Settings::GetAudioBackendName(Settings::DEFAULT_AUDIO_BACKEND));
   si.SetIntValue("Audio", "OutputVolume", 100);
@@ -562,6 +629,7 @@ void HostInterface::SetDefaultSettings(SettingsInterface& si)
   si.SetBoolValue("Audio", "Resampling", true);
   si.SetIntValue("Audio", "OutputMuted", false);
   si.SetBoolValue("Audio", "Sync", true);
+  si.SetBoolValue("Audio", "DynamicSync", false);
   si.SetBoolValue("Audio", "DumpOnBoot", false);
 
   si.SetStringValue("BIOS", "SearchDirectory", "");
@@ -739,6 +807,9 @@ void HostInterface::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.emulation_speed != old_settings.emulation_speed)
       System::UpdateThrottlePeriod();
 
+    if (g_settings.display_show_frame_timings != old_settings.display_show_frame_timings)
+      System::SetFrameTimingEnabled(g_settings.display_show_frame_timings);
+
     if (g_settings.cpu_execution_mode != old_settings.cpu_execution_mode ||
         g_settings.cpu_fastmem_mode != old_settings.cpu_fastmem_mode)
     {
@@ -771,12 +842,23 @@ void HostInterface::CheckForSettingsChanges(const Settings& old_settings)
       CPU::ClearICache();
     }
 
+    if (g_settings.cpu_execution_mode != CPUExecutionMode::Interpreter &&
+        g_settings.cpu_recompiler_block_profiling != old_settings.cpu_recompiler_block_profiling)
+    {
+      AddOSDMessage(g_settings.cpu_recompiler_block_profiling ?
+                      TranslateStdString("OSDMessage", "Block profiling enabled, flushing all blocks.") :
+                      TranslateStdString("OSDMessage", "Block profiling disabled, flushing all blocks."),
+                    5.0f);
+      CPU::CodeCache::Flush();
+    }
+
     m_audio_stream->SetOutputVolume(GetAudioOutputVolume());
 
     if (g_settings.gpu_resolution_scale != old_settings.gpu_resolution_scale ||
         g_settings.gpu_multisamples != old_settings.gpu_multisamples ||
         g_settings.gpu_per_sample_shading != old_settings.gpu_per_sample_shading ||
         g_settings.gpu_use_thread != old_settings.gpu_use_thread ||
+        g_settings.gpu_sw_render_threads != old_settings.gpu_sw_render_threads ||
         g_settings.gpu_fifo_size != old_settings.gpu_fifo_size ||
         g_settings.gpu_max_run_ahead != old_settings.gpu_max_run_ahead ||
         g_settings.gpu_true_color != old_settings.gpu_true_color ||
@@ -822,8 +904,11 @@ void HostInterface::CheckForSettingsChanges(const Settings& old_settings)
         PGXP::Initialize();
     }
 
-    if (g_settings.cdrom_read_thread != old_settings.cdrom_read_thread)
-      g_cdrom.SetUseReadThread(g_settings.cdrom_read_thread);
+    if (g_settings.cdrom_read_thread != old_settings.cdrom_read_thread ||
+        g_settings.cdrom_readahead_sectors != old_settings.cdrom_readahead_sectors)
+    {
+      g_cdrom.SetReadThread(g_settings.cdrom_read_thread, g_settings.cdrom_readahead_sectors);
+    }
 
     if (g_settings.memory_card_types != old_settings.memory_card_types ||
         g_settings.memory_card_paths != old_settings.memory_card_paths ||
@@ -836,6 +921,7 @@ void HostInterface::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.rewind_enable != old_settings.rewind_enable ||
         g_settings.rewind_save_frequency != old_settings.rewind_save_frequency ||
         g_settings.rewind_save_slots != old_settings.rewind_save_slots ||
+        g_settings.rewind_memory_budget != old_settings.rewind_memory_budget ||
         g_settings.runahead_frames != old_settings.runahead_frames)
     {
       System::UpdateMemorySaveStateSettings();
@@ -1092,6 +1178,21 @@ void HostInterface::RecreateSystem()
 {
   Assert(!System::IsShutdown());
 
+  // GPU dumps can't be saved, so start the replay over instead.
+  if (System::IsPlayingGPUDump())
+  {
+    SystemBootParameters boot_params(System::GetRunningPath());
+    DestroySystem();
+    if (!BootSystem(boot_params))
+    {
+      ReportError("Failed to boot system after recreation.");
+      return;
+    }
+
+    System::ResetPerformanceCounters();
+    return;
+  }
+
   std::unique_ptr<ByteStream> stream = ByteStream_CreateGrowableMemoryStream(nullptr, 8 * 1024);
   if (!System::SaveState(stream.get()) || !stream->SeekAbsolute(0))
   {
@@ -10,12 +10,14 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 enum LOGLEVEL;
 
 class AudioStream;
 class ByteStream;
+class GrowableMemoryByteStream;
 class CDImage;
 class HostDisplay;
 class GameList;
@@ -194,13 +196,24 @@ protected:
   /// Updates software cursor state, based on controllers.
   void UpdateSoftwareCursor();
 
+  /// Saves state to the specified filename. The file is compressed and written asynchronously.
   bool SaveState(const char* filename);
+
+  /// Blocks until any in-progress save state file write completes. Can be called from any thread.
+  void WaitForSaveStateWrite();
+
   void CreateAudioStream();
 
   std::unique_ptr<HostDisplay> m_display;
   std::unique_ptr<AudioStream> m_audio_stream;
   std::string m_program_directory;
   std::string m_user_directory;
+
+private:
+  void WriteSaveStateFile(std::unique_ptr<GrowableMemoryByteStream> buffer, std::string filename, bool compress);
+
+  std::thread m_save_state_write_thread;
+  std::mutex m_save_state_write_lock;
 };
 
 #define TRANSLATABLE(context, str) str
@@ -0,0 +1,214 @@
+#include "input_movie.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "controller.h"
+#include "pad.h"
+#include "settings.h"
+#include <cstdio>
+#include <cstring>
+#include <optional>
+Log_SetChannel(InputMovie);
+
+namespace InputMovie {
+
+static constexpr u32 HEADER_WORDS = 5 + NUM_CONTROLLER_AND_CARD_PORTS;
+
+ControllerTypeArray GetControllerTypes()
+{
+  ControllerTypeArray types;
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+  {
+    const Controller* controller = g_pad.GetController(i);
+    types[i] = controller ? controller->GetType() : ControllerType::None;
+  }
+
+  return types;
+}
+
+void ReleaseControllerInputs()
+{
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+  {
+    Controller* controller = g_pad.GetController(i);
+    if (!controller)
+      continue;
+
+    for (const auto& it : Controller::GetButtonNames(controller->GetType()))
+      controller->SetButtonState(it.second, false);
+    for (const auto& it : Controller::GetAxisNames(controller->GetType()))
+      controller->SetAxisState(std::get<s32>(it), 0.0f);
+  }
+}
+
+Recorder::Recorder(std::string filename, std::vector<u8> start_state)
+  : m_filename(std::move(filename)), m_start_state(std::move(start_state)), m_controller_types(GetControllerTypes())
+{
+}
+
+Recorder::~Recorder() = default;
+
+std::unique_ptr<Recorder> Recorder::Create(const char* filename, std::vector<u8> start_state)
+{
+  // make sure we can write the file now, rather than finding out when recording stops
+  std::FILE* fp = FileSystem::OpenCFile(filename, "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open input movie '%s' for writing", filename);
+    return {};
+  }
+  std::fclose(fp);
+
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+  {
+    const Controller* controller = g_pad.GetController(i);
+    if (controller && (controller->GetType() == ControllerType::NamcoGunCon ||
+                       controller->GetType() == ControllerType::PlayStationMouse))
+    {
+      Log_WarningPrintf("%s in port %u reads the host pointer directly, its movement will not be recorded",
+                        Settings::GetControllerTypeName(controller->GetType()), i + 1u);
+    }
+  }
+
+  return std::unique_ptr<Recorder>(new Recorder(filename, std::move(start_state)));
+}
+
+void Recorder::AddButtonEvent(u32 frame, u32 slot, s32 button_code, bool pressed)
+{
+  m_events.push_back(FileEvent{frame, static_cast<u8>(slot), EventType::Button, static_cast<u16>(button_code),
+                               pressed ? 1.0f : 0.0f});
+}
+
+void Recorder::AddAxisEvent(u32 frame, u32 slot, s32 axis_code, float value)
+{
+  m_events.push_back(FileEvent{frame, static_cast<u8>(slot), EventType::Axis, static_cast<u16>(axis_code), value});
+}
+
+bool Recorder::Close(u32 frame_count)
+{
+  std::FILE* fp = FileSystem::OpenCFile(m_filename.c_str(), "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open input movie '%s' for writing", m_filename.c_str());
+    return false;
+  }
+
+  u32 header[HEADER_WORDS] = {FILE_MAGIC, FILE_VERSION, frame_count, static_cast<u32>(m_events.size()),
+                              static_cast<u32>(m_start_state.size())};
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+    header[5 + i] = static_cast<u32>(m_controller_types[i]);
+
+  bool result = (std::fwrite(header, sizeof(header), 1, fp) == 1 &&
+                 std::fwrite(m_start_state.data(), m_start_state.size(), 1, fp) == 1);
+  if (result && !m_events.empty())
+    result = (std::fwrite(m_events.data(), sizeof(FileEvent), m_events.size(), fp) == m_events.size());
+  result &= (std::fclose(fp) == 0);
+
+  if (result)
+  {
+    Log_InfoPrintf("Wrote %u frames and %zu input events to input movie '%s'", frame_count, m_events.size(),
+                   m_filename.c_str());
+  }
+  else
+  {
+    Log_ErrorPrintf("Failed to write input movie '%s'", m_filename.c_str());
+  }
+
+  return result;
+}
+
+Player::Player(std::string filename, std::vector<u8> start_state, std::vector<FileEvent> events,
+               const ControllerTypeArray& controller_types, u32 frame_count)
+  : m_filename(std::move(filename)), m_start_state(std::move(start_state)), m_events(std::move(events)),
+    m_controller_types(controller_types), m_frame_count(frame_count)
+{
+}
+
+Player::~Player() = default;
+
+std::unique_ptr<Player> Player::Open(const char* filename)
+{
+  std::optional<std::vector<u8>> bytes = FileSystem::ReadBinaryFile(filename);
+  if (!bytes.has_value())
+  {
+    Log_ErrorPrintf("Failed to read input movie '%s'", filename);
+    return {};
+  }
+
+  u32 header[HEADER_WORDS];
+  if (bytes->size() < sizeof(header))
+  {
+    Log_ErrorPrintf("Input movie '%s' is truncated", filename);
+    return {};
+  }
+
+  std::memcpy(header, bytes->data(), sizeof(header));
+  if (header[0] != FILE_MAGIC || header[1] != FILE_VERSION)
+  {
+    Log_ErrorPrintf("Input movie '%s' has an invalid header or unsupported version", filename);
+    return {};
+  }
+
+  const u32 frame_count = header[2];
+  const u32 event_count = header[3];
+  const u32 state_size = header[4];
+  const u64 expected_size = static_cast<u64>(state_size) + static_cast<u64>(event_count) * sizeof(FileEvent);
+  if ((bytes->size() - sizeof(header)) != expected_size)
+  {
+    Log_ErrorPrintf("Input movie '%s' is truncated", filename);
+    return {};
+  }
+
+  ControllerTypeArray controller_types;
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+  {
+    if (header[5 + i] >= static_cast<u32>(ControllerType::Count))
+    {
+      Log_ErrorPrintf("Input movie '%s' has an invalid controller type in port %u", filename, i + 1u);
+      return {};
+    }
+
+    controller_types[i] = static_cast<ControllerType>(header[5 + i]);
+  }
+
+  const u8* state_data = bytes->data() + sizeof(header);
+  std::vector<u8> start_state(state_data, state_data + state_size);
+
+  std::vector<FileEvent> events(event_count);
+  if (event_count > 0)
+    std::memcpy(events.data(), state_data + state_size, event_count * sizeof(FileEvent));
+
+  // validate events now, so playback doesn't have to
+  for (u32 i = 0; i < event_count; i++)
+  {
+    const FileEvent& event = events[i];
+    if (event.slot >= NUM_CONTROLLER_AND_CARD_PORTS ||
+        (event.type != EventType::Button && event.type != EventType::Axis) || event.frame > frame_count ||
+        (i > 0 && event.frame < events[i - 1].frame))
+    {
+      Log_ErrorPrintf("Input movie '%s' has an invalid event at index %u", filename, i);
+      return {};
+    }
+  }
+
+  Log_InfoPrintf("Loaded input movie '%s' with %u frames and %u input events", filename, frame_count, event_count);
+  return std::unique_ptr<Player>(
+    new Player(filename, std::move(start_state), std::move(events), controller_types, frame_count));
+}
+
+void Player::ApplyEvents(u32 frame)
+{
+  for (; m_position < m_events.size() && m_events[m_position].frame <= frame; m_position++)
+  {
+    const FileEvent& event = m_events[m_position];
+    Controller* controller = g_pad.GetController(event.slot);
+    if (!controller)
+      continue;
+
+    if (event.type == EventType::Button)
+      controller->SetButtonState(static_cast<s32>(event.code), event.value != 0.0f);
+    else
+      controller->SetAxisState(static_cast<s32>(event.code), event.value);
+  }
+}
+
+} // namespace InputMovie
@@ -0,0 +1,105 @@
+#pragma once
+#include "types.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Input movies record the controller input for a section of gameplay, so it can be replayed deterministically, e.g.
+// to benchmark the same sequence of frames on different builds.
+//
+// File layout, all values little-endian:
+//   u32 magic ('DMOV'), u32 version, u32 frame_count, u32 event_count, u32 state_size,
+//   u32 controller type for each port,
+//   state_size bytes of save state, which playback starts from,
+//   event_count events (FileEvent), sorted by frame.
+//
+// Events are applied at the start of the frame they were recorded in, relative to the start of the movie. Inputs are
+// released at the start of recording and playback, so held buttons don't leak in from the host.
+namespace InputMovie {
+
+enum : u32
+{
+  FILE_MAGIC = 0x564F4D44, // DMOV
+  FILE_VERSION = 1,
+};
+
+enum class EventType : u8
+{
+  Button = 0, // value is 0 or 1
+  Axis = 1,   // value is the float passed to SetAxisState()
+};
+
+#pragma pack(push, 1)
+struct FileEvent
+{
+  u32 frame;
+  u8 slot;
+  EventType type;
+  u16 code;
+  float value;
+};
+#pragma pack(pop)
+static_assert(sizeof(FileEvent) == 12, "FileEvent is packed");
+
+using ControllerTypeArray = std::array<ControllerType, NUM_CONTROLLER_AND_CARD_PORTS>;
+
+/// Returns the types of the controllers currently connected.
+ControllerTypeArray GetControllerTypes();
+
+/// Releases every button and centers every axis of the connected controllers.
+void ReleaseControllerInputs();
+
+class Recorder
+{
+public:
+  ~Recorder();
+
+  static std::unique_ptr<Recorder> Create(const char* filename, std::vector<u8> start_state);
+
+  ALWAYS_INLINE const std::string& GetFileName() const { return m_filename; }
+
+  void AddButtonEvent(u32 frame, u32 slot, s32 button_code, bool pressed);
+  void AddAxisEvent(u32 frame, u32 slot, s32 axis_code, float value);
+
+  /// Writes the movie to the file, returns false if it could not be written.
+  bool Close(u32 frame_count);
+
+private:
+  Recorder(std::string filename, std::vector<u8> start_state);
+
+  std::string m_filename;
+  std::vector<u8> m_start_state;
+  std::vector<FileEvent> m_events;
+  ControllerTypeArray m_controller_types;
+};
+
+class Player
+{
+public:
+  ~Player();
+
+  static std::unique_ptr<Player> Open(const char* filename);
+
+  ALWAYS_INLINE const std::string& GetFileName() const { return m_filename; }
+  ALWAYS_INLINE const std::vector<u8>& GetStartState() const { return m_start_state; }
+  ALWAYS_INLINE const ControllerTypeArray& GetControllerTypes() const { return m_controller_types; }
+  ALWAYS_INLINE u32 GetFrameCount() const { return m_frame_count; }
+  ALWAYS_INLINE bool IsFinished(u32 frame) const { return (frame >= m_frame_count); }
+
+  /// Applies the events recorded up to and including the specified frame.
+  void ApplyEvents(u32 frame);
+
+private:
+  Player(std::string filename, std::vector<u8> start_state, std::vector<FileEvent> events,
+         const ControllerTypeArray& controller_types, u32 frame_count);
+
+  std::string m_filename;
+  std::vector<u8> m_start_state;
+  std::vector<FileEvent> m_events;
+  ControllerTypeArray m_controller_types;
+  u32 m_frame_count;
+  size_t m_position = 0;
+};
+
+} // namespace InputMovie
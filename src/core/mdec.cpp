@@ -4,6 +4,7 @@
 #include "cpu_core.h"
 #include "dma.h"
 #include "interrupt_controller.h"
+#include "mdec_kernels.h"
 #include "system.h"
 #ifdef WITH_IMGUI
 #include "imgui.h"
@@ -234,6 +235,8 @@ void MDEC::WriteCommandRegister(u32 value)
 
 void MDEC::Execute()
 {
+  System::ScopedFrameTiming frame_timing(System::FrameTimingComponent::MDEC);
+
   for (;;)
   {
     switch (m_state)
@@ -622,72 +625,18 @@ bool MDEC::rl_decode_block(s16* blk, const u8* qt)
 
 void MDEC::IDCT(s16* blk)
 {
-  std::array<s64, 64> temp_buffer;
-  for (u32 x = 0; x < 8; x++)
-  {
-    for (u32 y = 0; y < 8; y++)
-    {
-      s64 sum = 0;
-      for (u32 u = 0; u < 8; u++)
-        sum += s32(blk[u * 8 + x]) * s32(m_scale_table[u * 8 + y]);
-      temp_buffer[x + y * 8] = sum;
-    }
-  }
-  for (u32 x = 0; x < 8; x++)
-  {
-    for (u32 y = 0; y < 8; y++)
-    {
-      s64 sum = 0;
-      for (u32 u = 0; u < 8; u++)
-        sum += s64(temp_buffer[u + y * 8]) * s32(m_scale_table[u * 8 + x]);
-
-      blk[x + y * 8] =
-        static_cast<s16>(std::clamp<s32>(SignExtendN<9, s32>((sum >> 32) + ((sum >> 31) & 1)), -128, 127));
-    }
-  }
+  MDECKernels::IDCT(blk, m_scale_table.data());
 }
 
 void MDEC::yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
                       const std::array<s16, 64>& Yblk)
 {
-  for (u32 y = 0; y < 8; y++)
-  {
-    for (u32 x = 0; x < 8; x++)
-    {
-      s16 R = Crblk[((x + xx) / 2) + ((y + yy) / 2) * 8];
-      s16 B = Cbblk[((x + xx) / 2) + ((y + yy) / 2) * 8];
-      s16 G = static_cast<s16>((-0.3437f * static_cast<float>(B)) + (-0.7143f * static_cast<float>(R)));
-
-      R = static_cast<s16>(1.402f * static_cast<float>(R));
-      B = static_cast<s16>(1.772f * static_cast<float>(B));
-
-      s16 Y = Yblk[x + y * 8];
-      R = static_cast<s16>(std::clamp(static_cast<int>(Y) + R, -128, 127));
-      G = static_cast<s16>(std::clamp(static_cast<int>(Y) + G, -128, 127));
-      B = static_cast<s16>(std::clamp(static_cast<int>(Y) + B, -128, 127));
-
-      // TODO: Signed output
-      R += 128;
-      G += 128;
-      B += 128;
-
-      m_block_rgb[(x + xx) + ((y + yy) * 16)] = ZeroExtend32(static_cast<u16>(R)) |
-                                                (ZeroExtend32(static_cast<u16>(G)) << 8) |
-                                                (ZeroExtend32(static_cast<u16>(B)) << 16);
-    }
-  }
+  MDECKernels::YUVToRGB(m_block_rgb.data(), xx, yy, Crblk.data(), Cbblk.data(), Yblk.data());
 }
 
 void MDEC::y_to_mono(const std::array<s16, 64>& Yblk)
 {
-  for (u32 i = 0; i < 64; i++)
-  {
-    s16 Y = Yblk[i];
-    Y = SignExtendN<10, s16>(Y);
-    Y = std::clamp<s16>(Y, -128, 127);
-    Y += 128;
-    m_block_rgb[i] = static_cast<u32>(Y) & 0xFF;
-  }
+  MDECKernels::YToMono(m_block_rgb.data(), Yblk.data());
 }
 
 void MDEC::HandleSetQuantTableCommand()
@@ -0,0 +1,388 @@
+#pragma once
+#include "common/cpu_detect.h"
+#include "types.h"
+#include <algorithm>
+#include <array>
+
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#define MDEC_KERNELS_SSE2 1
+#elif defined(CPU_AARCH64) && defined(WITH_NEON_KERNELS)
+// Not yet verified against the reference versions on hardware, so only used when explicitly requested.
+#include <arm_neon.h>
+#define MDEC_KERNELS_NEON 1
+#endif
+
+// IDCT and colour conversion for the MDEC. These are kept separate from the MDEC class so that the vectorized
+// versions can be tested against the reference versions. The vectorized versions must be bit-exact with the
+// reference versions for all inputs the MDEC can produce. That includes the rounding of the colour conversion, so
+// anything including this header must be compiled without floating-point contraction (-ffp-contract=off).
+namespace MDECKernels {
+
+// Reference versions, from nocash spec.
+
+/// Coefficients must be in the range [-0x400, 0x3FF], as written by the run-length decoder.
+static inline void IDCT_Reference(s16* blk, const s16* scale_table)
+{
+  std::array<s64, 64> temp_buffer;
+  for (u32 x = 0; x < 8; x++)
+  {
+    for (u32 y = 0; y < 8; y++)
+    {
+      s64 sum = 0;
+      for (u32 u = 0; u < 8; u++)
+        sum += s32(blk[u * 8 + x]) * s32(scale_table[u * 8 + y]);
+      temp_buffer[x + y * 8] = sum;
+    }
+  }
+  for (u32 x = 0; x < 8; x++)
+  {
+    for (u32 y = 0; y < 8; y++)
+    {
+      s64 sum = 0;
+      for (u32 u = 0; u < 8; u++)
+        sum += s64(temp_buffer[u + y * 8]) * s32(scale_table[u * 8 + x]);
+
+      blk[x + y * 8] =
+        static_cast<s16>(std::clamp<s32>(SignExtendN<9, s32>((sum >> 32) + ((sum >> 31) & 1)), -128, 127));
+    }
+  }
+}
+
+/// Writes one 8x8 quadrant of the 16x16 output block. Inputs must be in the range [-128, 127], as written by the IDCT.
+static inline void YUVToRGB_Reference(u32* rgb_out, u32 xx, u32 yy, const s16* Crblk, const s16* Cbblk,
+                                      const s16* Yblk)
+{
+  for (u32 y = 0; y < 8; y++)
+  {
+    for (u32 x = 0; x < 8; x++)
+    {
+      s16 R = Crblk[((x + xx) / 2) + ((y + yy) / 2) * 8];
+      s16 B = Cbblk[((x + xx) / 2) + ((y + yy) / 2) * 8];
+      s16 G = static_cast<s16>((-0.3437f * static_cast<float>(B)) + (-0.7143f * static_cast<float>(R)));
+
+      R = static_cast<s16>(1.402f * static_cast<float>(R));
+      B = static_cast<s16>(1.772f * static_cast<float>(B));
+
+      s16 Y = Yblk[x + y * 8];
+      R = static_cast<s16>(std::clamp(static_cast<int>(Y) + R, -128, 127));
+      G = static_cast<s16>(std::clamp(static_cast<int>(Y) + G, -128, 127));
+      B = static_cast<s16>(std::clamp(static_cast<int>(Y) + B, -128, 127));
+
+      // TODO: Signed output
+      R += 128;
+      G += 128;
+      B += 128;
+
+      rgb_out[(x + xx) + ((y + yy) * 16)] = ZeroExtend32(static_cast<u16>(R)) |
+                                            (ZeroExtend32(static_cast<u16>(G)) << 8) |
+                                            (ZeroExtend32(static_cast<u16>(B)) << 16);
+    }
+  }
+}
+
+static inline void YToMono_Reference(u32* mono_out, const s16* Yblk)
+{
+  for (u32 i = 0; i < 64; i++)
+  {
+    s16 Y = Yblk[i];
+    Y = SignExtendN<10, s16>(Y);
+    Y = std::clamp<s16>(Y, -128, 127);
+    Y += 128;
+    mono_out[i] = static_cast<u32>(Y) & 0xFF;
+  }
+}
+
+#if defined(MDEC_KERNELS_SSE2)
+
+static inline void IDCT_SSE2(s16* blk, const s16* scale_table)
+{
+  // Rows 2n and 2n+1 are interleaved, so that each _mm_madd_epi16() sums two terms of the dot product.
+  __m128i blk_pairs[4][2];
+  __m128i scale_pairs[4][2];
+  for (u32 i = 0; i < 4; i++)
+  {
+    const __m128i blk_row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&blk[(i * 2) * 8]));
+    const __m128i blk_row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&blk[(i * 2 + 1) * 8]));
+    blk_pairs[i][0] = _mm_unpacklo_epi16(blk_row0, blk_row1);
+    blk_pairs[i][1] = _mm_unpackhi_epi16(blk_row0, blk_row1);
+
+    const __m128i scale_row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&scale_table[(i * 2) * 8]));
+    const __m128i scale_row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&scale_table[(i * 2 + 1) * 8]));
+    scale_pairs[i][0] = _mm_unpacklo_epi16(scale_row0, scale_row1);
+    scale_pairs[i][1] = _mm_unpackhi_epi16(scale_row0, scale_row1);
+  }
+
+  // First pass. The coefficients are 11-bit, so the sums fit in 29 bits.
+  __m128i temp[8][2];
+  for (u32 y = 0; y < 8; y++)
+  {
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+    for (u32 i = 0; i < 4; i++)
+    {
+      const u32 scale0 = ZeroExtend32(static_cast<u16>(scale_table[(i * 2) * 8 + y]));
+      const u32 scale1 = ZeroExtend32(static_cast<u16>(scale_table[(i * 2 + 1) * 8 + y]));
+      const __m128i scale = _mm_set1_epi32(static_cast<s32>(scale0 | (scale1 << 16)));
+      sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(blk_pairs[i][0], scale));
+      sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(blk_pairs[i][1], scale));
+    }
+
+    temp[y][0] = sum0;
+    temp[y][1] = sum1;
+  }
+
+  // Second pass. The reference version needs 47 bits for the sum, but only bits 31 to 40 of it affect the result.
+  // Splitting the first pass results into hi * 2^15 + lo lets us compute the sum as H * 2^15 + L with 16-bit
+  // multiplies, where H only has to be correct modulo 2^26, so it can wrap.
+  const __m128i lo_mask = _mm_set1_epi32(0x7FFF);
+  for (u32 y = 0; y < 8; y++)
+  {
+    const __m128i hi = _mm_packs_epi32(_mm_srai_epi32(temp[y][0], 15), _mm_srai_epi32(temp[y][1], 15));
+    const __m128i lo = _mm_packs_epi32(_mm_and_si128(temp[y][0], lo_mask), _mm_and_si128(temp[y][1], lo_mask));
+    const __m128i hi_pairs[4] = {_mm_shuffle_epi32(hi, _MM_SHUFFLE(0, 0, 0, 0)),
+                                 _mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 1, 1, 1)),
+                                 _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 2, 2, 2)),
+                                 _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 3, 3, 3))};
+    const __m128i lo_pairs[4] = {_mm_shuffle_epi32(lo, _MM_SHUFFLE(0, 0, 0, 0)),
+                                 _mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 1, 1, 1)),
+                                 _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 2, 2, 2)),
+                                 _mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 3, 3, 3))};
+
+    __m128i h[2], l[2];
+    for (u32 half = 0; half < 2; half++)
+    {
+      h[half] = _mm_setzero_si128();
+      l[half] = _mm_setzero_si128();
+      for (u32 i = 0; i < 4; i++)
+      {
+        h[half] = _mm_add_epi32(h[half], _mm_madd_epi16(scale_pairs[i][half], hi_pairs[i]));
+
+        // each pair of low products fits in 32 bits, but the sum of all of them doesn't
+        const __m128i lo_product = _mm_madd_epi16(scale_pairs[i][half], lo_pairs[i]);
+        h[half] = _mm_add_epi32(h[half], _mm_srai_epi32(lo_product, 15));
+        l[half] = _mm_add_epi32(l[half], _mm_and_si128(lo_product, lo_mask));
+      }
+
+      // round by adding 2^31 (2^16 in H), then take bits 32 to 40 (17 to 25 in H) sign-extended
+      h[half] = _mm_add_epi32(_mm_add_epi32(h[half], _mm_set1_epi32(0x10000)), _mm_srli_epi32(l[half], 15));
+      h[half] = _mm_srai_epi32(_mm_slli_epi32(h[half], 6), 23);
+    }
+
+    __m128i result = _mm_packs_epi32(h[0], h[1]);
+    result = _mm_min_epi16(_mm_max_epi16(result, _mm_set1_epi16(-128)), _mm_set1_epi16(127));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&blk[y * 8]), result);
+  }
+}
+
+static inline void YUVToRGB_SSE2(u32* rgb_out, u32 xx, u32 yy, const s16* Crblk, const s16* Cbblk, const s16* Yblk)
+{
+  const __m128i min_value = _mm_set1_epi16(-128);
+  const __m128i max_value = _mm_set1_epi16(127);
+  const __m128i bias = _mm_set1_epi16(128);
+
+  // each chroma row covers two luma rows
+  for (u32 cy = 0; cy < 4; cy++)
+  {
+    const u32 chroma_offset = (xx / 2) + ((yy / 2) + cy) * 8;
+    const __m128i Cr = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&Crblk[chroma_offset]));
+    const __m128i Cb = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&Cbblk[chroma_offset]));
+    const __m128 fR = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(Cr, Cr), 16));
+    const __m128 fB = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(Cb, Cb), 16));
+
+    const __m128i G32 = _mm_cvttps_epi32(
+      _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.3437f), fB), _mm_mul_ps(_mm_set1_ps(-0.7143f), fR)));
+    const __m128i R32 = _mm_cvttps_epi32(_mm_mul_ps(_mm_set1_ps(1.402f), fR));
+    const __m128i B32 = _mm_cvttps_epi32(_mm_mul_ps(_mm_set1_ps(1.772f), fB));
+
+    // duplicate horizontally, since each chroma sample covers two pixels
+    const __m128i R16 = _mm_packs_epi32(R32, R32);
+    const __m128i G16 = _mm_packs_epi32(G32, G32);
+    const __m128i B16 = _mm_packs_epi32(B32, B32);
+    const __m128i R = _mm_unpacklo_epi16(R16, R16);
+    const __m128i G = _mm_unpacklo_epi16(G16, G16);
+    const __m128i B = _mm_unpacklo_epi16(B16, B16);
+
+    for (u32 row = 0; row < 2; row++)
+    {
+      const u32 y = cy * 2 + row;
+      const __m128i Y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Yblk[y * 8]));
+      const __m128i out_R =
+        _mm_add_epi16(_mm_min_epi16(_mm_max_epi16(_mm_add_epi16(Y, R), min_value), max_value), bias);
+      const __m128i out_G =
+        _mm_add_epi16(_mm_min_epi16(_mm_max_epi16(_mm_add_epi16(Y, G), min_value), max_value), bias);
+      const __m128i out_B =
+        _mm_add_epi16(_mm_min_epi16(_mm_max_epi16(_mm_add_epi16(Y, B), min_value), max_value), bias);
+
+      const __m128i RG = _mm_or_si128(out_R, _mm_slli_epi16(out_G, 8));
+      u32* out_ptr = &rgb_out[xx + (yy + y) * 16];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ptr), _mm_unpacklo_epi16(RG, out_B));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ptr + 4), _mm_unpackhi_epi16(RG, out_B));
+    }
+  }
+}
+
+static inline void YToMono_SSE2(u32* mono_out, const s16* Yblk)
+{
+  for (u32 i = 0; i < 64; i += 8)
+  {
+    // SignExtendN<10> in the reference version doesn't truncate, since the shift is done after integer promotion
+    __m128i Y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Yblk[i]));
+    Y = _mm_min_epi16(_mm_max_epi16(Y, _mm_set1_epi16(-128)), _mm_set1_epi16(127));
+    Y = _mm_add_epi16(Y, _mm_set1_epi16(128));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&mono_out[i]), _mm_unpacklo_epi16(Y, _mm_setzero_si128()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&mono_out[i + 4]), _mm_unpackhi_epi16(Y, _mm_setzero_si128()));
+  }
+}
+
+#elif defined(MDEC_KERNELS_NEON)
+
+static inline void IDCT_NEON(s16* blk, const s16* scale_table)
+{
+  // First pass. The coefficients are 11-bit, so the sums fit in 29 bits.
+  std::array<s32, 64> temp_buffer;
+  for (u32 y = 0; y < 8; y++)
+  {
+    int32x4_t sum0 = vdupq_n_s32(0);
+    int32x4_t sum1 = vdupq_n_s32(0);
+    for (u32 u = 0; u < 8; u++)
+    {
+      const int16x8_t row = vld1q_s16(&blk[u * 8]);
+      const s16 scale = scale_table[u * 8 + y];
+      sum0 = vmlal_n_s16(sum0, vget_low_s16(row), scale);
+      sum1 = vmlal_n_s16(sum1, vget_high_s16(row), scale);
+    }
+
+    vst1q_s32(&temp_buffer[y * 8], sum0);
+    vst1q_s32(&temp_buffer[y * 8 + 4], sum1);
+  }
+
+  // Second pass, with 64-bit sums.
+  const int64x2_t round = vdupq_n_s64(INT64_C(1) << 31);
+  for (u32 y = 0; y < 8; y++)
+  {
+    int64x2_t sum[4] = {vdupq_n_s64(0), vdupq_n_s64(0), vdupq_n_s64(0), vdupq_n_s64(0)};
+    for (u32 u = 0; u < 8; u++)
+    {
+      const int16x8_t row = vld1q_s16(&scale_table[u * 8]);
+      const int32x4_t row_lo = vmovl_s16(vget_low_s16(row));
+      const int32x4_t row_hi = vmovl_s16(vget_high_s16(row));
+      const s32 temp = temp_buffer[u + y * 8];
+      sum[0] = vmlal_n_s32(sum[0], vget_low_s32(row_lo), temp);
+      sum[1] = vmlal_n_s32(sum[1], vget_high_s32(row_lo), temp);
+      sum[2] = vmlal_n_s32(sum[2], vget_low_s32(row_hi), temp);
+      sum[3] = vmlal_n_s32(sum[3], vget_high_s32(row_hi), temp);
+    }
+
+    int32x4_t result_lo =
+      vcombine_s32(vshrn_n_s64(vaddq_s64(sum[0], round), 32), vshrn_n_s64(vaddq_s64(sum[1], round), 32));
+    int32x4_t result_hi =
+      vcombine_s32(vshrn_n_s64(vaddq_s64(sum[2], round), 32), vshrn_n_s64(vaddq_s64(sum[3], round), 32));
+    result_lo = vshrq_n_s32(vshlq_n_s32(result_lo, 23), 23);
+    result_hi = vshrq_n_s32(vshlq_n_s32(result_hi, 23), 23);
+
+    int16x8_t result = vcombine_s16(vmovn_s32(result_lo), vmovn_s32(result_hi));
+    result = vminq_s16(vmaxq_s16(result, vdupq_n_s16(-128)), vdupq_n_s16(127));
+    vst1q_s16(&blk[y * 8], result);
+  }
+}
+
+static inline void YUVToRGB_NEON(u32* rgb_out, u32 xx, u32 yy, const s16* Crblk, const s16* Cbblk, const s16* Yblk)
+{
+  const int16x8_t min_value = vdupq_n_s16(-128);
+  const int16x8_t max_value = vdupq_n_s16(127);
+  const int16x8_t bias = vdupq_n_s16(128);
+
+  // each chroma row covers two luma rows
+  for (u32 cy = 0; cy < 4; cy++)
+  {
+    const u32 chroma_offset = (xx / 2) + ((yy / 2) + cy) * 8;
+    const float32x4_t fR = vcvtq_f32_s32(vmovl_s16(vld1_s16(&Crblk[chroma_offset])));
+    const float32x4_t fB = vcvtq_f32_s32(vmovl_s16(vld1_s16(&Cbblk[chroma_offset])));
+
+    // separate multiply and add, the reference version is compiled without floating-point contraction
+    const float32x4_t fG_B = vmulq_f32(vdupq_n_f32(-0.3437f), fB);
+    const float32x4_t fG_R = vmulq_f32(vdupq_n_f32(-0.7143f), fR);
+    const int16x4_t G16 = vmovn_s32(vcvtq_s32_f32(vaddq_f32(fG_B, fG_R)));
+    const int16x4_t R16 = vmovn_s32(vcvtq_s32_f32(vmulq_f32(vdupq_n_f32(1.402f), fR)));
+    const int16x4_t B16 = vmovn_s32(vcvtq_s32_f32(vmulq_f32(vdupq_n_f32(1.772f), fB)));
+
+    // duplicate horizontally, since each chroma sample covers two pixels
+    const int16x4x2_t R_zip = vzip_s16(R16, R16);
+    const int16x4x2_t G_zip = vzip_s16(G16, G16);
+    const int16x4x2_t B_zip = vzip_s16(B16, B16);
+    const int16x8_t R = vcombine_s16(R_zip.val[0], R_zip.val[1]);
+    const int16x8_t G = vcombine_s16(G_zip.val[0], G_zip.val[1]);
+    const int16x8_t B = vcombine_s16(B_zip.val[0], B_zip.val[1]);
+
+    for (u32 row = 0; row < 2; row++)
+    {
+      const u32 y = cy * 2 + row;
+      const int16x8_t Y = vld1q_s16(&Yblk[y * 8]);
+      const uint16x8_t out_R =
+        vreinterpretq_u16_s16(vaddq_s16(vminq_s16(vmaxq_s16(vaddq_s16(Y, R), min_value), max_value), bias));
+      const uint16x8_t out_G =
+        vreinterpretq_u16_s16(vaddq_s16(vminq_s16(vmaxq_s16(vaddq_s16(Y, G), min_value), max_value), bias));
+      const uint16x8_t out_B =
+        vreinterpretq_u16_s16(vaddq_s16(vminq_s16(vmaxq_s16(vaddq_s16(Y, B), min_value), max_value), bias));
+
+      const uint16x8_t RG = vorrq_u16(out_R, vshlq_n_u16(out_G, 8));
+      const uint16x8x2_t RGB = vzipq_u16(RG, out_B);
+      u32* out_ptr = &rgb_out[xx + (yy + y) * 16];
+      vst1q_u32(out_ptr, vreinterpretq_u32_u16(RGB.val[0]));
+      vst1q_u32(out_ptr + 4, vreinterpretq_u32_u16(RGB.val[1]));
+    }
+  }
+}
+
+static inline void YToMono_NEON(u32* mono_out, const s16* Yblk)
+{
+  for (u32 i = 0; i < 64; i += 8)
+  {
+    // SignExtendN<10> in the reference version doesn't truncate, since the shift is done after integer promotion
+    int16x8_t Y = vld1q_s16(&Yblk[i]);
+    Y = vminq_s16(vmaxq_s16(Y, vdupq_n_s16(-128)), vdupq_n_s16(127));
+    Y = vaddq_s16(Y, vdupq_n_s16(128));
+
+    const uint16x8_t Y16 = vreinterpretq_u16_s16(Y);
+    vst1q_u32(&mono_out[i], vmovl_u16(vget_low_u16(Y16)));
+    vst1q_u32(&mono_out[i + 4], vmovl_u16(vget_high_u16(Y16)));
+  }
+}
+
+#endif
+
+static inline void IDCT(s16* blk, const s16* scale_table)
+{
+#if defined(MDEC_KERNELS_SSE2)
+  IDCT_SSE2(blk, scale_table);
+#elif defined(MDEC_KERNELS_NEON)
+  IDCT_NEON(blk, scale_table);
+#else
+  IDCT_Reference(blk, scale_table);
+#endif
+}
+
+static inline void YUVToRGB(u32* rgb_out, u32 xx, u32 yy, const s16* Crblk, const s16* Cbblk, const s16* Yblk)
+{
+#if defined(MDEC_KERNELS_SSE2)
+  YUVToRGB_SSE2(rgb_out, xx, yy, Crblk, Cbblk, Yblk);
+#elif defined(MDEC_KERNELS_NEON)
+  YUVToRGB_NEON(rgb_out, xx, yy, Crblk, Cbblk, Yblk);
+#else
+  YUVToRGB_Reference(rgb_out, xx, yy, Crblk, Cbblk, Yblk);
+#endif
+}
+
+static inline void YToMono(u32* mono_out, const s16* Yblk)
+{
+#if defined(MDEC_KERNELS_SSE2)
+  YToMono_SSE2(mono_out, Yblk);
+#elif defined(MDEC_KERNELS_NEON)
+  YToMono_NEON(mono_out, Yblk);
+#else
+  YToMono_Reference(mono_out, Yblk);
+#endif
+}
+
+} // namespace MDECKernels
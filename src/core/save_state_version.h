@@ -2,7 +2,7 @@
 #include "types.h"
 
 static constexpr u32 SAVE_STATE_MAGIC = 0x43435544;
-static constexpr u32 SAVE_STATE_VERSION = 48;
+static constexpr u32 SAVE_STATE_VERSION = 49;
 static constexpr u32 SAVE_STATE_MINIMUM_VERSION = 42;
 
 static_assert(SAVE_STATE_VERSION >= SAVE_STATE_MINIMUM_VERSION);
@@ -16,6 +16,12 @@ struct SAVE_STATE_HEADER
     MAX_GAME_CODE_LENGTH = 32
   };
 
+  enum : u32
+  {
+    COMPRESSION_TYPE_NONE = 0,
+    COMPRESSION_TYPE_ZLIB = 1
+  };
+
   u32 magic;
   u32 version;
   char title[MAX_TITLE_LENGTH];
@@ -78,6 +78,7 @@ struct Settings
   bool cpu_overclock_active = false;
   bool cpu_recompiler_memory_exceptions = false;
   bool cpu_recompiler_icache = false;
+  bool cpu_recompiler_block_profiling = false;
   CPUFastmemMode cpu_fastmem_mode = CPUFastmemMode::Disabled;
 
   float emulation_speed = 1.0f;
@@ -89,6 +90,7 @@ struct Settings
   bool start_fullscreen = false;
   bool pause_on_focus_loss = false;
   bool save_state_on_exit = true;
+  bool save_state_compression = true;
   bool confim_power_off = true;
   bool load_devices_from_save_states = false;
   bool apply_game_settings = true;
@@ -98,6 +100,7 @@ struct Settings
   bool rewind_enable = false;
   float rewind_save_frequency = 10.0f;
   u32 rewind_save_slots = 10;
+  u32 rewind_memory_budget = 256; // in megabytes
   u32 runahead_frames = 0;
 
   GPURenderer gpu_renderer = GPURenderer::Software;
@@ -106,8 +109,10 @@ struct Settings
   u32 gpu_resolution_scale = 1;
   u32 gpu_multisamples = 1;
   bool gpu_use_thread = true;
+  u32 gpu_sw_render_threads = DEFAULT_GPU_SW_RENDER_THREADS;
   bool gpu_threaded_presentation = true;
   bool gpu_use_debug_device = false;
+  bool gpu_reorder_batches = false;
   bool gpu_per_sample_shading = false;
   bool gpu_true_color = true;
   bool gpu_scaled_dithering = false;
@@ -139,6 +144,7 @@ struct Settings
   bool display_show_vps = false;
   bool display_show_speed = false;
   bool display_show_resolution = false;
+  bool display_show_frame_timings = false;
   bool display_all_frames = false;
   bool video_sync_enabled = true;
   float display_max_fps = 0.0f;
@@ -150,6 +156,8 @@ struct Settings
   bool cdrom_load_image_to_ram = false;
   bool cdrom_mute_cd_audio = false;
   u32 cdrom_read_speedup = 1;
+  u32 cdrom_chd_hunk_cache_size = DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE;
+  u32 cdrom_readahead_sectors = DEFAULT_CDROM_READAHEAD_SECTORS;
 
   AudioBackend audio_backend = AudioBackend::Cubeb;
   s32 audio_output_volume = 100;
@@ -158,6 +166,7 @@ struct Settings
   bool audio_resampling = false;
   bool audio_output_muted = false;
   bool audio_sync_enabled = true;
+  bool audio_dynamic_sync = false;
   bool audio_dump_on_boot = true;
 
   // timing hacks section
@@ -264,6 +273,9 @@ struct Settings
     DEFAULT_GPU_MAX_RUN_AHEAD = 128,
     DEFAULT_VRAM_WRITE_DUMP_WIDTH_THRESHOLD = 128,
     DEFAULT_VRAM_WRITE_DUMP_HEIGHT_THRESHOLD = 128,
+    DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE = 16,
+    DEFAULT_CDROM_READAHEAD_SECTORS = 16,
+    DEFAULT_GPU_SW_RENDER_THREADS = 1,
   };
 
   void Load(SettingsInterface& si);
@@ -108,10 +108,11 @@ void SPU::Reset()
   m_transfer_fifo.Clear();
   m_transfer_event->Deactivate();
   m_ram.fill(0);
+  m_ram_dirty_pages.MarkAllDirty();
   UpdateEventInterval();
 }
 
-bool SPU::DoState(StateWrapper& sw)
+bool SPU::DoState(StateWrapper& sw, DirtyPageTracker::Snapshot* ram_snapshot)
 {
   sw.Do(&m_ticks_carry);
   sw.Do(&m_SPUCNT.bits);
@@ -170,7 +171,20 @@ bool SPU::DoState(StateWrapper& sw)
   }
 
   sw.Do(&m_transfer_fifo);
-  sw.DoBytes(m_ram.data(), RAM_SIZE);
+
+  if (ram_snapshot)
+  {
+    if (sw.IsReading())
+      m_ram_dirty_pages.RestoreSnapshot(ram_snapshot, m_ram.data());
+    else
+      m_ram_dirty_pages.UpdateSnapshot(ram_snapshot, m_ram.data());
+  }
+  else
+  {
+    sw.DoBytes(m_ram.data(), RAM_SIZE);
+    if (sw.IsReading())
+      m_ram_dirty_pages.MarkAllDirty();
+  }
 
   if (sw.IsReading())
   {
@@ -742,6 +756,7 @@ void SPU::WriteToCaptureBuffer(u32 index, s16 value)
   const u32 ram_address = (index * CAPTURE_BUFFER_SIZE_PER_CHANNEL) | ZeroExtend16(m_capture_buffer_position);
   // Log_DebugPrintf("write to capture buffer %u (0x%08X) <- 0x%04X", index, ram_address, u16(value));
   std::memcpy(&m_ram[ram_address], &value, sizeof(value));
+  m_ram_dirty_pages.MarkDirty(ram_address);
   if (IsRAMIRQTriggerable() && CheckRAMIRQ(ram_address))
   {
     Log_DebugPrintf("Trigger IRQ @ %08X %04X from capture buffer", ram_address, ram_address / 8);
@@ -780,6 +795,7 @@ void ALWAYS_INLINE SPU::ExecuteFIFOWriteToRAM(TickCount& ticks)
   {
     u16 value = m_transfer_fifo.Pop();
     std::memcpy(&m_ram[m_transfer_address], &value, sizeof(u16));
+    m_ram_dirty_pages.MarkDirty(m_transfer_address);
     m_transfer_address = (m_transfer_address + sizeof(u16)) & RAM_MASK;
     ticks -= TRANSFER_TICKS_PER_HALFWORD;
 
@@ -1561,6 +1577,7 @@ void SPU::ReverbWrite(u32 address, s16 data)
   // TODO: This should check interrupts.
   const u32 real_address = ReverbMemoryAddress(address << 2);
   std::memcpy(&m_ram[real_address], &data, sizeof(data));
+  m_ram_dirty_pages.MarkDirty(real_address);
 }
 
 // Zeroes optimized out; middle removed too(it's 16384)
@@ -1716,6 +1733,8 @@ void SPU::ProcessReverb(s16 left_in, s16 right_in, s32* left_out, s32* right_out
 
 void SPU::Execute(TickCount ticks)
 {
+  System::ScopedFrameTiming frame_timing(System::FrameTimingComponent::SPU);
+
   u32 remaining_frames;
   if (g_settings.cpu_overclock_active)
   {
@@ -1,5 +1,6 @@
 #pragma once
 #include "common/bitfield.h"
+#include "common/dirty_page_tracker.h"
 #include "common/fifo_queue.h"
 #include "system.h"
 #include "types.h"
@@ -30,7 +31,9 @@ public:
   void CPUClockChanged();
   void Shutdown();
   void Reset();
-  bool DoState(StateWrapper& sw);
+
+  /// When ram_snapshot is non-null, SPU RAM is synchronized with the snapshot instead of being written to the stream.
+  bool DoState(StateWrapper& sw, DirtyPageTracker::Snapshot* ram_snapshot);
 
   u16 ReadRegister(u32 offset);
   void WriteRegister(u32 offset, u16 value);
@@ -424,6 +427,7 @@ private:
   InlineFIFOQueue<u16, FIFO_SIZE_IN_HALFWORDS> m_transfer_fifo;
 
   std::array<u8, RAM_SIZE> m_ram{};
+  DirtyPageTracker m_ram_dirty_pages{RAM_SIZE, HOST_PAGE_SHIFT};
 };
 
 extern SPU g_spu;
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "cdrom.h"
 #include "cheats.h"
 #include "common/audio_stream.h"
+#include "common/delta_compression.h"
+#include "common/dirty_page_tracker.h"
 #include "common/file_system.h"
 #include "common/iso_reader.h"
 #include "common/log.h"
@@ -15,10 +17,12 @@
 #include "cpu_core.h"
 #include "dma.h"
 #include "gpu.h"
+#include "gpu_dump.h"
 #include "gte.h"
 #include "host_display.h"
 #include "host_interface.h"
 #include "host_interface_progress_callback.h"
+#include "input_movie.h"
 #include "interrupt_controller.h"
 #include "libcrypt_game_codes.h"
 #include "mdec.h"
@@ -30,10 +34,13 @@
 #include "spu.h"
 #include "texture_replacements.h"
 #include "timers.h"
+#include "zlib.h"
+#include <array>
 #include <cctype>
 #include <cinttypes>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <deque>
 #include <fstream>
 #include <limits>
@@ -54,10 +61,26 @@ struct MemorySaveState
 {
   std::unique_ptr<HostDisplayTexture> vram_texture;
   std::unique_ptr<GrowableMemoryByteStream> state_stream;
+
+  // Incremental states keep RAM out of the stream, and only copy the pages which were written since the state was
+  // last saved or loaded. The stream can't be used on its own, so these are only suitable for runahead.
+  DirtyPageTracker::Snapshot ram_snapshot;
+  DirtyPageTracker::Snapshot spu_ram_snapshot;
+  bool incremental = false;
+};
+
+struct RewindState
+{
+  std::unique_ptr<HostDisplayTexture> vram_texture;
+
+  // Empty for the newest state, which lives uncompressed in s_rewind_reference_state. Otherwise a delta which
+  // transforms the next-newest state into this state, so the oldest state can be discarded without touching the rest.
+  std::vector<u8> data;
 };
 
 static bool SaveMemoryState(MemorySaveState* mss);
-static bool LoadMemoryState(const MemorySaveState& mss);
+static bool LoadMemoryState(MemorySaveState* mss);
+static bool LoadMemoryState(ByteStream* stream, HostDisplayTexture* vram_texture);
 
 static bool LoadEXE(const char* filename);
 static bool SetExpansionROM(const char* filename);
@@ -66,11 +89,15 @@ static bool SetExpansionROM(const char* filename);
 static std::unique_ptr<CDImage> OpenCDImage(const char* path, bool force_preload);
 
 static bool DoLoadState(ByteStream* stream, bool force_software_renderer, bool update_display);
-static bool DoState(StateWrapper& sw, HostDisplayTexture** host_texture, bool update_display);
+static bool DecompressSaveStateData(ByteStream* stream, const SAVE_STATE_HEADER& header, ByteStream* out_stream);
+static bool DoState(StateWrapper& sw, HostDisplayTexture** host_texture, DirtyPageTracker::Snapshot* ram_snapshot,
+                    DirtyPageTracker::Snapshot* spu_ram_snapshot, bool update_display);
 static void DoRunFrame();
 static bool CreateGPU(GPURenderer renderer);
 
+static u64 GetRewindTextureMemoryUsage(const HostDisplayTexture* texture);
 static bool SaveRewindState();
+static bool PopRewindState();
 static void DoRewind();
 
 static void SaveRunaheadState();
@@ -78,10 +105,18 @@ static void DoRunahead();
 
 static void DoMemorySaveStates();
 
+static void UpdateFrameTimingActive();
+static void EndFrameTimings();
+static void UpdateAverageFrameTimings();
+
 static bool Initialize(bool force_software_renderer);
 
 static void UpdateRunningGame(const char* path, CDImage* image);
 
+static std::unique_ptr<ByteStream> CreateInputMovieStateStream(const InputMovie::Player& player);
+static void BeginInputMoviePlayback(std::unique_ptr<InputMovie::Player> player);
+static void UpdateInputMoviePlayback();
+
 static State s_state = State::Shutdown;
 
 static ConsoleRegion s_region = ConsoleRegion::NTSC_U;
@@ -113,22 +148,65 @@ static u32 s_last_global_tick_counter = 0;
 static Common::Timer s_fps_timer;
 static Common::Timer s_frame_timer;
 
+bool g_frame_timing_active = false;
+
+static constexpr u32 NUM_FRAME_TIMING_COMPONENTS = static_cast<u32>(FrameTimingComponent::Count);
+static std::array<Common::Timer::Value, NUM_FRAME_TIMING_COMPONENTS> s_frame_timings = {};
+static std::array<Common::Timer::Value, NUM_FRAME_TIMING_COMPONENTS> s_frame_timing_accumulators = {};
+static std::array<double, NUM_FRAME_TIMING_COMPONENTS> s_last_frame_timings = {};
+static std::array<float, NUM_FRAME_TIMING_COMPONENTS> s_average_frame_timings = {};
+static FrameTimingComponent s_current_frame_timing_component = FrameTimingComponent::Count;
+static Common::Timer::Value s_frame_timing_segment_start = 0;
+static Common::Timer::Value s_frame_timing_frame_start = 0;
+static u32 s_frame_timing_frame_count = 0;
+static bool s_frame_timing_enabled = false;
+
+// Complete events for the trace capture, the component is Count for whole frames.
+struct TraceEvent
+{
+  Common::Timer::Value start_time;
+  Common::Timer::Value end_time;
+  FrameTimingComponent component;
+};
+static constexpr u32 MAX_TRACE_EVENTS = 2 * 1024 * 1024;
+static std::vector<TraceEvent> s_trace_events;
+static std::string s_trace_filename;
+static Common::Timer::Value s_trace_start_time = 0;
+static bool s_trace_capture_active = false;
+
 // Playlist of disc images.
 static std::vector<std::string> s_media_playlist;
 static std::string s_media_playlist_filename;
 
 static std::unique_ptr<CheatList> s_cheat_list;
 
+// When replaying a GPU dump, the CPU doesn't run, and frames come from the dump instead.
+static std::unique_ptr<GPUDump::Player> s_gpu_dump_player;
+
+// Set while the GPU is recording a dump, which can't follow the emulation back in time.
+static bool s_gpu_dump_recording = false;
+
+// Input movie being recorded or played back, and the frame number it started at.
+static std::unique_ptr<InputMovie::Recorder> s_input_movie_recorder;
+static std::unique_ptr<InputMovie::Player> s_input_movie_player;
+static u32 s_input_movie_start_frame = 0;
+
 static bool s_memory_saves_enabled = false;
 
-static std::deque<MemorySaveState> s_rewind_states;
+static std::deque<RewindState> s_rewind_states;
+static std::vector<u8> s_rewind_reference_state;
+static MemorySaveState s_rewind_scratch_state;
+static u64 s_rewind_memory_usage = 0;
 static s32 s_rewind_load_frequency = -1;
 static s32 s_rewind_load_counter = -1;
 static s32 s_rewind_save_frequency = -1;
 static s32 s_rewind_save_counter = -1;
 static bool s_rewinding_first_save = false;
 
-static std::deque<MemorySaveState> s_runahead_states;
+// Ring of runahead slots, oldest first. Slots are overwritten in place so their buffers and snapshots get reused.
+static std::vector<MemorySaveState> s_runahead_states;
+static u32 s_runahead_state_head = 0;
+static u32 s_runahead_state_count = 0;
 static std::unique_ptr<AudioStream> s_runahead_audio_stream;
 static bool s_runahead_replay_pending = false;
 static u32 s_runahead_frames = 0;
@@ -278,6 +356,12 @@ bool IsM3UFileName(const char* path)
   return (extension && StringUtil::Strcasecmp(extension, ".m3u") == 0);
 }
 
+bool IsGPUDumpFileName(const char* path)
+{
+  const char* extension = std::strrchr(path, '.');
+  return (extension && StringUtil::Strcasecmp(extension, ".psxgpu") == 0);
+}
+
 std::vector<std::string> ParseM3UFile(const char* path)
 {
   std::ifstream ifs(path);
@@ -584,7 +668,7 @@ bool RecreateGPU(GPURenderer renderer, bool update_display /* = true*/)
 
 std::unique_ptr<CDImage> OpenCDImage(const char* path, bool force_preload)
 {
-  std::unique_ptr<CDImage> media = CDImage::Open(path);
+  std::unique_ptr<CDImage> media = CDImage::Open(path, g_settings.cdrom_chd_hunk_cache_size);
   if (!media)
     return {};
 
@@ -608,14 +692,34 @@ bool Boot(const SystemBootParameters& params)
   s_state = State::Starting;
   s_region = g_settings.region;
 
-  if (params.state_stream)
+  // input movies always start from their own save state
+  std::unique_ptr<InputMovie::Player> input_movie;
+  std::unique_ptr<ByteStream> input_movie_state;
+  if (!params.input_movie_filename.empty())
+  {
+    input_movie = InputMovie::Player::Open(params.input_movie_filename.c_str());
+    if (!input_movie)
+    {
+      g_host_interface->ReportFormattedError("Failed to load input movie '%s'", params.input_movie_filename.c_str());
+      Shutdown();
+      return false;
+    }
+
+    input_movie_state = CreateInputMovieStateStream(*input_movie);
+  }
+
+  ByteStream* state_stream = input_movie_state ? input_movie_state.get() : params.state_stream.get();
+  if (state_stream)
   {
-    if (!DoLoadState(params.state_stream.get(), params.force_software_renderer, true))
+    if (!DoLoadState(state_stream, params.force_software_renderer, true))
     {
       Shutdown();
       return false;
     }
 
+    if (input_movie)
+      BeginInputMoviePlayback(std::move(input_movie));
+
     if (g_settings.start_paused || params.override_start_paused.value_or(false))
     {
       DebugAssert(s_state == State::Running);
@@ -633,7 +737,20 @@ bool Boot(const SystemBootParameters& params)
   {
     exe_boot = IsExeFileName(params.filename.c_str());
     psf_boot = (!exe_boot && IsPsfFileName(params.filename.c_str()));
-    if (exe_boot || psf_boot)
+    if (IsGPUDumpFileName(params.filename.c_str()))
+    {
+      s_gpu_dump_player = GPUDump::Player::Open(params.filename.c_str());
+      if (!s_gpu_dump_player)
+      {
+        g_host_interface->ReportFormattedError("Failed to load GPU dump '%s'", params.filename.c_str());
+        Shutdown();
+        return false;
+      }
+
+      // the commands were recorded with this region's timings, so always use it
+      s_region = s_gpu_dump_player->IsPAL() ? ConsoleRegion::PAL : ConsoleRegion::NTSC_U;
+    }
+    else if (exe_boot || psf_boot)
     {
       if (s_region == ConsoleRegion::Auto)
       {
@@ -711,13 +828,17 @@ bool Boot(const SystemBootParameters& params)
 
   Log_InfoPrintf("Console Region: %s", Settings::GetConsoleRegionDisplayName(s_region));
 
-  // Load BIOS image.
-  std::optional<BIOS::Image> bios_image = g_host_interface->GetBIOSImage(s_region);
-  if (!bios_image)
+  // Load BIOS image. GPU dumps don't need one, since the CPU never runs.
+  std::optional<BIOS::Image> bios_image;
+  if (!s_gpu_dump_player)
   {
-    g_host_interface->ReportFormattedError("Failed to load %s BIOS", Settings::GetConsoleRegionName(s_region));
-    Shutdown();
-    return false;
+    bios_image = g_host_interface->GetBIOSImage(s_region);
+    if (!bios_image)
+    {
+      g_host_interface->ReportFormattedError("Failed to load %s BIOS", Settings::GetConsoleRegionName(s_region));
+      Shutdown();
+      return false;
+    }
   }
 
   // Notify change of disc.
@@ -730,11 +851,18 @@ bool Boot(const SystemBootParameters& params)
     return false;
   }
 
-  Bus::SetBIOS(*bios_image);
+  if (bios_image)
+    Bus::SetBIOS(*bios_image);
   UpdateControllers();
   UpdateMemoryCards();
   Reset();
 
+  if (s_gpu_dump_player)
+  {
+    s_state = (g_settings.start_paused || params.override_start_paused.value_or(false)) ? State::Paused : State::Running;
+    return true;
+  }
+
   // Enable tty by patching bios.
   const BIOS::Hash bios_hash = BIOS::GetHash(*bios_image);
   if (g_settings.bios_patch_tty_enable)
@@ -792,6 +920,7 @@ bool Initialize(bool force_software_renderer)
   s_last_global_tick_counter = 0;
   s_fps_timer.Reset();
   s_frame_timer.Reset();
+  SetFrameTimingEnabled(g_settings.display_show_frame_timings);
 
   TimingEvents::Initialize();
 
@@ -838,6 +967,16 @@ void Shutdown()
   ClearMemorySaveStates();
   s_runahead_audio_stream.reset();
 
+  if (s_trace_capture_active)
+    StopTraceCapture();
+
+  if (s_input_movie_recorder)
+  {
+    s_input_movie_recorder->Close(s_frame_number - s_input_movie_start_frame);
+    s_input_movie_recorder.reset();
+  }
+  s_input_movie_player.reset();
+
   g_texture_replacements.Shutdown();
 
   g_sio.Shutdown();
@@ -859,6 +998,8 @@ void Shutdown()
   s_media_playlist.clear();
   s_media_playlist_filename.clear();
   s_cheat_list.reset();
+  s_gpu_dump_player.reset();
+  s_gpu_dump_recording = false;
   s_state = State::Shutdown;
 }
 
@@ -900,7 +1041,8 @@ bool CreateGPU(GPURenderer renderer)
   return true;
 }
 
-bool DoState(StateWrapper& sw, HostDisplayTexture** host_texture, bool update_display)
+bool DoState(StateWrapper& sw, HostDisplayTexture** host_texture, DirtyPageTracker::Snapshot* ram_snapshot,
+             DirtyPageTracker::Snapshot* spu_ram_snapshot, bool update_display)
 {
   if (!sw.DoMarker("System"))
     return false;
@@ -915,7 +1057,7 @@ bool DoState(StateWrapper& sw, HostDisplayTexture** host_texture, bool update_di
   if (sw.IsReading())
     CPU::CodeCache::Flush();
 
-  if (!sw.DoMarker("Bus") || !Bus::DoState(sw))
+  if (!sw.DoMarker("Bus") || !Bus::DoState(sw, ram_snapshot))
     return false;
 
   if (!sw.DoMarker("DMA") || !g_dma.DoState(sw))
@@ -939,7 +1081,7 @@ bool DoState(StateWrapper& sw, HostDisplayTexture** host_texture, bool update_di
   if (!sw.DoMarker("Timers") || !g_timers.DoState(sw))
     return false;
 
-  if (!sw.DoMarker("SPU") || !g_spu.DoState(sw))
+  if (!sw.DoMarker("SPU") || !g_spu.DoState(sw, spu_ram_snapshot))
     return false;
 
   if (!sw.DoMarker("MDEC") || !g_mdec.DoState(sw))
@@ -984,6 +1126,14 @@ void Reset()
   if (IsShutdown())
     return;
 
+  // the movie's input no longer lines up with the game, and the GPU dump would miss the reset
+  if (s_input_movie_recorder)
+    StopInputMovieRecording();
+  if (s_input_movie_player)
+    StopInputMoviePlayback();
+  if (s_gpu_dump_recording)
+    StopGPUDump();
+
   g_gpu->RestoreGraphicsAPIState();
 
   CPU::Reset();
@@ -1003,6 +1153,9 @@ void Reset()
   TimingEvents::Reset();
   ResetPerformanceCounters();
 
+  if (s_gpu_dump_player)
+    s_gpu_dump_player->Reset();
+
   g_gpu->ResetGraphicsAPIState();
 }
 
@@ -1011,11 +1164,31 @@ bool LoadState(ByteStream* state, bool update_display)
   if (IsShutdown())
     return false;
 
+  // Loading would keep replaying the dump over a system it knows nothing about.
+  if (s_gpu_dump_player)
+  {
+    Log_ErrorPrintf("Save states can't be loaded while playing a GPU dump");
+    return false;
+  }
+
+  if (s_input_movie_recorder)
+    StopInputMovieRecording();
+  if (s_input_movie_player)
+    StopInputMoviePlayback();
+
   return DoLoadState(state, false, update_display);
 }
 
 bool DoLoadState(ByteStream* state, bool force_software_renderer, bool update_display)
 {
+  // The dump only has the GPU state from when it started, the commands which follow would be replayed on top of the
+  // wrong VRAM. Runahead and rewind are off while recording, so this is only reached by explicit loads.
+  if (s_gpu_dump_recording)
+  {
+    Log_WarningPrintf("Stopping GPU dump recording, as a state is being loaded");
+    StopGPUDump();
+  }
+
   SAVE_STATE_HEADER header;
   if (!state->Read2(&header, sizeof(header)))
     return false;
@@ -1136,18 +1309,34 @@ bool DoLoadState(ByteStream* state, bool force_software_renderer, bool update_di
       UpdateMemoryCards();
   }
 
-  if (header.data_compression_type != 0)
-  {
-    g_host_interface->ReportFormattedError("Unknown save state compression type %u", header.data_compression_type);
-    return false;
-  }
-
   if (!state->SeekAbsolute(header.offset_to_data))
     return false;
 
-  StateWrapper sw(state, StateWrapper::Mode::Read, header.version);
-  if (!DoState(sw, nullptr, update_display))
+  if (header.data_compression_type == SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE)
+  {
+    StateWrapper sw(state, StateWrapper::Mode::Read, header.version);
+    if (!DoState(sw, nullptr, nullptr, nullptr, update_display))
+      return false;
+  }
+  else if (header.data_compression_type == SAVE_STATE_HEADER::COMPRESSION_TYPE_ZLIB)
+  {
+    std::unique_ptr<GrowableMemoryByteStream> data_stream =
+      ByteStream_CreateGrowableMemoryStream(nullptr, header.data_uncompressed_size);
+    if (!DecompressSaveStateData(state, header, data_stream.get()) || !data_stream->SeekAbsolute(0))
+    {
+      g_host_interface->ReportError("Failed to decompress save state data.");
+      return false;
+    }
+
+    StateWrapper sw(data_stream.get(), StateWrapper::Mode::Read, header.version);
+    if (!DoState(sw, nullptr, nullptr, nullptr, update_display))
+      return false;
+  }
+  else
+  {
+    g_host_interface->ReportFormattedError("Unknown save state compression type %u", header.data_compression_type);
     return false;
+  }
 
   if (s_state == State::Starting)
     s_state = State::Running;
@@ -1161,6 +1350,13 @@ bool SaveState(ByteStream* state, u32 screenshot_size /* = 128 */)
   if (IsShutdown())
     return false;
 
+  // Nothing but the GPU is running, and the dump player's position isn't part of the state.
+  if (s_gpu_dump_player)
+  {
+    Log_ErrorPrintf("Save states can't be created while playing a GPU dump");
+    return false;
+  }
+
   SAVE_STATE_HEADER header = {};
 
   const u64 header_position = state->GetPosition();
@@ -1214,14 +1410,14 @@ bool SaveState(ByteStream* state, u32 screenshot_size /* = 128 */)
     g_gpu->RestoreGraphicsAPIState();
 
     StateWrapper sw(state, StateWrapper::Mode::Write, SAVE_STATE_VERSION);
-    const bool result = DoState(sw, nullptr, false);
+    const bool result = DoState(sw, nullptr, nullptr, nullptr, false);
 
     g_gpu->ResetGraphicsAPIState();
 
     if (!result)
       return false;
 
-    header.data_compression_type = 0;
+    header.data_compression_type = SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE;
     header.data_uncompressed_size = static_cast<u32>(state->GetPosition() - header.offset_to_data);
   }
 
@@ -1236,6 +1432,121 @@ bool SaveState(ByteStream* state, u32 screenshot_size /* = 128 */)
   return true;
 }
 
+bool CompressSaveState(const void* state_data, u32 state_size, ByteStream* out_stream)
+{
+  const u8* state_ptr = static_cast<const u8*>(state_data);
+  SAVE_STATE_HEADER header;
+  if (state_size < sizeof(header))
+    return false;
+
+  std::memcpy(&header, state_ptr, sizeof(header));
+  if (header.magic != SAVE_STATE_MAGIC || header.data_compression_type != SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE ||
+      header.offset_to_data < sizeof(header) || (header.offset_to_data + header.data_uncompressed_size) > state_size)
+  {
+    return false;
+  }
+
+  // everything before the data (filenames, screenshot) is copied as-is, the data is always last
+  const u64 header_position = out_stream->GetPosition();
+  if (!out_stream->Write2(state_ptr, header.offset_to_data))
+    return false;
+
+  z_stream strm = {};
+  int err = deflateInit(&strm, Z_DEFAULT_COMPRESSION);
+  if (err != Z_OK)
+  {
+    Log_ErrorPrintf("deflateInit() failed: %d", err);
+    return false;
+  }
+
+  u8 out_buffer[64 * 1024];
+  strm.next_in = const_cast<Bytef*>(state_ptr + header.offset_to_data);
+  strm.avail_in = header.data_uncompressed_size;
+  do
+  {
+    strm.next_out = out_buffer;
+    strm.avail_out = sizeof(out_buffer);
+    err = deflate(&strm, Z_FINISH);
+    if (err == Z_STREAM_ERROR)
+    {
+      Log_ErrorPrintf("deflate() failed: %d", err);
+      deflateEnd(&strm);
+      return false;
+    }
+
+    const u32 out_size = static_cast<u32>(sizeof(out_buffer) - strm.avail_out);
+    if (out_size > 0 && !out_stream->Write2(out_buffer, out_size))
+    {
+      deflateEnd(&strm);
+      return false;
+    }
+  } while (err != Z_STREAM_END);
+
+  header.data_compression_type = SAVE_STATE_HEADER::COMPRESSION_TYPE_ZLIB;
+  header.data_compressed_size = static_cast<u32>(strm.total_out);
+  deflateEnd(&strm);
+
+  Log_DevPrintf("Compressed save state data from %u to %u bytes", header.data_uncompressed_size,
+                header.data_compressed_size);
+
+  const u64 end_position = out_stream->GetPosition();
+  return (out_stream->SeekAbsolute(header_position) && out_stream->Write2(&header, sizeof(header)) &&
+          out_stream->SeekAbsolute(end_position));
+}
+
+bool DecompressSaveStateData(ByteStream* stream, const SAVE_STATE_HEADER& header, ByteStream* out_stream)
+{
+  z_stream strm = {};
+  int err = inflateInit(&strm);
+  if (err != Z_OK)
+  {
+    Log_ErrorPrintf("inflateInit() failed: %d", err);
+    return false;
+  }
+
+  // read the compressed data in chunks, rather than pulling the whole thing in first
+  u8 in_buffer[64 * 1024];
+  u8 out_buffer[64 * 1024];
+  u32 remaining = header.data_compressed_size;
+  do
+  {
+    if (strm.avail_in == 0 && remaining > 0)
+    {
+      const u32 read_size = std::min<u32>(remaining, sizeof(in_buffer));
+      if (!stream->Read2(in_buffer, read_size))
+      {
+        inflateEnd(&strm);
+        return false;
+      }
+
+      strm.next_in = in_buffer;
+      strm.avail_in = read_size;
+      remaining -= read_size;
+    }
+
+    strm.next_out = out_buffer;
+    strm.avail_out = sizeof(out_buffer);
+    err = inflate(&strm, Z_NO_FLUSH);
+    if (err != Z_OK && err != Z_STREAM_END)
+    {
+      Log_ErrorPrintf("inflate() failed: %d", err);
+      inflateEnd(&strm);
+      return false;
+    }
+
+    const u32 out_size = static_cast<u32>(sizeof(out_buffer) - strm.avail_out);
+    if (out_size > 0 && !out_stream->Write2(out_buffer, out_size))
+    {
+      inflateEnd(&strm);
+      return false;
+    }
+  } while (err != Z_STREAM_END);
+
+  const bool result = (strm.total_out == header.data_uncompressed_size);
+  inflateEnd(&strm);
+  return result;
+}
+
 void SingleStepCPU()
 {
   const u32 old_frame_number = s_frame_number;
@@ -1258,7 +1569,15 @@ void DoRunFrame()
 {
   g_gpu->RestoreGraphicsAPIState();
 
-  if (CPU::g_state.use_debug_dispatcher)
+  if (s_input_movie_player)
+    UpdateInputMoviePlayback();
+
+  ScopedFrameTiming frame_timing(FrameTimingComponent::CPU);
+  if (s_gpu_dump_player)
+  {
+    s_gpu_dump_player->Execute();
+  }
+  else if (CPU::g_state.use_debug_dispatcher)
   {
     CPU::ExecuteDebug();
   }
@@ -1301,6 +1620,9 @@ void RunFrame()
   if (s_rewind_load_counter >= 0)
   {
     DoRewind();
+    if (g_frame_timing_active)
+      EndFrameTimings();
+
     return;
   }
 
@@ -1309,10 +1631,20 @@ void RunFrame()
 
   DoRunFrame();
 
+  // the GPU stops the dump by itself once it has enough frames
+  if (s_gpu_dump_recording && !g_gpu->IsRecordingDump())
+  {
+    s_gpu_dump_recording = false;
+    UpdateMemorySaveStateSettings();
+  }
+
   s_next_frame_time += s_frame_period;
 
   if (s_memory_saves_enabled)
     DoMemorySaveStates();
+
+  if (g_frame_timing_active)
+    EndFrameTimings();
 }
 
 float GetTargetSpeed()
@@ -1442,6 +1774,9 @@ void UpdatePerformanceCounters()
   s_last_global_tick_counter = global_tick_counter;
   s_fps_timer.Reset();
 
+  if (g_frame_timing_active)
+    UpdateAverageFrameTimings();
+
   Log_VerbosePrintf("FPS: %.2f VPS: %.2f Average: %.2fms Worst: %.2fms", s_fps, s_vps, s_average_frame_time,
                     s_worst_frame_time);
 
@@ -1459,6 +1794,328 @@ void ResetPerformanceCounters()
   ResetThrottler();
 }
 
+static void UpdateFrameTimingActive()
+{
+  const bool active = (s_frame_timing_enabled || s_trace_capture_active);
+  if (g_frame_timing_active == active)
+    return;
+
+  g_frame_timing_active = active;
+  s_frame_timings.fill(0);
+  s_frame_timing_accumulators.fill(0);
+  s_last_frame_timings.fill(0.0);
+  s_average_frame_timings.fill(0.0f);
+  s_frame_timing_frame_count = 0;
+  s_frame_timing_frame_start = Common::Timer::GetValue();
+}
+
+static void AddTraceEvent(FrameTimingComponent component, Common::Timer::Value start_time,
+                          Common::Timer::Value end_time)
+{
+  if (s_trace_events.size() == MAX_TRACE_EVENTS)
+    return;
+
+  s_trace_events.push_back(TraceEvent{start_time, end_time, component});
+  if (s_trace_events.size() == MAX_TRACE_EVENTS)
+    Log_WarningPrintf("Trace capture is full, no more events will be recorded");
+}
+
+static void EndFrameTimings()
+{
+  const Common::Timer::Value now = Common::Timer::GetValue();
+  for (u32 i = 0; i < NUM_FRAME_TIMING_COMPONENTS; i++)
+  {
+    s_last_frame_timings[i] = Common::Timer::ConvertValueToMilliseconds(s_frame_timings[i]);
+    s_frame_timing_accumulators[i] += s_frame_timings[i];
+    s_frame_timings[i] = 0;
+  }
+
+  s_frame_timing_frame_count++;
+  if (s_trace_capture_active)
+    AddTraceEvent(FrameTimingComponent::Count, s_frame_timing_frame_start, now);
+
+  s_frame_timing_frame_start = now;
+}
+
+static void UpdateAverageFrameTimings()
+{
+  if (s_frame_timing_frame_count == 0)
+    return;
+
+  for (u32 i = 0; i < NUM_FRAME_TIMING_COMPONENTS; i++)
+  {
+    s_average_frame_timings[i] = static_cast<float>(
+      Common::Timer::ConvertValueToMilliseconds(s_frame_timing_accumulators[i]) / s_frame_timing_frame_count);
+    s_frame_timing_accumulators[i] = 0;
+  }
+
+  s_frame_timing_frame_count = 0;
+}
+
+void SetFrameTimingEnabled(bool enabled)
+{
+  s_frame_timing_enabled = enabled;
+  UpdateFrameTimingActive();
+}
+
+bool IsFrameTimingEnabled()
+{
+  return s_frame_timing_enabled;
+}
+
+const char* GetFrameTimingComponentName(FrameTimingComponent component)
+{
+  static constexpr std::array<const char*, NUM_FRAME_TIMING_COMPONENTS> names = {
+    {"CPU", "Events", "GPU", "SPU", "CDROM", "MDEC", "Recompiler"}};
+  return (component < FrameTimingComponent::Count) ? names[static_cast<u32>(component)] : "Frame";
+}
+
+double GetLastFrameTiming(FrameTimingComponent component)
+{
+  return s_last_frame_timings[static_cast<u32>(component)];
+}
+
+float GetAverageFrameTiming(FrameTimingComponent component)
+{
+  return s_average_frame_timings[static_cast<u32>(component)];
+}
+
+bool StartTraceCapture(const char* filename)
+{
+  if (s_trace_capture_active)
+    return false;
+
+  // make sure we can write the trace before capturing anything
+  std::FILE* fp = FileSystem::OpenCFile(filename, "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open trace file '%s'", filename);
+    return false;
+  }
+  std::fclose(fp);
+
+  Log_InfoPrintf("Capturing trace to '%s'", filename);
+  s_trace_filename = filename;
+  s_trace_events.clear();
+  s_trace_start_time = Common::Timer::GetValue();
+  s_trace_capture_active = true;
+  UpdateFrameTimingActive();
+  return true;
+}
+
+bool StopTraceCapture()
+{
+  if (!s_trace_capture_active)
+    return false;
+
+  s_trace_capture_active = false;
+  UpdateFrameTimingActive();
+
+  std::FILE* fp = FileSystem::OpenCFile(s_trace_filename.c_str(), "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open trace file '%s'", s_trace_filename.c_str());
+    s_trace_events = {};
+    return false;
+  }
+
+  // complete events on a single thread, with timestamps in microseconds
+  std::fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  std::fprintf(fp, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, "
+                   "\"args\": {\"name\": \"Emulation\"}}");
+  for (const TraceEvent& event : s_trace_events)
+  {
+    const double start = Common::Timer::ConvertValueToNanoseconds(event.start_time - s_trace_start_time) / 1000.0;
+    const double duration = Common::Timer::ConvertValueToNanoseconds(event.end_time - event.start_time) / 1000.0;
+    std::fprintf(fp, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": %.3f, \"dur\": %.3f}",
+                 GetFrameTimingComponentName(event.component), start, duration);
+  }
+  std::fprintf(fp, "\n]}\n");
+
+  const bool result = (std::ferror(fp) == 0);
+  std::fclose(fp);
+
+  Log_InfoPrintf("Wrote %zu trace events to '%s'", s_trace_events.size(), s_trace_filename.c_str());
+  s_trace_events = {};
+  return result;
+}
+
+bool IsCapturingTrace()
+{
+  return s_trace_capture_active;
+}
+
+bool StartGPUDump(const char* filename, u32 max_frames)
+{
+  if (IsShutdown() || s_gpu_dump_player || !g_gpu->StartDumpRecording(filename, max_frames))
+    return false;
+
+  s_gpu_dump_recording = true;
+  UpdateMemorySaveStateSettings();
+  return true;
+}
+
+bool StopGPUDump()
+{
+  const bool result = g_gpu->StopDumpRecording();
+  s_gpu_dump_recording = false;
+  UpdateMemorySaveStateSettings();
+  return result;
+}
+
+bool IsRecordingGPUDump()
+{
+  return g_gpu && g_gpu->IsRecordingDump();
+}
+
+bool IsPlayingGPUDump()
+{
+  return static_cast<bool>(s_gpu_dump_player);
+}
+
+bool StartInputMovieRecording(const char* filename)
+{
+  if (IsShutdown() || s_gpu_dump_player || s_input_movie_recorder || s_input_movie_player)
+    return false;
+
+  std::unique_ptr<GrowableMemoryByteStream> state_stream = ByteStream_CreateGrowableMemoryStream();
+  if (!SaveState(state_stream.get(), 0))
+    return false;
+
+  std::vector<u8> state(state_stream->GetMemoryPointer(), state_stream->GetMemoryPointer() + state_stream->GetSize());
+  s_input_movie_recorder = InputMovie::Recorder::Create(filename, std::move(state));
+  if (!s_input_movie_recorder)
+    return false;
+
+  // playback starts with everything released, so recording has to as well
+  InputMovie::ReleaseControllerInputs();
+  s_input_movie_start_frame = s_frame_number;
+
+  // rewinding or runahead would record input for frames which are later discarded
+  UpdateMemorySaveStateSettings();
+
+  Log_InfoPrintf("Started recording input movie '%s' at frame %u", filename, s_frame_number);
+  return true;
+}
+
+bool StopInputMovieRecording()
+{
+  if (!s_input_movie_recorder)
+    return false;
+
+  const bool result = s_input_movie_recorder->Close(s_frame_number - s_input_movie_start_frame);
+  s_input_movie_recorder.reset();
+  UpdateMemorySaveStateSettings();
+
+  return result;
+}
+
+bool IsRecordingInputMovie()
+{
+  return static_cast<bool>(s_input_movie_recorder);
+}
+
+bool StartInputMoviePlayback(std::unique_ptr<InputMovie::Player> player)
+{
+  Assert(!IsShutdown() && !s_gpu_dump_player && !s_input_movie_recorder && !s_input_movie_player);
+
+  std::unique_ptr<ByteStream> state_stream = CreateInputMovieStateStream(*player);
+  if (!DoLoadState(state_stream.get(), false, true))
+    return false;
+
+  BeginInputMoviePlayback(std::move(player));
+  return true;
+}
+
+void StopInputMoviePlayback()
+{
+  if (!s_input_movie_player)
+    return;
+
+  Log_InfoPrintf("Stopped playing input movie '%s' at frame %u of %u", s_input_movie_player->GetFileName().c_str(),
+                 s_frame_number - s_input_movie_start_frame, s_input_movie_player->GetFrameCount());
+  s_input_movie_player.reset();
+
+  // don't leave the movie's inputs held, host input only sends changes
+  InputMovie::ReleaseControllerInputs();
+  UpdateMemorySaveStateSettings();
+}
+
+bool IsPlayingInputMovie()
+{
+  return static_cast<bool>(s_input_movie_player);
+}
+
+std::unique_ptr<ByteStream> CreateInputMovieStateStream(const InputMovie::Player& player)
+{
+  const std::vector<u8>& state = player.GetStartState();
+  return ByteStream_CreateReadOnlyMemoryStream(state.data(), static_cast<u32>(state.size()));
+}
+
+void BeginInputMoviePlayback(std::unique_ptr<InputMovie::Player> player)
+{
+  const InputMovie::ControllerTypeArray controller_types = InputMovie::GetControllerTypes();
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+  {
+    if (controller_types[i] != player->GetControllerTypes()[i])
+    {
+      g_host_interface->AddFormattedOSDMessage(
+        10.0f,
+        g_host_interface->TranslateString("OSDMessage",
+                                          "Input movie was recorded with %s in port %u, but %s is used. It may desync."),
+        Settings::GetControllerTypeName(player->GetControllerTypes()[i]), i + 1u,
+        Settings::GetControllerTypeName(controller_types[i]));
+    }
+  }
+
+  InputMovie::ReleaseControllerInputs();
+  s_input_movie_player = std::move(player);
+  s_input_movie_start_frame = s_frame_number;
+  UpdateMemorySaveStateSettings();
+
+  Log_InfoPrintf("Started playing input movie '%s' at frame %u", s_input_movie_player->GetFileName().c_str(),
+                 s_frame_number);
+}
+
+void UpdateInputMoviePlayback()
+{
+  const u32 movie_frame = s_frame_number - s_input_movie_start_frame;
+  if (s_input_movie_player->IsFinished(movie_frame))
+  {
+    g_host_interface->AddOSDMessage(g_host_interface->TranslateStdString("OSDMessage", "Input movie finished."),
+                                    5.0f);
+    StopInputMoviePlayback();
+    return;
+  }
+
+  s_input_movie_player->ApplyEvents(movie_frame);
+}
+
+void ScopedFrameTiming::Begin(FrameTimingComponent component)
+{
+  const Common::Timer::Value now = Common::Timer::GetValue();
+  if (s_current_frame_timing_component != FrameTimingComponent::Count)
+    s_frame_timings[static_cast<u32>(s_current_frame_timing_component)] += now - s_frame_timing_segment_start;
+
+  m_start_time = now;
+  m_component = component;
+  m_parent_component = s_current_frame_timing_component;
+  m_active = true;
+  s_current_frame_timing_component = component;
+  s_frame_timing_segment_start = now;
+}
+
+void ScopedFrameTiming::End()
+{
+  const Common::Timer::Value now = Common::Timer::GetValue();
+  s_frame_timings[static_cast<u32>(m_component)] += now - s_frame_timing_segment_start;
+  s_current_frame_timing_component = m_parent_component;
+  s_frame_timing_segment_start = now;
+
+  if (s_trace_capture_active)
+    AddTraceEvent(m_component, m_start_time, now);
+}
+
 bool LoadEXE(const char* filename)
 {
   std::FILE* fp = FileSystem::OpenCFile(filename, "rb");
@@ -1614,6 +2271,34 @@ Controller* GetController(u32 slot)
   return g_pad.GetController(slot);
 }
 
+void SetControllerButtonState(u32 slot, s32 button_code, bool pressed)
+{
+  if (s_input_movie_player)
+    return;
+
+  Controller* controller = g_pad.GetController(slot);
+  if (!controller)
+    return;
+
+  controller->SetButtonState(button_code, pressed);
+  if (s_input_movie_recorder)
+    s_input_movie_recorder->AddButtonEvent(s_frame_number - s_input_movie_start_frame, slot, button_code, pressed);
+}
+
+void SetControllerAxisState(u32 slot, s32 axis_code, float value)
+{
+  if (s_input_movie_player)
+    return;
+
+  Controller* controller = g_pad.GetController(slot);
+  if (!controller)
+    return;
+
+  controller->SetAxisState(axis_code, value);
+  if (s_input_movie_recorder)
+    s_input_movie_recorder->AddAxisEvent(s_frame_number - s_input_movie_start_frame, slot, axis_code, value);
+}
+
 void UpdateControllers()
 {
   for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
@@ -1969,35 +2654,59 @@ void SetCheatList(std::unique_ptr<CheatList> cheats)
   s_cheat_list = std::move(cheats);
 }
 
-void CalculateRewindMemoryUsage(u32 num_saves, u64* ram_usage, u64* vram_usage)
+void CalculateRewindMemoryUsage(u32 num_saves, u32 memory_budget, u64* ram_usage, u64* vram_usage)
 {
-  *ram_usage = MAX_SAVE_STATE_SIZE * static_cast<u64>(num_saves);
-  *vram_usage = (VRAM_WIDTH * VRAM_HEIGHT * 4) * static_cast<u64>(std::max(g_settings.gpu_resolution_scale, 1u)) *
-                static_cast<u64>(g_settings.gpu_multisamples) * static_cast<u64>(num_saves);
+  // Deltas are usually a small fraction of a full state, but a worst-case state is stored in full.
+  const u64 budget_bytes = static_cast<u64>(memory_budget) * 1048576;
+  *ram_usage = std::min<u64>(MAX_SAVE_STATE_SIZE * static_cast<u64>(num_saves), budget_bytes + MAX_SAVE_STATE_SIZE);
+
+  // The hardware renderers keep a full copy of VRAM per state, which counts against the same budget, so it also
+  // limits the number of states.
+  const u64 resolution_scale = std::max(g_settings.gpu_resolution_scale, 1u);
+  const u64 slot_vram_usage = (VRAM_WIDTH * VRAM_HEIGHT * 4) * resolution_scale * resolution_scale *
+                              static_cast<u64>(std::max(g_settings.gpu_multisamples, 1u));
+  const u64 vram_slots = std::min<u64>(num_saves, std::max<u64>(budget_bytes / slot_vram_usage, 1) + 1);
+  *vram_usage = g_settings.IsUsingSoftwareRenderer() ? 0 : (slot_vram_usage * vram_slots);
+}
+
+u64 GetRewindMemoryUsage()
+{
+  return s_rewind_memory_usage;
 }
 
 void ClearMemorySaveStates()
 {
   s_rewind_states.clear();
+  s_rewind_reference_state = {};
+  s_rewind_scratch_state = {};
+  s_rewind_memory_usage = 0;
   s_runahead_states.clear();
+  s_runahead_state_head = 0;
+  s_runahead_state_count = 0;
 }
 
 void UpdateMemorySaveStateSettings()
 {
   ClearMemorySaveStates();
 
-  s_memory_saves_enabled = g_settings.rewind_enable;
+  // GPU dump playback isn't part of the save state, so neither can be used with it. Input movies and GPU dump
+  // recordings can't follow the emulation back in time either.
+  const bool recording_active = (s_input_movie_recorder || s_input_movie_player || s_gpu_dump_recording);
+  const bool rewind_enable = (g_settings.rewind_enable && !s_gpu_dump_player && !recording_active);
+  s_memory_saves_enabled = rewind_enable;
 
-  if (g_settings.rewind_enable)
+  if (rewind_enable)
   {
     s_rewind_save_frequency = static_cast<s32>(std::ceil(g_settings.rewind_save_frequency * s_throttle_frequency));
     s_rewind_save_counter = 0;
 
     u64 ram_usage, vram_usage;
-    CalculateRewindMemoryUsage(g_settings.rewind_save_slots, &ram_usage, &vram_usage);
-    Log_InfoPrintf(
-      "Rewind is enabled, saving every %d frames, with %u slots and %" PRIu64 "MB RAM and %" PRIu64 "MB VRAM usage",
-      std::max(s_rewind_save_frequency, 1), g_settings.rewind_save_slots, ram_usage / 1048576, vram_usage / 1048576);
+    CalculateRewindMemoryUsage(g_settings.rewind_save_slots, g_settings.rewind_memory_budget, &ram_usage,
+                               &vram_usage);
+    Log_InfoPrintf("Rewind is enabled, saving every %d frames, with a %uMB budget (%u slots would use %" PRIu64
+                   "MB RAM and %" PRIu64 "MB VRAM)",
+                   std::max(s_rewind_save_frequency, 1), g_settings.rewind_memory_budget, g_settings.rewind_save_slots,
+                   ram_usage / 1048576, vram_usage / 1048576);
   }
   else
   {
@@ -2008,7 +2717,7 @@ void UpdateMemorySaveStateSettings()
   s_rewind_load_frequency = -1;
   s_rewind_load_counter = -1;
 
-  s_runahead_frames = g_settings.runahead_frames;
+  s_runahead_frames = (s_gpu_dump_player || recording_active) ? 0 : g_settings.runahead_frames;
   s_runahead_replay_pending = false;
   if (s_runahead_frames > 0)
   {
@@ -2028,13 +2737,29 @@ void UpdateMemorySaveStateSettings()
   }
 }
 
-bool LoadMemoryState(const MemorySaveState& mss)
+bool LoadMemoryState(MemorySaveState* mss)
 {
-  mss.state_stream->SeekAbsolute(0);
+  mss->state_stream->SeekAbsolute(0);
+  if (!mss->incremental)
+    return LoadMemoryState(mss->state_stream.get(), mss->vram_texture.get());
 
-  StateWrapper sw(mss.state_stream.get(), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
-  HostDisplayTexture* host_texture = mss.vram_texture.get();
-  if (!DoState(sw, &host_texture, true))
+  StateWrapper sw(mss->state_stream.get(), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
+  HostDisplayTexture* host_texture = mss->vram_texture.get();
+  if (!DoState(sw, &host_texture, &mss->ram_snapshot, &mss->spu_ram_snapshot, true))
+  {
+    g_host_interface->ReportError("Failed to load memory save state, resetting.");
+    Reset();
+    return false;
+  }
+
+  return true;
+}
+
+bool LoadMemoryState(ByteStream* stream, HostDisplayTexture* vram_texture)
+{
+  StateWrapper sw(stream, StateWrapper::Mode::Read, SAVE_STATE_VERSION);
+  HostDisplayTexture* host_texture = vram_texture;
+  if (!DoState(sw, &host_texture, nullptr, nullptr, true))
   {
     g_host_interface->ReportError("Failed to load memory save state, resetting.");
     Reset();
@@ -2053,7 +2778,9 @@ bool SaveMemoryState(MemorySaveState* mss)
 
   HostDisplayTexture* host_texture = mss->vram_texture.release();
   StateWrapper sw(mss->state_stream.get(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
-  if (!DoState(sw, &host_texture, false))
+  DirtyPageTracker::Snapshot* ram_snapshot = mss->incremental ? &mss->ram_snapshot : nullptr;
+  DirtyPageTracker::Snapshot* spu_ram_snapshot = mss->incremental ? &mss->spu_ram_snapshot : nullptr;
+  if (!DoState(sw, &host_texture, ram_snapshot, spu_ram_snapshot, false))
   {
     Log_ErrorPrint("Failed to create rewind state.");
     delete host_texture;
@@ -2064,35 +2791,106 @@ bool SaveMemoryState(MemorySaveState* mss)
   return true;
 }
 
+u64 GetRewindTextureMemoryUsage(const HostDisplayTexture* texture)
+{
+  if (!texture)
+    return 0;
+
+  return static_cast<u64>(texture->GetWidth()) * texture->GetHeight() * texture->GetLayers() * texture->GetSamples() *
+         HostDisplay::GetDisplayPixelFormatSize(texture->GetFormat());
+}
+
 bool SaveRewindState()
 {
   Common::Timer save_timer;
 
-  // try to reuse the frontmost slot
-  const u32 save_slots = g_settings.rewind_save_slots;
-  MemorySaveState mss;
-  while (s_rewind_states.size() >= save_slots)
-  {
-    mss = std::move(s_rewind_states.front());
+  // Try to reuse the oldest slot's texture. The new state will need about as much VRAM as the newest one, so make
+  // room for that up front, otherwise large textures would push well past the budget. Only the budget limits the
+  // number of states, since the deltas are usually small enough to keep far more than the configured slot count.
+  const u64 memory_budget = static_cast<u64>(g_settings.rewind_memory_budget) * 1048576;
+  const u64 new_texture_usage =
+    s_rewind_states.empty() ? 0 : GetRewindTextureMemoryUsage(s_rewind_states.back().vram_texture.get());
+  RewindState rs;
+  while (!s_rewind_states.empty() &&
+         s_rewind_states.size() > 1 && (s_rewind_memory_usage + new_texture_usage) > memory_budget)
+  {
+    rs = std::move(s_rewind_states.front());
     s_rewind_states.pop_front();
+    s_rewind_memory_usage -= rs.data.size() + GetRewindTextureMemoryUsage(rs.vram_texture.get());
+    rs.data.clear();
   }
 
+  MemorySaveState& mss = s_rewind_scratch_state;
+  mss.vram_texture = std::move(rs.vram_texture);
   if (!SaveMemoryState(&mss))
     return false;
 
-  s_rewind_states.push_back(std::move(mss));
+  rs.vram_texture = std::move(mss.vram_texture);
+  s_rewind_memory_usage += GetRewindTextureMemoryUsage(rs.vram_texture.get());
+
+  const u8* new_data = mss.state_stream->GetMemoryPointer();
+  const u32 new_size = static_cast<u32>(mss.state_stream->GetSize());
+
+  // The previous newest state gets compressed against the one we just created.
+  if (!s_rewind_states.empty())
+  {
+    RewindState& prev = s_rewind_states.back();
+    DeltaCompression::Encode(&prev.data, new_data, new_size, s_rewind_reference_state.data(),
+                             static_cast<u32>(s_rewind_reference_state.size()));
+    prev.data.shrink_to_fit();
+    s_rewind_memory_usage += prev.data.size();
+  }
 
-  Log_DevPrintf("Saved rewind state (%" PRIu64 " bytes, took %.4f ms)", s_rewind_states.back().state_stream->GetSize(),
-                save_timer.GetTimeMilliseconds());
+  s_rewind_memory_usage -= s_rewind_reference_state.size();
+  s_rewind_reference_state.assign(new_data, new_data + new_size);
+  s_rewind_memory_usage += new_size;
+  s_rewind_states.push_back(std::move(rs));
+
+  Log_DevPrintf("Saved rewind state (%u bytes, %u states using %" PRIu64 " bytes total, took %.4f ms)", new_size,
+                static_cast<u32>(s_rewind_states.size()), s_rewind_memory_usage, save_timer.GetTimeMilliseconds());
 
   return true;
 }
 
+bool PopRewindState()
+{
+  // The newest state is the reference, so discarding it means reconstructing the one before it.
+  s_rewind_memory_usage -= GetRewindTextureMemoryUsage(s_rewind_states.back().vram_texture.get());
+  s_rewind_states.pop_back();
+  if (s_rewind_states.empty())
+  {
+    s_rewind_memory_usage -= s_rewind_reference_state.size();
+    s_rewind_reference_state = {};
+    return true;
+  }
+
+  RewindState& rs = s_rewind_states.back();
+  s_rewind_memory_usage -= s_rewind_reference_state.size();
+  s_rewind_memory_usage -= rs.data.size();
+  const bool result =
+    DeltaCompression::Apply(&s_rewind_reference_state, rs.data.data(), static_cast<u32>(rs.data.size()));
+  rs.data = {};
+
+  if (!result)
+  {
+    Log_ErrorPrint("Failed to decompress rewind state, discarding rewind buffer.");
+    s_rewind_states.clear();
+    s_rewind_reference_state = {};
+    s_rewind_memory_usage = 0;
+    return false;
+  }
+
+  s_rewind_memory_usage += s_rewind_reference_state.size();
+  return true;
+}
+
 bool LoadRewindState(u32 skip_saves /*= 0*/, bool consume_state /*=true */)
 {
   while (skip_saves > 0 && !s_rewind_states.empty())
   {
-    s_rewind_states.pop_back();
+    if (!PopRewindState())
+      return false;
+
     skip_saves--;
   }
 
@@ -2101,11 +2899,12 @@ bool LoadRewindState(u32 skip_saves /*= 0*/, bool consume_state /*=true */)
 
   Common::Timer load_timer;
 
-  if (!LoadMemoryState(s_rewind_states.back()))
+  ReadOnlyMemoryByteStream stream(s_rewind_reference_state.data(), static_cast<u32>(s_rewind_reference_state.size()));
+  if (!LoadMemoryState(&stream, s_rewind_states.back().vram_texture.get()))
     return false;
 
   if (consume_state)
-    s_rewind_states.pop_back();
+    PopRewindState();
 
   Log_DevPrintf("Rewind load took %.4f ms", load_timer.GetTimeMilliseconds());
   return true;
@@ -2149,21 +2948,30 @@ void DoRewind()
 
 void SaveRunaheadState()
 {
-  // try to reuse the frontmost slot
-  MemorySaveState mss;
-  while (s_runahead_states.size() >= s_runahead_frames)
+  if (s_runahead_states.size() != s_runahead_frames)
+  {
+    s_runahead_states.clear();
+    s_runahead_states.resize(s_runahead_frames);
+    s_runahead_state_head = 0;
+    s_runahead_state_count = 0;
+  }
+
+  // overwrite the oldest slot when we're full, its snapshots only need the pages written since it was saved
+  if (s_runahead_state_count == s_runahead_frames)
   {
-    mss = std::move(s_runahead_states.front());
-    s_runahead_states.pop_front();
+    s_runahead_state_head = (s_runahead_state_head + 1) % s_runahead_frames;
+    s_runahead_state_count--;
   }
 
+  MemorySaveState& mss = s_runahead_states[(s_runahead_state_head + s_runahead_state_count) % s_runahead_frames];
+  mss.incremental = true;
   if (!SaveMemoryState(&mss))
   {
     Log_ErrorPrint("Failed to save runahead state.");
     return;
   }
 
-  s_runahead_states.push_back(std::move(mss));
+  s_runahead_state_count++;
 }
 
 void DoRunahead()
@@ -2171,21 +2979,25 @@ void DoRunahead()
   Common::Timer timer;
   Log_DevPrintf("runahead starting at frame %u", s_frame_number);
 
+  // nothing to replay from if we're still catching up
+  if (s_runahead_replay_pending && s_runahead_state_count == 0)
+    s_runahead_replay_pending = false;
+
   if (s_runahead_replay_pending)
   {
-    // we need to replay and catch up - load the state,
+    // we need to replay and catch up - load the oldest state,
     s_runahead_replay_pending = false;
-    if (!LoadMemoryState(s_runahead_states.front()))
+    if (!LoadMemoryState(&s_runahead_states[s_runahead_state_head]))
       return;
 
-    // and throw away all the states, forcing us to catch up below
-    // TODO: can we leave one frame here and run, avoiding the extra save?
-    s_runahead_states.clear();
+    // and drop all the states, forcing us to catch up below. The slots stay where they are, so the first catch-up
+    // frame is saved over the state we just loaded, which is already in sync and only needs that frame's writes.
+    s_runahead_state_count = 0;
     Log_VerbosePrintf("Rewound to frame %u, took %.2f ms", s_frame_number, timer.GetTimeMilliseconds());
   }
 
   // run the frames with no audio
-  s32 frames_to_run = static_cast<s32>(s_runahead_frames) - static_cast<s32>(s_runahead_states.size());
+  s32 frames_to_run = static_cast<s32>(s_runahead_frames) - static_cast<s32>(s_runahead_state_count);
   if (frames_to_run > 0)
   {
     Common::Timer timer2;
@@ -2227,9 +3039,6 @@ void DoMemorySaveStates()
       s_rewind_save_counter--;
     }
   }
-
-  if (s_runahead_frames > 0)
-    SaveRunaheadState();
 }
 
 void SetRunaheadReplayFlag()
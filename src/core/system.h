@@ -17,6 +17,10 @@ class Controller;
 struct CheatCode;
 class CheatList;
 
+namespace InputMovie {
+class Player;
+}
+
 struct SystemBootParameters
 {
   SystemBootParameters();
@@ -29,6 +33,7 @@ struct SystemBootParameters
   std::optional<bool> override_fullscreen;
   std::optional<bool> override_start_paused;
   std::unique_ptr<ByteStream> state_stream;
+  std::string input_movie_filename;
   u32 media_playlist_index = 0;
   bool load_image_to_ram = false;
   bool force_software_renderer = false;
@@ -66,6 +71,9 @@ bool IsPsfFileName(const char* path);
 /// Returns true if the filename is a M3U Playlist we can handle.
 bool IsM3UFileName(const char* path);
 
+/// Returns true if the filename is a GPU dump which can be replayed without the CPU.
+bool IsGPUDumpFileName(const char* path);
+
 /// Parses an M3U playlist, returning the entries.
 std::vector<std::string> ParseM3UFile(const char* path);
 
@@ -151,6 +159,10 @@ bool SaveState(ByteStream* state, u32 screenshot_size = 128);
 /// Recreates the GPU component, saving/loading the state so it is preserved. Call when the GPU renderer changes.
 bool RecreateGPU(GPURenderer renderer, bool update_display = true);
 
+/// Writes a save state produced by SaveState() to out_stream, compressing the data section.
+/// Does not touch the emulated system, so it is safe to call from a worker thread.
+bool CompressSaveState(const void* state_data, u32 state_size, ByteStream* out_stream);
+
 void SingleStepCPU();
 void RunFrame();
 void RunFrames();
@@ -172,9 +184,90 @@ void Throttle();
 void UpdatePerformanceCounters();
 void ResetPerformanceCounters();
 
+enum class FrameTimingComponent : u8
+{
+  CPU,
+  Events,
+  GPU,
+  SPU,
+  CDROM,
+  MDEC,
+  Recompiler,
+  Count
+};
+
+/// Set when the time spent in each component is being recorded, either for the OSD or for a trace capture.
+extern bool g_frame_timing_active;
+
+/// Enables accumulating the time the emulation thread spends in each component.
+void SetFrameTimingEnabled(bool enabled);
+bool IsFrameTimingEnabled();
+
+const char* GetFrameTimingComponentName(FrameTimingComponent component);
+
+/// Returns the time in milliseconds spent in the component during the last frame, excluding nested components.
+double GetLastFrameTiming(FrameTimingComponent component);
+
+/// Returns the average time per frame in milliseconds spent in the component, updated with the performance counters.
+float GetAverageFrameTiming(FrameTimingComponent component);
+
+/// Records every timed scope until stopped, then writes them to the file in Chrome's trace event format.
+bool StartTraceCapture(const char* filename);
+bool StopTraceCapture();
+bool IsCapturingTrace();
+
+/// Records the GPU commands for the following frames to a file, which can be booted to replay them.
+bool StartGPUDump(const char* filename, u32 max_frames);
+bool StopGPUDump();
+bool IsRecordingGPUDump();
+bool IsPlayingGPUDump();
+
+/// Records controller input from the current frame, along with a save state for playback to start from.
+bool StartInputMovieRecording(const char* filename);
+bool StopInputMovieRecording();
+bool IsRecordingInputMovie();
+
+/// Loads the movie's save state and replays its input. Host input is ignored until the movie ends. Only returns false
+/// if the state could not be loaded, which leaves the system in an undefined state.
+bool StartInputMoviePlayback(std::unique_ptr<InputMovie::Player> player);
+void StopInputMoviePlayback();
+bool IsPlayingInputMovie();
+
+/// Adds the time spent in the enclosing scope to the component's frame timing. While a nested scope is active,
+/// time is only counted towards the innermost component.
+class ScopedFrameTiming
+{
+public:
+  ALWAYS_INLINE ScopedFrameTiming(FrameTimingComponent component)
+  {
+    if (g_frame_timing_active)
+      Begin(component);
+  }
+
+  ALWAYS_INLINE ~ScopedFrameTiming()
+  {
+    if (m_active)
+      End();
+  }
+
+private:
+  void Begin(FrameTimingComponent component);
+  void End();
+
+  Common::Timer::Value m_start_time = 0;
+  FrameTimingComponent m_component = FrameTimingComponent::Count;
+  FrameTimingComponent m_parent_component = FrameTimingComponent::Count;
+  bool m_active = false;
+};
+
 // Access controllers for simulating input.
 Controller* GetController(u32 slot);
 void UpdateControllers();
+
+/// Host input should be passed through these rather than to the controller, so input movies can record or replace it.
+void SetControllerButtonState(u32 slot, s32 button_code, bool pressed);
+void SetControllerAxisState(u32 slot, s32 axis_code, float value);
+
 void UpdateControllerSettings();
 void ResetControllers();
 void UpdateMemoryCards();
@@ -233,7 +326,11 @@ void SetCheatList(std::unique_ptr<CheatList> cheats);
 //////////////////////////////////////////////////////////////////////////
 // Memory Save States (Rewind and Runahead)
 //////////////////////////////////////////////////////////////////////////
-void CalculateRewindMemoryUsage(u32 num_saves, u64* ram_usage, u64* vram_usage);
+void CalculateRewindMemoryUsage(u32 num_saves, u32 memory_budget, u64* ram_usage, u64* vram_usage);
+
+/// Returns the amount of host memory currently used by compressed rewind states and their VRAM copies.
+u64 GetRewindMemoryUsage();
+
 void ClearMemorySaveStates();
 void UpdateMemorySaveStateSettings();
 bool LoadRewindState(u32 skip_saves = 0, bool consume_state = true);
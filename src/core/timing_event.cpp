@@ -260,6 +260,7 @@ static TimingEvent* FindActiveEvent(const char* name)
 void RunEvents()
 {
   DebugAssert(!s_current_event);
+  System::ScopedFrameTiming frame_timing(System::FrameTimingComponent::Events);
 
   TickCount pending_ticks = CPU::GetPendingTicks();
   CPU::ResetPendingTicks();
@@ -160,4 +160,5 @@ enum : size_t
 {
   HOST_PAGE_SIZE = 4096,
   HOST_PAGE_OFFSET_MASK = HOST_PAGE_SIZE - 1,
+  HOST_PAGE_SHIFT = 12,
 };
@@ -0,0 +1,310 @@
+#include "headless_host_interface.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/timer.h"
+#include "frontend-common/null_host_display.h"
+#include "frontend-common/vulkan_host_display.h"
+#include "scmversion/scmversion.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+Log_SetChannel(HeadlessHostInterface);
+
+HeadlessHostInterface::HeadlessHostInterface() = default;
+
+HeadlessHostInterface::~HeadlessHostInterface() = default;
+
+std::unique_ptr<NoGUIHostInterface> HeadlessHostInterface::Create()
+{
+  return std::make_unique<HeadlessHostInterface>();
+}
+
+const char* HeadlessHostInterface::GetFrontendName() const
+{
+  return "DuckStation Headless Frontend";
+}
+
+bool HeadlessHostInterface::Initialize()
+{
+  // Skip NoGUIHostInterface::Initialize(), we don't want a window, imgui or the fullscreen UI.
+  m_command_line_flags.batch_mode = true;
+  m_command_line_flags.disable_controller_interface = true;
+  if (!CommonHostInterface::Initialize())
+    return false;
+
+  return CreateOffscreenDisplay();
+}
+
+void HeadlessHostInterface::Shutdown()
+{
+  CommonHostInterface::Shutdown();
+  DestroyOffscreenDisplay();
+}
+
+bool HeadlessHostInterface::CreateOffscreenDisplay()
+{
+  // Vulkan can render without a surface, everything else goes through the software renderer and a null display.
+  if (g_settings.gpu_renderer == GPURenderer::HardwareVulkan)
+    m_display = std::make_unique<FrontendCommon::VulkanHostDisplay>();
+  else
+    m_display = std::make_unique<FrontendCommon::NullHostDisplay>();
+
+  if (!m_display->CreateRenderDevice(WindowInfo(), g_settings.gpu_adapter, g_settings.gpu_use_debug_device, false) ||
+      !m_display->InitializeRenderDevice(GetShaderCacheBasePath(), g_settings.gpu_use_debug_device, false))
+  {
+    m_display->DestroyRenderDevice();
+    m_display.reset();
+    Log_ErrorPrintf("Failed to create offscreen host display");
+    return false;
+  }
+
+  return true;
+}
+
+void HeadlessHostInterface::DestroyOffscreenDisplay()
+{
+  if (m_display)
+  {
+    m_display->DestroyRenderDevice();
+    m_display.reset();
+  }
+}
+
+bool HeadlessHostInterface::AcquireHostDisplay()
+{
+  // Game settings can change the renderer.
+  const bool use_vulkan = (g_settings.gpu_renderer == GPURenderer::HardwareVulkan);
+  if (use_vulkan != (m_display->GetRenderAPI() == HostDisplay::RenderAPI::Vulkan))
+  {
+    DestroyOffscreenDisplay();
+    if (!CreateOffscreenDisplay())
+      return false;
+  }
+
+  return CreateHostDisplayResources();
+}
+
+void HeadlessHostInterface::ReportError(const char* message)
+{
+  Log_ErrorPrint(message);
+}
+
+bool HeadlessHostInterface::ConfirmMessage(const char* message)
+{
+  Log_InfoPrintf("Confirm: %s", message);
+  return true;
+}
+
+void HeadlessHostInterface::DisplayLoadingScreen(const char* message, int progress_min /*= -1*/,
+                                                 int progress_max /*= -1*/, int progress_value /*= -1*/)
+{
+  // there's no imgui context to draw with, so just log it
+  HostInterface::DisplayLoadingScreen(message, progress_min, progress_max, progress_value);
+}
+
+bool HeadlessHostInterface::IsFullscreen() const
+{
+  return false;
+}
+
+bool HeadlessHostInterface::SetFullscreen(bool enabled)
+{
+  return !enabled;
+}
+
+void HeadlessHostInterface::FixIncompatibleSettings(bool display_osd_messages)
+{
+  NoGUIHostInterface::FixIncompatibleSettings(display_osd_messages);
+
+  // Only Vulkan can render without a window, the other hardware renderers fall back to software.
+  if (g_settings.gpu_renderer != GPURenderer::HardwareVulkan && g_settings.gpu_renderer != GPURenderer::Software)
+  {
+    Log_WarningPrintf("The %s renderer needs a window, using the software renderer instead",
+                      Settings::GetRendererName(g_settings.gpu_renderer));
+    g_settings.gpu_renderer = GPURenderer::Software;
+  }
+
+  // There's no audio device, and we want to run as fast as possible. Rasterize on the emulation thread, otherwise
+  // the frame's GPU time only covers queuing the commands.
+  g_settings.gpu_use_thread = false;
+  g_settings.audio_backend = AudioBackend::Null;
+  g_settings.emulation_speed = 0.0f;
+  g_settings.fast_forward_speed = 0.0f;
+  g_settings.turbo_speed = 0.0f;
+  g_settings.video_sync_enabled = false;
+  g_settings.audio_sync_enabled = false;
+  g_settings.sync_to_host_refresh_rate = false;
+  g_settings.display_show_frame_timings = true;
+
+  // Don't block or leave anything behind.
+  g_settings.start_paused = false;
+  g_settings.pause_on_focus_loss = false;
+  g_settings.save_state_on_exit = false;
+  g_settings.confim_power_off = false;
+}
+
+bool HeadlessHostInterface::CreatePlatformWindow(bool fullscreen)
+{
+  return true;
+}
+
+void HeadlessHostInterface::DestroyPlatformWindow()
+{
+  // nothing to destroy
+}
+
+std::optional<WindowInfo> HeadlessHostInterface::GetPlatformWindowInfo()
+{
+  return WindowInfo();
+}
+
+void HeadlessHostInterface::Run()
+{
+  if (!InBenchmarkMode())
+  {
+    ReportError("The headless frontend can only be used for benchmarking.");
+    return;
+  }
+
+  std::vector<FrameTiming> timings;
+  timings.reserve(m_benchmark_frame_count);
+
+  Log_InfoPrintf("Running benchmark for %u frames...", m_benchmark_frame_count);
+
+  Common::Timer total_timer;
+  Common::Timer frame_timer;
+  while (timings.size() < m_benchmark_frame_count && !m_quit_request && System::IsRunning())
+  {
+    RunCallbacks();
+
+    frame_timer.Reset();
+    System::RunFrame();
+
+    // submits the frame's rendering with the hardware renderers, nothing is presented
+    m_display->Render();
+
+    FrameTiming timing;
+    timing.frame_time = frame_timer.GetTimeMilliseconds();
+    for (size_t i = 0; i < timing.component_times.size(); i++)
+      timing.component_times[i] = System::GetLastFrameTiming(static_cast<System::FrameTimingComponent>(i));
+    timings.push_back(timing);
+  }
+
+  const double total_time = total_timer.GetTimeSeconds();
+
+  if (timings.size() < m_benchmark_frame_count)
+  {
+    Log_WarningPrintf("Benchmark stopped early after %u of %u frames", static_cast<u32>(timings.size()),
+                      m_benchmark_frame_count);
+  }
+
+  WriteBenchmarkReport(timings, total_time);
+
+  if (!System::IsShutdown())
+    DestroySystem();
+}
+
+static std::string EscapeJSONString(const std::string& str)
+{
+  std::string ret;
+  ret.reserve(str.length());
+  for (const char ch : str)
+  {
+    if (ch == '"' || ch == '\\')
+    {
+      ret += '\\';
+      ret += ch;
+    }
+    else if (static_cast<unsigned char>(ch) < 0x20)
+    {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(ch));
+      ret += buf;
+    }
+    else
+    {
+      ret += ch;
+    }
+  }
+
+  return ret;
+}
+
+static void WriteTimingStatistics(std::FILE* fp, const char* name, std::vector<double> values, bool last)
+{
+  double average = 0.0, p50 = 0.0, p99 = 0.0, worst = 0.0;
+  if (!values.empty())
+  {
+    std::sort(values.begin(), values.end());
+
+    double sum = 0.0;
+    for (const double value : values)
+      sum += value;
+
+    // nearest-rank percentiles, so the values always come from a real frame
+    const auto percentile = [&values](double p) {
+      const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(values.size())));
+      return values[std::max<size_t>(rank, 1) - 1];
+    };
+
+    average = sum / static_cast<double>(values.size());
+    p50 = percentile(0.50);
+    p99 = percentile(0.99);
+    worst = values.back();
+  }
+
+  std::fprintf(fp, "  \"%s\": {\"average\": %.4f, \"p50\": %.4f, \"p99\": %.4f, \"worst\": %.4f}%s\n", name, average,
+               p50, p99, worst, last ? "" : ",");
+}
+
+void HeadlessHostInterface::WriteBenchmarkReport(const std::vector<FrameTiming>& timings, double total_time)
+{
+  std::FILE* fp = stdout;
+  if (!m_benchmark_report_filename.empty())
+  {
+    fp = FileSystem::OpenCFile(m_benchmark_report_filename.c_str(), "wb");
+    if (!fp)
+    {
+      ReportFormattedError("Failed to open benchmark report '%s' for writing.", m_benchmark_report_filename.c_str());
+      return;
+    }
+  }
+
+  std::vector<double> values(timings.size());
+
+  std::fprintf(fp, "{\n");
+  std::fprintf(fp, "  \"version\": \"%s\",\n", EscapeJSONString(g_scm_tag_str).c_str());
+  std::fprintf(fp, "  \"game_code\": \"%s\",\n", EscapeJSONString(System::GetRunningCode()).c_str());
+  std::fprintf(fp, "  \"game_title\": \"%s\",\n", EscapeJSONString(System::GetRunningTitle()).c_str());
+  std::fprintf(fp, "  \"cpu_execution_mode\": \"%s\",\n",
+               Settings::GetCPUExecutionModeName(g_settings.cpu_execution_mode));
+  std::fprintf(fp, "  \"gpu_renderer\": \"%s\",\n", Settings::GetRendererName(g_settings.gpu_renderer));
+  std::fprintf(fp, "  \"requested_frames\": %u,\n", m_benchmark_frame_count);
+  std::fprintf(fp, "  \"frames\": %u,\n", static_cast<u32>(timings.size()));
+  std::fprintf(fp, "  \"total_time\": %.4f,\n", total_time);
+  std::fprintf(fp, "  \"fps\": %.4f,\n", (total_time > 0.0) ? (static_cast<double>(timings.size()) / total_time) : 0.0);
+
+  std::transform(timings.begin(), timings.end(), values.begin(),
+                 [](const FrameTiming& timing) { return timing.frame_time; });
+  WriteTimingStatistics(fp, "frame_time", values, false);
+
+  // time spent in each component, not including any components nested inside it
+  for (u32 i = 0; i < static_cast<u32>(System::FrameTimingComponent::Count); i++)
+  {
+    std::string name(System::GetFrameTimingComponentName(static_cast<System::FrameTimingComponent>(i)));
+    std::transform(name.begin(), name.end(), name.begin(), [](char ch) { return static_cast<char>(std::tolower(ch)); });
+    name += "_time";
+
+    std::transform(timings.begin(), timings.end(), values.begin(),
+                   [i](const FrameTiming& timing) { return timing.component_times[i]; });
+    WriteTimingStatistics(fp, name.c_str(), values, (i + 1) == static_cast<u32>(System::FrameTimingComponent::Count));
+  }
+
+  std::fprintf(fp, "}\n");
+
+  if (fp != stdout)
+    std::fclose(fp);
+  else
+    std::fflush(fp);
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "core/system.h"
+#include "nogui_host_interface.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+class HeadlessHostInterface final : public NoGUIHostInterface
+{
+public:
+  HeadlessHostInterface();
+  ~HeadlessHostInterface();
+
+  static std::unique_ptr<NoGUIHostInterface> Create();
+
+  const char* GetFrontendName() const override;
+
+  bool Initialize() override;
+  void Shutdown() override;
+  void Run() override;
+
+  void ReportError(const char* message) override;
+  bool ConfirmMessage(const char* message) override;
+
+  void DisplayLoadingScreen(const char* message, int progress_min = -1, int progress_max = -1,
+                            int progress_value = -1) override;
+
+  bool IsFullscreen() const override;
+  bool SetFullscreen(bool enabled) override;
+
+protected:
+  void FixIncompatibleSettings(bool display_osd_messages) override;
+
+  bool AcquireHostDisplay() override;
+
+  bool CreatePlatformWindow(bool fullscreen) override;
+  void DestroyPlatformWindow() override;
+  std::optional<WindowInfo> GetPlatformWindowInfo() override;
+
+private:
+  struct FrameTiming
+  {
+    double frame_time;
+    std::array<double, static_cast<size_t>(System::FrameTimingComponent::Count)> component_times;
+  };
+
+  bool CreateOffscreenDisplay();
+  void DestroyOffscreenDisplay();
+
+  void WriteBenchmarkReport(const std::vector<FrameTiming>& timings, double total_time);
+};
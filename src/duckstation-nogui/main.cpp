@@ -3,6 +3,7 @@
 #include "common/log.h"
 #include "common/string_util.h"
 #include "core/system.h"
+#include "headless_host_interface.h"
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -36,11 +37,28 @@ static bool IsSDLHostInterfaceAvailable()
 #include <shellapi.h>
 #endif
 
-static std::unique_ptr<NoGUIHostInterface> CreateHostInterface()
+static bool IsBenchmarkRequested(int argc, char* argv[])
+{
+  // Benchmarks don't need a window, so we have to decide before the host interface parses the command line.
+  for (int i = 1; i < argc; i++)
+  {
+    if (std::strcmp(argv[i], "--") == 0)
+      break;
+    else if (std::strcmp(argv[i], "-benchmark") == 0)
+      return true;
+  }
+
+  return false;
+}
+
+static std::unique_ptr<NoGUIHostInterface> CreateHostInterface(bool headless)
 {
   const char* platform = std::getenv("DUCKSTATION_NOGUI_PLATFORM");
   std::unique_ptr<NoGUIHostInterface> host_interface;
 
+  if (headless || (platform && StringUtil::Strcasecmp(platform, "headless") == 0))
+    return HeadlessHostInterface::Create();
+
 #ifdef WITH_SDL2
   if (!host_interface && (!platform || StringUtil::Strcasecmp(platform, "sdl") == 0) && IsSDLHostInterfaceAvailable())
     host_interface = SDLHostInterface::Create();
@@ -90,7 +108,7 @@ static int Run(std::unique_ptr<NoGUIHostInterface> host_interface, std::unique_p
 
 int wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLine, int nShowCmd)
 {
-  std::unique_ptr<NoGUIHostInterface> host_interface = CreateHostInterface();
+  std::unique_ptr<NoGUIHostInterface> host_interface;
   std::unique_ptr<SystemBootParameters> boot_params;
 
   {
@@ -118,6 +136,8 @@ int wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLine, int
     for (std::string& arg : argc_strings)
       argc_pointers.push_back(arg.data());
 
+    host_interface =
+      CreateHostInterface(IsBenchmarkRequested(static_cast<int>(argc_pointers.size()), argc_pointers.data()));
     if (!host_interface->ParseCommandLineParameters(static_cast<int>(argc_pointers.size()), argc_pointers.data(),
                                                     &boot_params))
     {
@@ -132,7 +152,7 @@ int wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLine, int
 
 int main(int argc, char* argv[])
 {
-  std::unique_ptr<NoGUIHostInterface> host_interface = CreateHostInterface();
+  std::unique_ptr<NoGUIHostInterface> host_interface = CreateHostInterface(IsBenchmarkRequested(argc, argv));
   std::unique_ptr<SystemBootParameters> boot_params;
   if (!host_interface->ParseCommandLineParameters(argc, argv, &boot_params))
     return EXIT_FAILURE;
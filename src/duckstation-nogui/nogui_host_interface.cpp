@@ -113,7 +113,7 @@ void NoGUIHostInterface::LoadSettings()
     AddOSDMessage("Settings version mismatch, settings have been reset to defaults.", 30.0f);
 
   CommonHostInterface::LoadSettings(*m_settings_interface.get());
-  CommonHostInterface::FixIncompatibleSettings(false);
+  FixIncompatibleSettings(false);
 }
 
 void NoGUIHostInterface::UpdateInputMap()
@@ -126,7 +126,7 @@ void NoGUIHostInterface::ApplySettings(bool display_osd_messages)
   Settings old_settings(std::move(g_settings));
   CommonHostInterface::LoadSettings(*m_settings_interface.get());
   CommonHostInterface::ApplyGameSettings(display_osd_messages);
-  CommonHostInterface::FixIncompatibleSettings(display_osd_messages);
+  FixIncompatibleSettings(display_osd_messages);
   CheckForSettingsChanges(old_settings);
 }
 
@@ -166,6 +166,8 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(QtHostInterface* host_interface,
                        static_cast<u32>(CPUFastmemMode::Count), Settings::DEFAULT_CPU_FASTMEM_MODE);
   addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Enable Recompiler ICache"), "CPU",
                         "RecompilerICache", false);
+  addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Enable Recompiler Block Profiling"), "CPU",
+                        "RecompilerBlockProfiling", false);
 
   addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Enable VRAM Write Texture Replacement"),
                         "TextureReplacements", "EnableVRAMWriteReplacements", false);
@@ -192,9 +194,19 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(QtHostInterface* host_interface,
                          1000, Settings::DEFAULT_GPU_MAX_RUN_AHEAD);
   addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Use Debug Host GPU Device"), "GPU",
                         "UseDebugDevice", false);
+  addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Reorder GPU Batches"), "GPU", "ReorderBatches",
+                        false);
 
   addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Increase Timer Resolution"), "Main",
                         "IncreaseTimerResolution", true);
+  addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Compress Save States"), "Main",
+                        "CompressSaveStates", true);
+  addIntRangeTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("CHD Hunk Cache Size"), "CDROM",
+                         "CHDHunkCacheSize", 1, 256, Settings::DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE);
+  addIntRangeTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("CD-ROM Read-Ahead Sectors"), "CDROM",
+                         "ReadaheadSectors", 0, 1024, Settings::DEFAULT_CDROM_READAHEAD_SECTORS);
+  addIntRangeTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Software Renderer Threads"), "GPU",
+                         "SWRenderThreads", 1, 16, Settings::DEFAULT_GPU_SW_RENDER_THREADS);
 
   dialog->registerWidgetHelp(m_ui.logLevel, tr("Log Level"), tr("Information"),
                              tr("Sets the verbosity of messages logged. Higher levels will log more messages."));
@@ -228,12 +240,18 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
   setBooleanTweakOption(m_ui.tweakOptionTable, 11, false);
   setBooleanTweakOption(m_ui.tweakOptionTable, 12, false);
   setBooleanTweakOption(m_ui.tweakOptionTable, 13, false);
-  setIntRangeTweakOption(m_ui.tweakOptionTable, 14, Settings::DEFAULT_VRAM_WRITE_DUMP_WIDTH_THRESHOLD);
-  setIntRangeTweakOption(m_ui.tweakOptionTable, 15, Settings::DEFAULT_VRAM_WRITE_DUMP_HEIGHT_THRESHOLD);
-  setIntRangeTweakOption(m_ui.tweakOptionTable, 16, static_cast<int>(Settings::DEFAULT_DMA_MAX_SLICE_TICKS));
-  setIntRangeTweakOption(m_ui.tweakOptionTable, 17, static_cast<int>(Settings::DEFAULT_DMA_HALT_TICKS));
-  setIntRangeTweakOption(m_ui.tweakOptionTable, 18, static_cast<int>(Settings::DEFAULT_GPU_FIFO_SIZE));
-  setIntRangeTweakOption(m_ui.tweakOptionTable, 19, static_cast<int>(Settings::DEFAULT_GPU_MAX_RUN_AHEAD));
-  setBooleanTweakOption(m_ui.tweakOptionTable, 20, false);
-  setBooleanTweakOption(m_ui.tweakOptionTable, 21, true);
+  setBooleanTweakOption(m_ui.tweakOptionTable, 14, false);
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 15, Settings::DEFAULT_VRAM_WRITE_DUMP_WIDTH_THRESHOLD);
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 16, Settings::DEFAULT_VRAM_WRITE_DUMP_HEIGHT_THRESHOLD);
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 17, static_cast<int>(Settings::DEFAULT_DMA_MAX_SLICE_TICKS));
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 18, static_cast<int>(Settings::DEFAULT_DMA_HALT_TICKS));
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 19, static_cast<int>(Settings::DEFAULT_GPU_FIFO_SIZE));
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 20, static_cast<int>(Settings::DEFAULT_GPU_MAX_RUN_AHEAD));
+  setBooleanTweakOption(m_ui.tweakOptionTable, 21, false);
+  setBooleanTweakOption(m_ui.tweakOptionTable, 22, false);
+  setBooleanTweakOption(m_ui.tweakOptionTable, 23, true);
+  setBooleanTweakOption(m_ui.tweakOptionTable, 24, true);
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 25, static_cast<int>(Settings::DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE));
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 26, static_cast<int>(Settings::DEFAULT_CDROM_READAHEAD_SECTORS));
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 27, static_cast<int>(Settings::DEFAULT_GPU_SW_RENDER_THREADS));
 }
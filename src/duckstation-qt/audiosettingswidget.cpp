@@ -19,6 +19,7 @@ AudioSettingsWidget::AudioSettingsWidget(QtHostInterface* host_interface, QWidge
                                                &Settings::ParseAudioBackend, &Settings::GetAudioBackendName,
                                                Settings::DEFAULT_AUDIO_BACKEND);
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.syncToOutput, "Audio", "Sync");
+  SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.dynamicSync, "Audio", "DynamicSync");
   SettingWidgetBinder::BindWidgetToIntSetting(m_host_interface, m_ui.bufferSize, "Audio", "BufferSize");
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.startDumpingOnBoot, "Audio", "DumpOnBoot");
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.muteCDAudio, "CDROM", "MuteCDAudio");
@@ -51,6 +52,11 @@ AudioSettingsWidget::AudioSettingsWidget(QtHostInterface* host_interface, QWidge
                              tr("Throttles the emulation speed based on the audio backend pulling audio frames. This "
                                 "helps to remove noises or crackling if emulation is too fast. Sync will "
                                 "automatically be disabled if not running at 100% speed."));
+  dialog->registerWidgetHelp(
+    m_ui.dynamicSync, tr("Dynamic Sync"), tr("Unchecked"),
+    tr("Paces the emulation with the display instead of the audio, and continuously adjusts the audio resampling "
+       "rate by a fraction of a percent to keep the buffer from running dry. Avoids crackling with vsync on displays "
+       "which don't match the game's refresh rate, with lower latency than Sync To Output. Requires Sync To Output."));
   dialog->registerWidgetHelp(
     m_ui.startDumpingOnBoot, tr("Start Dumping On Boot"), tr("Unchecked"),
     tr("Start dumping audio to file as soon as the emulator is started. Mainly useful as a debug option."));
@@ -18,6 +18,8 @@ EmulationSettingsWidget::EmulationSettingsWidget(QtHostInterface* host_interface
   SettingWidgetBinder::BindWidgetToFloatSetting(m_host_interface, m_ui.rewindSaveFrequency, "Main", "RewindFrequency",
                                                 10.0f);
   SettingWidgetBinder::BindWidgetToIntSetting(m_host_interface, m_ui.rewindSaveSlots, "Main", "RewindSaveSlots", 10);
+  SettingWidgetBinder::BindWidgetToIntSetting(m_host_interface, m_ui.rewindMemoryBudget, "Main", "RewindMemoryBudget",
+                                              256);
   SettingWidgetBinder::BindWidgetToIntSetting(m_host_interface, m_ui.runaheadFrames, "Main", "RunaheadFrameCount", 0);
 
   QtUtils::FillComboBoxWithEmulationSpeeds(m_ui.emulationSpeed);
@@ -47,6 +49,8 @@ EmulationSettingsWidget::EmulationSettingsWidget(QtHostInterface* host_interface
           &EmulationSettingsWidget::updateRewind);
   connect(m_ui.rewindSaveSlots, QOverload<int>::of(&QSpinBox::valueChanged), this,
           &EmulationSettingsWidget::updateRewind);
+  connect(m_ui.rewindMemoryBudget, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          &EmulationSettingsWidget::updateRewind);
   connect(m_ui.runaheadFrames, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
           &EmulationSettingsWidget::updateRewind);
 
@@ -72,7 +76,8 @@ EmulationSettingsWidget::EmulationSettingsWidget(QtHostInterface* host_interface
     m_ui.rewindEnable, tr("Rewinding"), tr("Unchecked"),
     tr("<b>Enable Rewinding:</b> Saves state periodically so you can rewind any mistakes while playing.<br> "
 	   "<b>Rewind Save Frequency:</b> How often a rewind state will be created. Higher frequencies have greater system requirements.<br> "
-	   "<b>Rewind Buffer Size:</b> How many saves will be kept for rewinding. Higher values have greater memory requirements."));
+	   "<b>Rewind Buffer Size:</b> How many saves will be kept for rewinding. Higher values have greater memory requirements.<br> "
+	   "<b>Rewind Memory Budget:</b> Maximum amount of memory used for compressed rewind saves, including their copies of VRAM with hardware renderers. When exceeded, the oldest saves are discarded."));
   dialog->registerWidgetHelp(
     m_ui.runaheadFrames, tr("Runahead"), tr("Disabled"),
     tr("Simulates the system ahead of time and rolls back/replays to reduce input lag. Very high system requirements."));
@@ -113,21 +118,26 @@ void EmulationSettingsWidget::updateRewind()
   if (m_ui.rewindEnable->isEnabled() && m_ui.rewindEnable->isChecked())
   {
     const u32 frames = static_cast<u32>(m_ui.rewindSaveSlots->value());
+    const u32 memory_budget = static_cast<u32>(m_ui.rewindMemoryBudget->value());
     const float frequency = static_cast<float>(m_ui.rewindSaveFrequency->value());
     const float duration =
       ((frequency <= std::numeric_limits<float>::epsilon()) ? (1.0f / 60.0f) : frequency) * static_cast<float>(frames);
 
     u64 ram_usage, vram_usage;
-    System::CalculateRewindMemoryUsage(frames, &ram_usage, &vram_usage);
+    System::CalculateRewindMemoryUsage(frames, memory_budget, &ram_usage, &vram_usage);
+
+    QString summary = tr("Rewind for %1 frames, lasting %2 seconds will require up to %3MB of RAM and %4MB of VRAM.")
+                        .arg(frames)
+                        .arg(duration)
+                        .arg(ram_usage / 1048576)
+                        .arg(vram_usage / 1048576);
+    if (System::IsValid() && g_settings.rewind_enable)
+      summary += tr(" Currently using %1MB.").arg(System::GetRewindMemoryUsage() / 1048576);
 
-    m_ui.rewindSummary->setText(
-      tr("Rewind for %1 frames, lasting %2 seconds will require up to %3MB of RAM and %4MB of VRAM.")
-        .arg(frames)
-        .arg(duration)
-        .arg(ram_usage / 1048576)
-        .arg(vram_usage / 1048576));
+    m_ui.rewindSummary->setText(summary);
     m_ui.rewindSaveFrequency->setEnabled(true);
     m_ui.rewindSaveSlots->setEnabled(true);
+    m_ui.rewindMemoryBudget->setEnabled(true);
   }
   else
   {
@@ -143,5 +153,6 @@ void EmulationSettingsWidget::updateRewind()
     }
     m_ui.rewindSaveFrequency->setEnabled(false);
     m_ui.rewindSaveSlots->setEnabled(false);
+    m_ui.rewindMemoryBudget->setEnabled(false);
   }
 }
@@ -53,6 +53,16 @@ int main(int argc, char* argv[])
   if (!ParseCommandLineParameters(app, host_interface.get(), &boot_params))
     return EXIT_FAILURE;
 
+  // The benchmark runs without a window and exits when done, which only the NoGUI frontend does.
+  if (host_interface->InBenchmarkMode())
+  {
+    QMessageBox::critical(nullptr, QObject::tr("DuckStation Error"),
+                          QObject::tr("-benchmark is not supported by the Qt frontend. Run it with "
+                                      "duckstation-nogui instead."),
+                          QMessageBox::Ok);
+    return EXIT_FAILURE;
+  }
+
   std::unique_ptr<MainWindow> window = std::make_unique<MainWindow>(host_interface.get());
 
   if (!host_interface->Initialize())
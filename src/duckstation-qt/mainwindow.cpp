@@ -843,6 +843,7 @@ void MainWindow::updateEmulationActions(bool starting, bool running)
   m_ui.actionDumpRAM->setDisabled(starting || !running);
   m_ui.actionDumpVRAM->setDisabled(starting || !running);
   m_ui.actionDumpSPURAM->setDisabled(starting || !running);
+  m_ui.actionDumpBlockProfile->setDisabled(starting || !running);
 
   m_ui.actionSaveState->setDisabled(starting || !running);
   m_ui.menuSaveState->setDisabled(starting || !running);
@@ -1090,6 +1091,14 @@ void MainWindow::connectSignals()
 
     m_host_interface->dumpSPURAM(filename);
   });
+  connect(m_ui.actionDumpBlockProfile, &QAction::triggered, [this]() {
+    const QString filename =
+      QFileDialog::getSaveFileName(this, tr("Destination File"), QString(), tr("Text Files (*.txt)"));
+    if (filename.isEmpty())
+      return;
+
+    m_host_interface->dumpCodeCacheProfile(filename);
+  });
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.actionDebugShowVRAM, "Debug", "ShowVRAM");
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.actionDebugShowGPUState, "Debug", "ShowGPUState");
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.actionDebugShowCDROMState, "Debug",
@@ -1348,6 +1348,17 @@ void QtHostInterface::dumpSPURAM(const QString& filename)
     ReportFormattedMessage("Failed to dump SPU RAM to '%s'", filename_str.c_str());
 }
 
+void QtHostInterface::dumpCodeCacheProfile(const QString& filename)
+{
+  if (!isOnWorkerThread())
+  {
+    QMetaObject::invokeMethod(this, "dumpCodeCacheProfile", Qt::QueuedConnection, Q_ARG(const QString&, filename));
+    return;
+  }
+
+  DumpBlockProfile(filename.toStdString().c_str());
+}
+
 void QtHostInterface::saveScreenshot()
 {
   if (!isOnWorkerThread())
@@ -172,6 +172,7 @@ public Q_SLOTS:
   void dumpRAM(const QString& filename);
   void dumpVRAM(const QString& filename);
   void dumpSPURAM(const QString& filename);
+  void dumpCodeCacheProfile(const QString& filename);
   void saveScreenshot();
   void redrawDisplayWindow();
   void toggleFullscreen();
@@ -13,6 +13,7 @@
 #include "core/dma.h"
 #include "core/gpu.h"
 #include "core/host_display.h"
+#include "core/input_movie.h"
 #include "core/mdec.h"
 #include "core/pgxp.h"
 #include "core/save_state_version.h"
@@ -125,9 +126,13 @@ void CommonHostInterface::InitializeUserDirectory()
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("covers").c_str(), false);
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("dump").c_str(), false);
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("dump/audio").c_str(), false);
+  result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("dump/traces").c_str(), false);
+  result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("dump/gpu").c_str(), false);
+  result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("dump/profiles").c_str(), false);
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("dump/textures").c_str(), false);
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("inputprofiles").c_str(), false);
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("memcards").c_str(), false);
+  result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("movies").c_str(), false);
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("savestates").c_str(), false);
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("screenshots").c_str(), false);
   result &= FileSystem::CreateDirectory(GetUserDirectoryRelativePath("shaders").c_str(), false);
@@ -158,6 +163,12 @@ bool CommonHostInterface::BootSystem(const SystemBootParameters& parameters)
   if (g_settings.audio_dump_on_boot)
     StartDumpingAudio();
 
+  if (!m_input_movie_record_filename.empty())
+  {
+    StartInputMovieRecording(m_input_movie_record_filename.c_str());
+    m_input_movie_record_filename.clear();
+  }
+
   UpdateSpeedLimiterState();
   return true;
 }
@@ -226,6 +237,18 @@ static void PrintCommandLineHelp(const char* progname, const char* frontend_name
                        "                 the emulator.\n");
   std::fprintf(stderr, "  -settings <filename>: Loads a custom settings configuration from the\n"
                        "    specified filename. Default settings applied if file not found.\n");
+  std::fprintf(stderr, "  -benchmark <frames>: Runs the specified number of frames without a display,\n"
+                       "    audio or speed limit, then writes frame timings as JSON and exits.\n"
+                       "    Uses the software renderer unless Vulkan is selected. Boot a .psxgpu\n"
+                       "    GPU dump to replay its commands without emulating the CPU. Not\n"
+                       "    supported by the Qt frontend.\n");
+  std::fprintf(stderr, "  -benchmarkreport <filename>: Writes the benchmark report to the specified\n"
+                       "    filename instead of stdout.\n");
+  std::fprintf(stderr, "  -playmovie <filename>: Boots from the input movie's save state and replays\n"
+                       "    its controller input. No boot filename is required with this option.\n"
+                       "    Combine with -benchmark to time the same section of gameplay.\n");
+  std::fprintf(stderr, "  -recordmovie <filename>: Records controller input to an input movie from\n"
+                       "    the start of the game, until the system is powered off.\n");
   std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
                        "    parameters make up the filename. Use when the filename contains\n"
                        "    spaces or starts with a dash.\n");
@@ -243,6 +266,7 @@ bool CommonHostInterface::ParseCommandLineParameters(int argc, char* argv[],
   std::optional<s32> state_index;
   std::string state_filename;
   std::string boot_filename;
+  std::string input_movie_filename;
   bool no_more_args = false;
 
   for (int i = 1; i < argc; i++)
@@ -330,6 +354,36 @@ bool CommonHostInterface::ParseCommandLineParameters(int argc, char* argv[],
         m_settings_filename = argv[++i];
         continue;
       }
+      else if (CHECK_ARG_PARAM("-benchmark"))
+      {
+        const int frame_count = std::atoi(argv[++i]);
+        if (frame_count <= 0)
+        {
+          Log_ErrorPrintf("Invalid benchmark frame count: '%s'", argv[i]);
+          return false;
+        }
+
+        Log_InfoPrintf("Benchmarking for %d frames.", frame_count);
+        m_benchmark_frame_count = static_cast<u32>(frame_count);
+        m_command_line_flags.batch_mode = true;
+        m_command_line_flags.disable_controller_interface = true;
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmarkreport"))
+      {
+        m_benchmark_report_filename = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-playmovie"))
+      {
+        input_movie_filename = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-recordmovie"))
+      {
+        m_input_movie_record_filename = argv[++i];
+        continue;
+      }
       else if (CHECK_ARG("--"))
       {
         no_more_args = true;
@@ -350,7 +404,13 @@ bool CommonHostInterface::ParseCommandLineParameters(int argc, char* argv[],
     boot_filename += argv[i];
   }
 
-  if (state_index.has_value() || !boot_filename.empty() || !state_filename.empty())
+  if (!input_movie_filename.empty() && !m_input_movie_record_filename.empty())
+  {
+    Log_ErrorPrintf("An input movie can't be played and recorded at the same time.");
+    return false;
+  }
+
+  if (state_index.has_value() || !boot_filename.empty() || !state_filename.empty() || !input_movie_filename.empty())
   {
     // init user directory early since we need it for save states
     SetUserDirectory();
@@ -404,6 +464,7 @@ bool CommonHostInterface::ParseCommandLineParameters(int argc, char* argv[],
     boot_params->filename = std::move(boot_filename);
     boot_params->override_fast_boot = std::move(force_fast_boot);
     boot_params->override_fullscreen = std::move(force_fullscreen);
+    boot_params->input_movie_filename = std::move(input_movie_filename);
 
     if (!state_filename.empty())
     {
@@ -643,9 +704,13 @@ void CommonHostInterface::UpdateSpeedLimiterState()
     !System::IsRunning() || (m_throttler_enabled && g_settings.audio_sync_enabled && !is_non_standard_speed);
   const bool video_sync_enabled =
     !System::IsRunning() || (m_throttler_enabled && g_settings.video_sync_enabled && !is_non_standard_speed);
+
+  // Dynamic sync never blocks the emulation thread on audio, the throttler or vsync paces it instead, and the audio
+  // stream absorbs the drift between the two clocks by resampling. Needs the resampler, so only while running.
+  const bool audio_dynamic_sync = System::IsRunning() && audio_sync_enabled && g_settings.audio_dynamic_sync;
   const float max_display_fps = (!System::IsValid() || m_throttler_enabled) ? 0.0f : g_settings.display_max_fps;
   Log_InfoPrintf("Target speed: %f%%", target_speed * 100.0f);
-  Log_InfoPrintf("Syncing to %s%s", audio_sync_enabled ? "audio" : "",
+  Log_InfoPrintf("Syncing to %s%s", audio_sync_enabled ? (audio_dynamic_sync ? "audio (dynamic)" : "audio") : "",
                  (audio_sync_enabled && video_sync_enabled) ? " and video" : (video_sync_enabled ? "video" : ""));
   Log_InfoPrintf("Max display fps: %f (%s)", max_display_fps,
                  m_display_all_frames ? "displaying all frames" : "skipping displaying frames when needed");
@@ -666,7 +731,8 @@ void CommonHostInterface::UpdateSpeedLimiterState()
     m_audio_stream->SetInputSampleRate(input_sample_rate);
     m_audio_stream->SetWaitForBufferFill(!m_display_all_frames);
     m_audio_stream->SetOutputVolume(GetAudioOutputVolume());
-    m_audio_stream->SetSync(audio_sync_enabled);
+    m_audio_stream->SetSync(audio_sync_enabled && !audio_dynamic_sync);
+    m_audio_stream->SetDynamicSync(audio_dynamic_sync);
     if (audio_sync_enabled)
       m_audio_stream->EmptyBuffers();
   }
@@ -854,13 +920,17 @@ void CommonHostInterface::DrawImGuiWindows()
 void CommonHostInterface::DrawFPSWindow()
 {
   if (!(g_settings.display_show_fps | g_settings.display_show_vps | g_settings.display_show_speed |
-        g_settings.display_show_resolution))
+        g_settings.display_show_resolution | g_settings.display_show_frame_timings))
   {
     return;
   }
 
-  const ImVec2 window_size =
-    ImVec2(175.0f * ImGui::GetIO().DisplayFramebufferScale.x, 48.0f * ImGui::GetIO().DisplayFramebufferScale.y);
+  const float window_height =
+    48.0f + (g_settings.display_show_frame_timings ?
+               (16.0f * static_cast<float>(System::FrameTimingComponent::Count)) :
+               0.0f);
+  const ImVec2 window_size = ImVec2(175.0f * ImGui::GetIO().DisplayFramebufferScale.x,
+                                    window_height * ImGui::GetIO().DisplayFramebufferScale.y);
   ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - window_size.x, 0.0f), ImGuiCond_Always);
   ImGui::SetNextWindowSize(window_size);
 
@@ -924,6 +994,16 @@ void CommonHostInterface::DrawFPSWindow()
     ImGui::Text("%ux%u (%s)", effective_width, effective_height, interlaced ? "interlaced" : "progressive");
   }
 
+  if (g_settings.display_show_frame_timings)
+  {
+    for (u32 i = 0; i < static_cast<u32>(System::FrameTimingComponent::Count); i++)
+    {
+      const System::FrameTimingComponent component = static_cast<System::FrameTimingComponent>(i);
+      ImGui::Text("%s: %.2fms", System::GetFrameTimingComponentName(component),
+                  System::GetAverageFrameTiming(component));
+    }
+  }
+
   ImGui::End();
 }
 
@@ -1235,9 +1315,7 @@ void CommonHostInterface::UpdateControllerInputMap(SettingsInterface& si)
           if (System::IsShutdown())
             return;
 
-          Controller* controller = System::GetController(controller_index);
-          if (controller)
-            controller->SetButtonState(button_code, pressed);
+          System::SetControllerButtonState(controller_index, button_code, pressed);
         });
       }
     }
@@ -1261,9 +1339,7 @@ void CommonHostInterface::UpdateControllerInputMap(SettingsInterface& si)
           if (System::IsShutdown())
             return;
 
-          Controller* controller = System::GetController(controller_index);
-          if (controller)
-            controller->SetAxisState(axis_code, value);
+          System::SetControllerAxisState(controller_index, axis_code, value);
         });
       }
     }
@@ -1670,6 +1746,45 @@ void CommonHostInterface::RegisterGeneralHotkeys()
                      SaveScreenshot();
                  });
 
+  RegisterHotkey(StaticString(TRANSLATABLE("Hotkeys", "General")), StaticString("ToggleTraceCapture"),
+                 StaticString(TRANSLATABLE("Hotkeys", "Toggle Trace Capture")), [this](bool pressed) {
+                   if (!pressed || !System::IsValid())
+                     return;
+
+                   if (IsCapturingTrace())
+                     StopTraceCapture();
+                   else
+                     StartTraceCapture();
+                 });
+
+  RegisterHotkey(StaticString(TRANSLATABLE("Hotkeys", "General")), StaticString("ToggleGPUDump"),
+                 StaticString(TRANSLATABLE("Hotkeys", "Toggle GPU Dump Recording")), [this](bool pressed) {
+                   if (!pressed || !System::IsValid())
+                     return;
+
+                   if (IsRecordingGPUDump())
+                     StopGPUDump();
+                   else
+                     StartGPUDump();
+                 });
+
+  RegisterHotkey(StaticString(TRANSLATABLE("Hotkeys", "General")), StaticString("DumpBlockProfile"),
+                 StaticString(TRANSLATABLE("Hotkeys", "Dump Block Profile")), [this](bool pressed) {
+                   if (pressed && System::IsValid())
+                     DumpBlockProfile();
+                 });
+
+  RegisterHotkey(StaticString(TRANSLATABLE("Hotkeys", "General")), StaticString("ToggleInputMovieRecording"),
+                 StaticString(TRANSLATABLE("Hotkeys", "Toggle Input Movie Recording")), [this](bool pressed) {
+                   if (!pressed || !System::IsValid())
+                     return;
+
+                   if (IsRecordingInputMovie())
+                     StopInputMovieRecording();
+                   else
+                     StartInputMovieRecording();
+                 });
+
   RegisterHotkey(StaticString(TRANSLATABLE("Hotkeys", "General")), StaticString("FrameStep"),
                  StaticString(TRANSLATABLE("Hotkeys", "Frame Step")), [this](bool pressed) {
                    if (pressed && System::IsValid())
@@ -2180,6 +2295,8 @@ std::vector<CommonHostInterface::SaveStateInfo> CommonHostInterface::GetAvailabl
 
 std::optional<CommonHostInterface::SaveStateInfo> CommonHostInterface::GetSaveStateInfo(const char* game_code, s32 slot)
 {
+  WaitForSaveStateWrite();
+
   const bool global = (!game_code || game_code[0] == 0);
   std::string path = global ? GetGlobalSaveStateFileName(slot) : GetGameSaveStateFileName(game_code, slot);
 
@@ -2193,6 +2310,8 @@ std::optional<CommonHostInterface::SaveStateInfo> CommonHostInterface::GetSaveSt
 std::optional<CommonHostInterface::ExtendedSaveStateInfo>
 CommonHostInterface::GetExtendedSaveStateInfo(const char* game_code, s32 slot)
 {
+  WaitForSaveStateWrite();
+
   const bool global = (!game_code || game_code[0] == 0);
   std::string path = global ? GetGlobalSaveStateFileName(slot) : GetGameSaveStateFileName(game_code, slot);
 
@@ -2370,6 +2489,7 @@ void CommonHostInterface::CheckForSettingsChanges(const Settings& old_settings)
         g_settings.audio_buffer_size != old_settings.audio_buffer_size ||
         g_settings.video_sync_enabled != old_settings.video_sync_enabled ||
         g_settings.audio_sync_enabled != old_settings.audio_sync_enabled ||
+        g_settings.audio_dynamic_sync != old_settings.audio_dynamic_sync ||
         g_settings.increase_timer_resolution != old_settings.increase_timer_resolution ||
         g_settings.emulation_speed != old_settings.emulation_speed ||
         g_settings.fast_forward_speed != old_settings.fast_forward_speed ||
@@ -2557,6 +2677,244 @@ void CommonHostInterface::StopDumpingAudio()
   AddOSDMessage(TranslateStdString("OSDMessage", "Stopped dumping audio."), 5.0f);
 }
 
+bool CommonHostInterface::IsCapturingTrace() const
+{
+  return System::IsCapturingTrace();
+}
+
+bool CommonHostInterface::StartTraceCapture(const char* filename)
+{
+  if (System::IsShutdown())
+    return false;
+
+  std::string auto_filename;
+  if (!filename)
+  {
+    const auto& code = System::GetRunningCode();
+    if (code.empty())
+    {
+      auto_filename =
+        GetUserDirectoryRelativePath("dump/traces/%s.json", GetTimestampStringForFileName().GetCharArray());
+    }
+    else
+    {
+      auto_filename = GetUserDirectoryRelativePath("dump/traces/%s_%s.json", code.c_str(),
+                                                   GetTimestampStringForFileName().GetCharArray());
+    }
+
+    filename = auto_filename.c_str();
+  }
+
+  if (System::StartTraceCapture(filename))
+  {
+    AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "Started capturing trace to '%s'."), filename);
+    return true;
+  }
+  else
+  {
+    AddFormattedOSDMessage(10.0f, TranslateString("OSDMessage", "Failed to start capturing trace to '%s'."),
+                           filename);
+    return false;
+  }
+}
+
+void CommonHostInterface::StopTraceCapture()
+{
+  if (!System::IsCapturingTrace())
+    return;
+
+  if (System::StopTraceCapture())
+    AddOSDMessage(TranslateStdString("OSDMessage", "Stopped capturing trace."), 5.0f);
+  else
+    AddOSDMessage(TranslateStdString("OSDMessage", "Failed to write trace capture."), 10.0f);
+}
+
+bool CommonHostInterface::IsRecordingGPUDump() const
+{
+  return System::IsRecordingGPUDump();
+}
+
+bool CommonHostInterface::StartGPUDump(const char* filename /* = nullptr */, u32 max_frames /* = 0 */)
+{
+  if (System::IsShutdown() || System::IsRecordingGPUDump())
+    return false;
+
+  std::string auto_filename;
+  if (!filename)
+  {
+    const auto& code = System::GetRunningCode();
+    if (code.empty())
+    {
+      auto_filename =
+        GetUserDirectoryRelativePath("dump/gpu/%s.psxgpu", GetTimestampStringForFileName().GetCharArray());
+    }
+    else
+    {
+      auto_filename = GetUserDirectoryRelativePath("dump/gpu/%s_%s.psxgpu", code.c_str(),
+                                                   GetTimestampStringForFileName().GetCharArray());
+    }
+
+    filename = auto_filename.c_str();
+  }
+
+  if (System::StartGPUDump(filename, max_frames))
+  {
+    AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "Started recording GPU dump to '%s'."), filename);
+    return true;
+  }
+  else
+  {
+    AddFormattedOSDMessage(10.0f, TranslateString("OSDMessage", "Failed to start recording GPU dump to '%s'."),
+                           filename);
+    return false;
+  }
+}
+
+void CommonHostInterface::StopGPUDump()
+{
+  if (!System::IsRecordingGPUDump())
+    return;
+
+  if (System::StopGPUDump())
+    AddOSDMessage(TranslateStdString("OSDMessage", "Stopped recording GPU dump."), 5.0f);
+  else
+    AddOSDMessage(TranslateStdString("OSDMessage", "Failed to write GPU dump."), 10.0f);
+}
+
+bool CommonHostInterface::DumpBlockProfile(const char* filename /* = nullptr */)
+{
+  if (System::IsShutdown())
+    return false;
+
+  if (!g_settings.cpu_recompiler_block_profiling)
+  {
+    AddOSDMessage(TranslateStdString("OSDMessage", "Block profiling is not enabled."), 5.0f);
+    return false;
+  }
+
+  std::string auto_filename;
+  if (!filename)
+  {
+    const auto& code = System::GetRunningCode();
+    if (code.empty())
+    {
+      auto_filename =
+        GetUserDirectoryRelativePath("dump/profiles/%s.txt", GetTimestampStringForFileName().GetCharArray());
+    }
+    else
+    {
+      auto_filename = GetUserDirectoryRelativePath("dump/profiles/%s_%s.txt", code.c_str(),
+                                                   GetTimestampStringForFileName().GetCharArray());
+    }
+
+    filename = auto_filename.c_str();
+  }
+
+  if (CPU::CodeCache::DumpProfile(filename))
+  {
+    AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "Block profile dumped to '%s'."), filename);
+    return true;
+  }
+  else
+  {
+    AddFormattedOSDMessage(10.0f, TranslateString("OSDMessage", "Failed to dump block profile to '%s'."), filename);
+    return false;
+  }
+}
+
+bool CommonHostInterface::IsRecordingInputMovie() const
+{
+  return System::IsRecordingInputMovie();
+}
+
+bool CommonHostInterface::StartInputMovieRecording(const char* filename /* = nullptr */)
+{
+  if (System::IsShutdown() || System::IsRecordingInputMovie() || System::IsPlayingInputMovie())
+    return false;
+
+  std::string auto_filename;
+  if (!filename)
+  {
+    const auto& code = System::GetRunningCode();
+    if (code.empty())
+    {
+      auto_filename = GetUserDirectoryRelativePath("movies/%s.psxmovie", GetTimestampStringForFileName().GetCharArray());
+    }
+    else
+    {
+      auto_filename = GetUserDirectoryRelativePath("movies/%s_%s.psxmovie", code.c_str(),
+                                                   GetTimestampStringForFileName().GetCharArray());
+    }
+
+    filename = auto_filename.c_str();
+  }
+
+  if (System::StartInputMovieRecording(filename))
+  {
+    AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "Started recording input movie to '%s'."), filename);
+    return true;
+  }
+  else
+  {
+    AddFormattedOSDMessage(10.0f, TranslateString("OSDMessage", "Failed to start recording input movie to '%s'."),
+                           filename);
+    return false;
+  }
+}
+
+void CommonHostInterface::StopInputMovieRecording()
+{
+  if (!System::IsRecordingInputMovie())
+    return;
+
+  if (System::StopInputMovieRecording())
+    AddOSDMessage(TranslateStdString("OSDMessage", "Stopped recording input movie."), 5.0f);
+  else
+    AddOSDMessage(TranslateStdString("OSDMessage", "Failed to write input movie."), 10.0f);
+}
+
+bool CommonHostInterface::IsPlayingInputMovie() const
+{
+  return System::IsPlayingInputMovie();
+}
+
+bool CommonHostInterface::StartInputMoviePlayback(const char* filename)
+{
+  if (System::IsShutdown() || System::IsRecordingInputMovie() || System::IsPlayingInputMovie() ||
+      System::IsPlayingGPUDump())
+  {
+    return false;
+  }
+
+  // open the movie first, so a bad file doesn't cost the running game
+  std::unique_ptr<InputMovie::Player> player = InputMovie::Player::Open(filename);
+  if (!player)
+  {
+    ReportFormattedError(TranslateString("OSDMessage", "Failed to open input movie '%s'."), filename);
+    return false;
+  }
+
+  if (!System::StartInputMoviePlayback(std::move(player)))
+  {
+    ReportFormattedError(TranslateString("OSDMessage", "Failed to play input movie '%s'. Resetting."), filename);
+    ResetSystem();
+    return false;
+  }
+
+  System::ResetPerformanceCounters();
+  AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "Playing input movie '%s'."), filename);
+  return true;
+}
+
+void CommonHostInterface::StopInputMoviePlayback()
+{
+  if (!System::IsPlayingInputMovie())
+    return;
+
+  System::StopInputMoviePlayback();
+  AddOSDMessage(TranslateStdString("OSDMessage", "Stopped playing input movie."), 5.0f);
+}
+
 bool CommonHostInterface::SaveScreenshot(const char* filename /* = nullptr */, bool full_resolution /* = true */,
                                          bool apply_aspect_ratio /* = true */, bool compress_on_thread /* = true */)
 {
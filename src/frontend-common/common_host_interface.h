@@ -130,6 +130,9 @@ public:
   /// Returns true if running in batch mode, i.e. exit after emulation.
   ALWAYS_INLINE bool InBatchMode() const { return m_command_line_flags.batch_mode; }
 
+  /// Returns true if running a benchmark, i.e. a fixed number of frames as fast as possible with no display.
+  ALWAYS_INLINE bool InBenchmarkMode() const { return (m_benchmark_frame_count > 0); }
+
   /// Returns true if the fullscreen UI is enabled.
   ALWAYS_INLINE bool IsFullscreenUIEnabled() const { return m_fullscreen_ui_enabled; }
 
@@ -201,6 +204,49 @@ public:
   /// Stops dumping audio to file if it has been started.
   void StopDumpingAudio();
 
+  /// Returns true if currently capturing a trace of the emulated components.
+  bool IsCapturingTrace() const;
+
+  /// Starts capturing a trace of the emulated components. If no file name is provided, one will be generated
+  /// automatically. The trace is written when the capture is stopped.
+  bool StartTraceCapture(const char* filename = nullptr);
+
+  /// Stops capturing a trace and writes it to file, if it has been started.
+  void StopTraceCapture();
+
+  /// Returns true if currently recording a GPU dump.
+  bool IsRecordingGPUDump() const;
+
+  /// Starts recording the GPU commands from the next frame, which can be booted later to replay them. If no file name
+  /// is provided, one will be generated automatically. Stops after max_frames, or when stopped if zero.
+  bool StartGPUDump(const char* filename = nullptr, u32 max_frames = 0);
+
+  /// Stops recording a GPU dump, if it has been started.
+  void StopGPUDump();
+
+  /// Writes the hottest recompiler blocks to a text file, if block profiling is enabled. If no file name is provided,
+  /// one will be generated automatically.
+  bool DumpBlockProfile(const char* filename = nullptr);
+
+  /// Returns true if currently recording an input movie.
+  bool IsRecordingInputMovie() const;
+
+  /// Starts recording controller input to an input movie, from a save state of the current frame. If no file name is
+  /// provided, one will be generated automatically.
+  bool StartInputMovieRecording(const char* filename = nullptr);
+
+  /// Stops recording an input movie and writes it to file, if it has been started.
+  void StopInputMovieRecording();
+
+  /// Returns true if currently playing an input movie.
+  bool IsPlayingInputMovie() const;
+
+  /// Loads the input movie's save state and replays its controller input, ignoring host input until it ends.
+  bool StartInputMoviePlayback(const char* filename);
+
+  /// Stops playing an input movie, returning control to host input.
+  void StopInputMoviePlayback();
+
   /// Saves a screenshot to the specified file. IF no file name is provided, one will be generated automatically.
   bool SaveScreenshot(const char* filename = nullptr, bool full_resolution = true, bool apply_aspect_ratio = true,
                       bool compress_on_thread = true);
@@ -379,6 +425,13 @@ protected:
 
   std::string m_settings_filename;
 
+  // number of frames to run for, and where to write the timing report (stdout if empty)
+  u32 m_benchmark_frame_count = 0;
+  std::string m_benchmark_report_filename;
+
+  // input movie to start recording once the system boots, from the command line
+  std::string m_input_movie_record_filename;
+
   std::unique_ptr<GameList> m_game_list;
 
   std::unique_ptr<ControllerInterface> m_controller_interface;
@@ -6,6 +6,7 @@
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/make_array.h"
+#include "common/md5_digest.h"
 #include "common/string.h"
 #include "common/string_util.h"
 #include "common_host_interface.h"
@@ -28,6 +29,10 @@
 #include "imgui_styles.h"
 #include "scmversion/scmversion.h"
 #include <bitset>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
 #include <thread>
 Log_SetChannel(FullscreenUI);
 
@@ -172,9 +177,46 @@ static void SortGameList();
 static HostDisplayTexture* GetTextureForGameListEntryType(GameListEntryType type);
 static HostDisplayTexture* GetGameListCover(const GameListEntry* entry);
 static HostDisplayTexture* GetCoverForCurrentGame();
+static void QueueCoverLoad(const GameListEntry* entry);
+static void UploadLoadedCovers();
+static void ShutdownCoverLoader();
 
-// Lazily populated cover images.
-static std::unordered_map<std::string, std::unique_ptr<HostDisplayTexture>> s_cover_image_map;
+// Covers are decoded and downscaled on a worker thread, with the downscaled copy cached on disk so later loads are
+// cheap. Only the most recently drawn MAX_COVER_TEXTURES covers are kept on the GPU.
+static constexpr u32 COVER_THUMBNAIL_SIZE = 512;
+static constexpr u32 MAX_COVER_TEXTURES = 128;
+static constexpr u32 MAX_COVER_UPLOADS_PER_FRAME = 2;
+
+struct CoverImage
+{
+  std::unique_ptr<HostDisplayTexture> texture;
+  std::list<std::string>::iterator lru_it;
+};
+
+struct CoverLoadRequest
+{
+  std::string path;
+  std::string code;
+  std::string title;
+};
+
+struct CoverLoadResult
+{
+  std::string path;
+  Common::RGBA8Image image;
+};
+
+// Lazily populated cover images, keyed by game path. Entries without a texture are either still loading or have no
+// cover. Entries with a texture are also in the LRU list, most recently drawn first.
+static std::unordered_map<std::string, CoverImage> s_cover_image_map;
+static std::list<std::string> s_cover_image_lru;
+
+static std::thread s_cover_load_thread;
+static std::mutex s_cover_load_mutex;
+static std::condition_variable s_cover_load_cv;
+static std::deque<CoverLoadRequest> s_cover_load_requests;
+static std::vector<CoverLoadResult> s_cover_load_results;
+static bool s_cover_load_thread_shutdown = false;
 static std::vector<const GameListEntry*> s_game_list_sorted_entries;
 static std::thread s_game_list_load_thread;
 
@@ -255,7 +297,7 @@ void Shutdown()
     s_game_list_load_thread.join();
 
   CloseSaveStateSelector();
-  s_cover_image_map.clear();
+  ShutdownCoverLoader();
   s_nav_input_values = {};
   DestroyResources();
 
@@ -265,6 +307,9 @@ void Shutdown()
 
 void Render()
 {
+  // Evicting textures here is safe, since nothing has been drawn with them yet this frame.
+  UploadLoadedCovers();
+
   if (s_debug_menu_enabled)
   {
     DrawDebugMenu();
@@ -443,13 +488,14 @@ std::unique_ptr<HostDisplayTexture> LoadTextureResource(const char* name)
 
 static ImGuiFullscreen::FileSelectorFilters GetDiscImageFilters()
 {
-  return {"*.bin", "*.cue", "*.iso", "*.img", "*.chd", "*.psexe", "*.exe", "*.psf", "*.minipsf", "*.m3u"};
+  return {"*.bin", "*.cue", "*.iso", "*.img", "*.chd", "*.psexe", "*.exe", "*.psf", "*.minipsf", "*.m3u", "*.psxgpu"};
 }
 
 static void DoStartPath(const std::string& path, bool allow_resume)
 {
-  // we can never resume from exe/psf
-  if (System::IsExeFileName(path.c_str()) || System::IsPsfFileName(path.c_str()))
+  // we can never resume from exe/psf/gpu dumps
+  if (System::IsExeFileName(path.c_str()) || System::IsPsfFileName(path.c_str()) ||
+      System::IsGPUDumpFileName(path.c_str()))
     allow_resume = false;
 
   if (allow_resume && g_settings.save_state_on_exit)
@@ -570,8 +616,8 @@ static void DoToggleAnalogMode()
     if (!code.has_value())
       continue;
 
-    ctrl->SetButtonState(code.value(), true);
-    ctrl->SetButtonState(code.value(), false);
+    System::SetControllerButtonState(i, code.value(), true);
+    System::SetControllerButtonState(i, code.value(), false);
   }
 }
 
@@ -1287,6 +1333,12 @@ void DrawSettingsWindow()
                       "How many saves will be kept for rewinding. Higher values have greater memory requirements.",
                       reinterpret_cast<s32*>(&s_settings_copy.rewind_save_slots), 1, 10000, 1, "%d Frames",
                       s_settings_copy.rewind_enable);
+        settings_changed |=
+          RangeButton("Rewind Memory Budget",
+                      "Maximum amount of memory used for compressed rewind states, including their copies of VRAM "
+                      "with hardware renderers. Older saves are discarded first.",
+                      reinterpret_cast<s32*>(&s_settings_copy.rewind_memory_budget), 1, 8192, 1, "%d MB",
+                      s_settings_copy.rewind_enable);
 
         TinyString summary;
         if (!s_settings_copy.IsRunaheadEnabled())
@@ -1331,10 +1383,14 @@ void DrawSettingsWindow()
                                  static_cast<float>(s_settings_copy.rewind_save_slots);
 
           u64 ram_usage, vram_usage;
-          System::CalculateRewindMemoryUsage(s_settings_copy.rewind_save_slots, &ram_usage, &vram_usage);
+          System::CalculateRewindMemoryUsage(s_settings_copy.rewind_save_slots, s_settings_copy.rewind_memory_budget,
+                                             &ram_usage, &vram_usage);
           rewind_summary.Format("Rewind for %u frames, lasting %.2f seconds will require up to %" PRIu64
                                 "MB of RAM and %" PRIu64 "MB of VRAM.",
                                 s_settings_copy.rewind_save_slots, duration, ram_usage / 1048576, vram_usage / 1048576);
+          if (System::IsValid() && g_settings.rewind_enable)
+            rewind_summary.AppendFormattedString(" Currently using %" PRIu64 "MB.",
+                                                 System::GetRewindMemoryUsage() / 1048576);
         }
         else
         {
@@ -1664,6 +1720,10 @@ void DrawSettingsWindow()
           ToggleButton("Show Resolution",
                        "Shows the current rendering resolution of the system in the top-right corner of the display.",
                        &s_settings_copy.display_show_resolution);
+        settings_changed |= ToggleButton(
+          "Show Frame Timings",
+          "Shows how long the CPU, GPU, SPU and other components take to emulate each frame, in milliseconds.",
+          &s_settings_copy.display_show_frame_timings);
 
         EndMenuButtons();
       }
@@ -1786,6 +1846,10 @@ void DrawSettingsWindow()
                                          "Throttles the emulation speed based on the audio backend pulling audio "
                                          "frames. Enable to reduce the chances of crackling.",
                                          &s_settings_copy.audio_sync_enabled);
+        settings_changed |= ToggleButton("Dynamic Sync",
+                                         "Keeps the emulator paced by the display instead of the audio, and slightly "
+                                         "adjusts the audio rate to avoid crackling. Best combined with vsync.",
+                                         &s_settings_copy.audio_dynamic_sync, s_settings_copy.audio_sync_enabled);
         settings_changed |= ToggleButton(
           "Resampling",
           "When running outside of 100% speed, resamples audio from the target speed instead of dropping frames.",
@@ -1827,6 +1891,11 @@ void DrawSettingsWindow()
           "Use Debug GPU Device", "Enable debugging when supported by the host's renderer API. Only for developer use.",
           &s_settings_copy.gpu_use_debug_device);
 
+        settings_changed |= ToggleButton(
+          "Reorder GPU Batches",
+          "Draws non-overlapping primitives out of order to merge batches. Reduces draw calls on slow GPUs.",
+          &s_settings_copy.gpu_reorder_batches);
+
 #ifdef WIN32
         settings_changed |=
           ToggleButton("Increase Timer Resolution", "Enables more precise frame pacing at the cost of battery life.",
@@ -2517,40 +2586,188 @@ void SortGameList()
             [](const GameListEntry* lhs, const GameListEntry* rhs) { return lhs->title < rhs->title; });
 }
 
-HostDisplayTexture* GetGameListCover(const GameListEntry* entry)
+static std::string GetCoverThumbnailPath(const std::string& cover_path)
 {
-  // lookup and grab cover image
-  auto cover_it = s_cover_image_map.find(entry->path);
-  if (cover_it == s_cover_image_map.end())
+  u8 digest[16];
+  MD5Digest md5;
+  md5.Update(cover_path.data(), static_cast<u32>(cover_path.size()));
+  md5.Final(digest);
+
+  SmallString hash;
+  for (u8 byte : digest)
+    hash.AppendFormattedString("%02x", byte);
+
+  return s_host_interface->GetUserDirectoryRelativePath("cache" FS_OSPATH_SEPARATOR_STR "covers" FS_OSPATH_SEPARATOR_STR
+                                                        "%s.png",
+                                                        hash.GetCharArray());
+}
+
+static bool LoadCoverImage(const CoverLoadRequest& request, Common::RGBA8Image* image)
+{
+  GameListEntry entry = {};
+  entry.path = request.path;
+  entry.code = request.code;
+  entry.title = request.title;
+
+  const std::string cover_path(s_host_interface->GetGameList()->GetCoverImagePathForEntry(&entry));
+  if (cover_path.empty())
+    return false;
+
+  // use the cached thumbnail, as long as the cover hasn't been replaced since it was written
+  const std::string thumbnail_path(GetCoverThumbnailPath(cover_path));
+  FILESYSTEM_STAT_DATA cover_sd, thumbnail_sd;
+  if (FileSystem::StatFile(cover_path.c_str(), &cover_sd) &&
+      FileSystem::StatFile(thumbnail_path.c_str(), &thumbnail_sd) &&
+      thumbnail_sd.ModificationTime >= cover_sd.ModificationTime)
+  {
+    Log_DevPrintf("Loading cover thumbnail from '%s' for '%s'", thumbnail_path.c_str(), request.path.c_str());
+    if (Common::LoadImageFromFile(image, thumbnail_path.c_str()) && image->IsValid())
+      return true;
+
+    Log_WarningPrintf("Failed to load cover thumbnail from '%s'", thumbnail_path.c_str());
+  }
+
+  Log_DevPrintf("Trying to load cover from '%s' for '%s'", cover_path.c_str(), request.path.c_str());
+  if (!Common::LoadImageFromFile(image, cover_path.c_str()) || !image->IsValid())
+  {
+    Log_ErrorPrintf("Failed to load cover from '%s'", cover_path.c_str());
+    return false;
+  }
+
+  if (image->GetWidth() <= COVER_THUMBNAIL_SIZE && image->GetHeight() <= COVER_THUMBNAIL_SIZE)
+    return true;
+
+  // downscale, preserving the aspect ratio
+  const float scale =
+    static_cast<float>(COVER_THUMBNAIL_SIZE) / static_cast<float>(std::max(image->GetWidth(), image->GetHeight()));
+  const u32 thumbnail_width = std::max(static_cast<u32>(static_cast<float>(image->GetWidth()) * scale + 0.5f), 1u);
+  const u32 thumbnail_height = std::max(static_cast<u32>(static_cast<float>(image->GetHeight()) * scale + 0.5f), 1u);
+  if (!Common::ResizeImage(image, thumbnail_width, thumbnail_height))
+    return true;
+
+  const std::string thumbnail_dir(
+    s_host_interface->GetUserDirectoryRelativePath("cache" FS_OSPATH_SEPARATOR_STR "covers"));
+  if (!FileSystem::DirectoryExists(thumbnail_dir.c_str()) && !FileSystem::CreateDirectory(thumbnail_dir.c_str(), true))
+    Log_WarningPrintf("Failed to create cover thumbnail directory '%s'", thumbnail_dir.c_str());
+  else if (!Common::WriteImageToFile(*image, thumbnail_path.c_str()))
+    Log_WarningPrintf("Failed to write cover thumbnail to '%s'", thumbnail_path.c_str());
+
+  return true;
+}
+
+static void CoverLoadThread()
+{
+  std::unique_lock<std::mutex> lock(s_cover_load_mutex);
+  for (;;)
+  {
+    s_cover_load_cv.wait(lock, []() { return s_cover_load_thread_shutdown || !s_cover_load_requests.empty(); });
+    if (s_cover_load_thread_shutdown)
+      break;
+
+    // newest requests first, so covers which just scrolled into view aren't stuck behind ones which scrolled past
+    CoverLoadRequest request(std::move(s_cover_load_requests.back()));
+    s_cover_load_requests.pop_back();
+    lock.unlock();
+
+    CoverLoadResult result;
+    if (!LoadCoverImage(request, &result.image))
+      result.image.Invalidate();
+    result.path = std::move(request.path);
+
+    lock.lock();
+    s_cover_load_results.push_back(std::move(result));
+  }
+}
+
+void QueueCoverLoad(const GameListEntry* entry)
+{
+  std::unique_lock<std::mutex> lock(s_cover_load_mutex);
+  s_cover_load_requests.push_back(CoverLoadRequest{entry->path, entry->code, entry->title});
+  if (!s_cover_load_thread.joinable())
   {
-    const std::string cover_path(s_host_interface->GetGameList()->GetCoverImagePathForEntry(entry));
-    std::unique_ptr<HostDisplayTexture> texture;
-    if (!cover_path.empty())
+    s_cover_load_thread_shutdown = false;
+    s_cover_load_thread = std::thread(CoverLoadThread);
+  }
+
+  lock.unlock();
+  s_cover_load_cv.notify_one();
+}
+
+void UploadLoadedCovers()
+{
+  std::unique_lock<std::mutex> lock(s_cover_load_mutex);
+  if (s_cover_load_results.empty())
+    return;
+
+  // textures are created a few per frame, to avoid hitching when a whole page of covers finishes at once
+  const u32 count = std::min(static_cast<u32>(s_cover_load_results.size()), MAX_COVER_UPLOADS_PER_FRAME);
+  std::vector<CoverLoadResult> results(std::make_move_iterator(s_cover_load_results.begin()),
+                                       std::make_move_iterator(s_cover_load_results.begin() + count));
+  s_cover_load_results.erase(s_cover_load_results.begin(), s_cover_load_results.begin() + count);
+  lock.unlock();
+
+  for (CoverLoadResult& result : results)
+  {
+    auto cover_it = s_cover_image_map.find(result.path);
+    if (cover_it == s_cover_image_map.end() || !result.image.IsValid())
+      continue;
+
+    CoverImage& cover = cover_it->second;
+    cover.texture = s_host_interface->GetDisplay()->CreateTexture(
+      result.image.GetWidth(), result.image.GetHeight(), 1, 1, 1, HostDisplayPixelFormat::RGBA8,
+      result.image.GetPixels(), result.image.GetByteStride());
+    if (!cover.texture)
     {
-      Log_DevPrintf("Trying to load cover from '%s' for '%s'", cover_path.c_str(), entry->path.c_str());
+      Log_ErrorPrintf("Failed to upload %ux%u texture to GPU", result.image.GetWidth(), result.image.GetHeight());
+      continue;
+    }
 
-      Common::RGBA8Image image;
-      if (Common::LoadImageFromFile(&image, cover_path.c_str()) || !image.IsValid())
-      {
-        texture = s_host_interface->GetDisplay()->CreateTexture(image.GetWidth(), image.GetHeight(), 1, 1, 1,
-                                                                HostDisplayPixelFormat::RGBA8, image.GetPixels(),
-                                                                image.GetByteStride());
-        if (!texture)
-          Log_ErrorPrintf("Failed to upload %ux%u texture to GPU", image.GetWidth(), image.GetHeight());
-      }
-      else
-      {
-        Log_ErrorPrintf("Failed to load cover from '%s'", cover_path.c_str());
-      }
+    cover.lru_it = s_cover_image_lru.insert(s_cover_image_lru.begin(), cover_it->first);
+
+    // drop the least recently drawn cover, it'll be reloaded from the thumbnail cache if it comes back into view
+    if (s_cover_image_lru.size() > MAX_COVER_TEXTURES)
+    {
+      s_cover_image_map.erase(s_cover_image_lru.back());
+      s_cover_image_lru.pop_back();
+    }
+  }
+}
+
+void ShutdownCoverLoader()
+{
+  if (s_cover_load_thread.joinable())
+  {
+    {
+      std::unique_lock<std::mutex> lock(s_cover_load_mutex);
+      s_cover_load_thread_shutdown = true;
     }
 
-    cover_it = s_cover_image_map.emplace(entry->path, std::move(texture)).first;
+    s_cover_load_cv.notify_one();
+    s_cover_load_thread.join();
+  }
+
+  s_cover_load_requests.clear();
+  s_cover_load_results.clear();
+  s_cover_image_lru.clear();
+  s_cover_image_map.clear();
+}
+
+HostDisplayTexture* GetGameListCover(const GameListEntry* entry)
+{
+  // lookup and grab cover image, falling back to the placeholder while it loads
+  auto cover_it = s_cover_image_map.find(entry->path);
+  if (cover_it == s_cover_image_map.end())
+  {
+    cover_it = s_cover_image_map.emplace(entry->path, CoverImage()).first;
+    QueueCoverLoad(entry);
   }
 
-  if (cover_it->second)
-    return cover_it->second.get();
+  CoverImage& cover = cover_it->second;
+  if (!cover.texture)
+    return GetTextureForGameListEntryType(entry->type);
 
-  return GetTextureForGameListEntryType(entry->type);
+  s_cover_image_lru.splice(s_cover_image_lru.begin(), s_cover_image_lru, cover.lru_it);
+  return cover.texture.get();
 }
 
 HostDisplayTexture* GetTextureForGameListEntryType(GameListEntryType type)
@@ -2597,7 +2814,8 @@ static ImDrawList* GetDrawListForOverlay()
 void DrawStatsOverlay()
 {
   if (!(g_settings.display_show_fps || g_settings.display_show_vps || g_settings.display_show_speed ||
-        g_settings.display_show_resolution || System::IsPaused() || s_host_interface->IsFastForwardEnabled() ||
+        g_settings.display_show_resolution || g_settings.display_show_frame_timings || System::IsPaused() ||
+        s_host_interface->IsFastForwardEnabled() ||
         s_host_interface->IsTurboEnabled()))
   {
     return;
@@ -2660,6 +2878,17 @@ void DrawStatsOverlay()
       DRAW_LINE(g_large_font, g_large_font->FontSize, 0.0f, IM_COL32(255, 255, 255, 255));
     }
 
+    if (g_settings.display_show_frame_timings)
+    {
+      for (u32 i = 0; i < static_cast<u32>(System::FrameTimingComponent::Count); i++)
+      {
+        const System::FrameTimingComponent component = static_cast<System::FrameTimingComponent>(i);
+        text.Format("%s: %.2fms", System::GetFrameTimingComponentName(component),
+                    System::GetAverageFrameTiming(component));
+        DRAW_LINE(g_medium_font, g_medium_font->FontSize, 0.0f, IM_COL32(255, 255, 255, 255));
+      }
+    }
+
     if (s_host_interface->IsFastForwardEnabled() || s_host_interface->IsTurboEnabled())
     {
       text.Assign(ICON_FA_FAST_FORWARD);
@@ -3153,6 +3382,8 @@ void DrawDebugSettingsMenu()
   }
 
   settings_changed |= ImGui::MenuItem("Recompiler ICache", nullptr, &s_settings_copy.cpu_recompiler_icache);
+  settings_changed |=
+    ImGui::MenuItem("Recompiler Block Profiling", nullptr, &s_settings_copy.cpu_recompiler_block_profiling);
 
   ImGui::Separator();
 
@@ -3360,6 +3591,59 @@ void DrawDebugSettingsMenu()
       s_host_interface->StopDumpingAudio();
   }
 
+  if (ImGui::MenuItem("Capture Trace", nullptr, s_host_interface->IsCapturingTrace(), System::IsValid()))
+  {
+    if (!s_host_interface->IsCapturingTrace())
+      s_host_interface->StartTraceCapture();
+    else
+      s_host_interface->StopTraceCapture();
+  }
+
+  if (ImGui::MenuItem("Record GPU Dump", nullptr, s_host_interface->IsRecordingGPUDump(), System::IsValid()))
+  {
+    if (!s_host_interface->IsRecordingGPUDump())
+      s_host_interface->StartGPUDump();
+    else
+      s_host_interface->StopGPUDump();
+  }
+
+  if (ImGui::MenuItem("Dump Block Profile", nullptr, false,
+                      System::IsValid() && g_settings.cpu_recompiler_block_profiling))
+  {
+    s_host_interface->DumpBlockProfile();
+  }
+
+  if (ImGui::MenuItem("Record Input Movie", nullptr, s_host_interface->IsRecordingInputMovie(),
+                      System::IsValid() && !s_host_interface->IsPlayingInputMovie()))
+  {
+    if (!s_host_interface->IsRecordingInputMovie())
+      s_host_interface->StartInputMovieRecording();
+    else
+      s_host_interface->StopInputMovieRecording();
+  }
+
+  if (ImGui::MenuItem("Play Input Movie", nullptr, s_host_interface->IsPlayingInputMovie(),
+                      System::IsValid() && !s_host_interface->IsRecordingInputMovie()))
+  {
+    if (!s_host_interface->IsPlayingInputMovie())
+    {
+      auto callback = [](const std::string& path) {
+        if (!path.empty())
+          s_host_interface->RunLater([path]() { s_host_interface->StartInputMoviePlayback(path.c_str()); });
+
+        ClearImGuiFocus();
+        CloseFileSelector();
+      };
+
+      OpenFileSelector(ICON_FA_FILM "  Select Input Movie", false, std::move(callback), {"*.psxmovie"},
+                       s_host_interface->GetUserDirectoryRelativePath("movies"));
+    }
+    else
+    {
+      s_host_interface->StopInputMoviePlayback();
+    }
+  }
+
   if (ImGui::MenuItem("Save Screenshot"))
     s_host_interface->RunLater([]() { s_host_interface->SaveScreenshot(); });
 
@@ -14,9 +14,14 @@
 #include "core/system.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
+#include <mutex>
 #include <string_view>
+#include <thread>
 #include <tinyxml2.h>
+#include <unordered_set>
 #include <utility>
 Log_SetChannel(GameList);
 
@@ -90,6 +95,7 @@ bool GameList::GetExeListEntry(const char* path, GameListEntry* entry)
   entry->path = path;
   entry->region = BIOS::GetPSExeDiscRegion(header);
   entry->total_size = ZeroExtend64(file_size);
+  entry->file_size = ffd.Size;
   entry->last_modified_time = ffd.ModificationTime.AsUnixTimestamp();
   entry->type = GameListEntryType::PSExe;
   entry->compatibility_rating = GameListCompatibilityRating::Unknown;
@@ -111,6 +117,7 @@ bool GameList::GetPsfListEntry(const char* path, GameListEntry* entry)
   entry->path = path;
   entry->region = file.GetRegion();
   entry->total_size = ffd.Size;
+  entry->file_size = ffd.Size;
   entry->last_modified_time = ffd.ModificationTime.AsUnixTimestamp();
   entry->type = GameListEntryType::PSF;
   entry->compatibility_rating = GameListCompatibilityRating::Unknown;
@@ -151,6 +158,7 @@ bool GameList::GetM3UListEntry(const char* path, GameListEntry* entry)
   entry->path = path;
   entry->region = DiscRegion::Other;
   entry->total_size = 0;
+  entry->file_size = ffd.Size;
   entry->last_modified_time = ffd.ModificationTime.AsUnixTimestamp();
   entry->type = GameListEntryType::Playlist;
   entry->compatibility_rating = GameListCompatibilityRating::Unknown;
@@ -248,19 +256,25 @@ bool GameList::GetGameListEntry(const std::string& path, GameListEntry* entry)
   if (!FileSystem::StatFile(path.c_str(), &ffd))
     return false;
 
+  entry->file_size = ffd.Size;
   entry->last_modified_time = ffd.ModificationTime.AsUnixTimestamp();
   return true;
 }
 
-bool GameList::GetGameListEntryFromCache(const std::string& path, GameListEntry* entry)
+bool GameList::GetGameListEntryFromCache(const std::string& path, u64 file_size, u64 last_modified_time,
+                                         GameListEntry* entry)
 {
   auto iter = m_cache_map.find(path);
   if (iter == m_cache_map.end())
     return false;
 
-  *entry = std::move(iter->second);
+  // the file has to be re-probed if it's changed since it was cached
+  const bool valid = (iter->second.file_size == file_size && iter->second.last_modified_time == last_modified_time);
+  if (valid)
+    *entry = std::move(iter->second);
+
   m_cache_map.erase(iter);
-  return true;
+  return valid;
 }
 
 void GameList::LoadCache()
@@ -348,14 +362,15 @@ bool GameList::LoadEntriesFromCache(ByteStream* stream)
     std::string code;
     std::string title;
     u64 total_size;
+    u64 file_size;
     u64 last_modified_time;
     u8 region;
     u8 type;
     u8 compatibility_rating;
 
     if (!ReadString(stream, &path) || !ReadString(stream, &code) || !ReadString(stream, &title) ||
-        !ReadU64(stream, &total_size) || !ReadU64(stream, &last_modified_time) || !ReadU8(stream, &region) ||
-        region >= static_cast<u8>(DiscRegion::Count) || !ReadU8(stream, &type) ||
+        !ReadU64(stream, &total_size) || !ReadU64(stream, &file_size) || !ReadU64(stream, &last_modified_time) ||
+        !ReadU8(stream, &region) || region >= static_cast<u8>(DiscRegion::Count) || !ReadU8(stream, &type) ||
         type >= static_cast<u8>(GameListEntryType::Count) || !ReadU8(stream, &compatibility_rating) ||
         compatibility_rating >= static_cast<u8>(GameListCompatibilityRating::Count))
     {
@@ -368,6 +383,7 @@ bool GameList::LoadEntriesFromCache(ByteStream* stream)
     ge.code = std::move(code);
     ge.title = std::move(title);
     ge.total_size = total_size;
+    ge.file_size = file_size;
     ge.last_modified_time = last_modified_time;
     ge.region = static_cast<DiscRegion>(region);
     ge.type = static_cast<GameListEntryType>(type);
@@ -426,6 +442,7 @@ bool GameList::WriteEntryToCache(const GameListEntry* entry, ByteStream* stream)
   result &= WriteString(stream, entry->code);
   result &= WriteString(stream, entry->title);
   result &= WriteU64(stream, entry->total_size);
+  result &= WriteU64(stream, entry->file_size);
   result &= WriteU64(stream, entry->last_modified_time);
   result &= WriteU8(stream, static_cast<u8>(entry->region));
   result &= WriteU8(stream, static_cast<u8>(entry->type));
@@ -492,14 +509,18 @@ void GameList::ScanDirectory(const char* path, bool recursive, ProgressCallback*
   FileSystem::FindResultsArray files;
   FileSystem::FindFiles(path, "*", FILESYSTEM_FIND_FILES | (recursive ? FILESYSTEM_FIND_RECURSIVE : 0), &files);
 
-  GameListEntry entry;
   progress->SetProgressRange(static_cast<u32>(files.size()));
   progress->SetProgressValue(0);
 
+  std::unordered_set<std::string> known_paths;
+  for (const GameListEntry& it : m_entries)
+    known_paths.insert(it.path);
+
+  // files which are unchanged since they were cached can be added without opening them
+  std::vector<const FILESYSTEM_FIND_DATA*> files_to_probe;
+  GameListEntry entry;
   for (const FILESYSTEM_FIND_DATA& ffd : files)
   {
-    progress->IncrementProgressValue();
-
     // if this is a .bin, check if we have a .cue. if there is one, skip it
     const char* extension = std::strrchr(ffd.FileName.c_str(), '.');
     if (extension && StringUtil::Strcasecmp(extension, ".bin") == 0)
@@ -514,47 +535,128 @@ void GameList::ScanDirectory(const char* path, bool recursive, ProgressCallback*
         continue;
       }
 #else
+      progress->IncrementProgressValue();
       continue;
 #endif
     }
 
-    std::string entry_path(ffd.FileName);
-    if (std::any_of(m_entries.begin(), m_entries.end(),
-                    [&entry_path](const GameListEntry& other) { return other.path == entry_path; }))
+    if (!known_paths.insert(ffd.FileName).second)
     {
+      progress->IncrementProgressValue();
       continue;
     }
-    Log_DebugPrintf("Trying '%s'...", entry_path.c_str());
 
-    // try opening the image
-    if (!GetGameListEntryFromCache(entry_path, &entry) ||
-        entry.last_modified_time != ffd.ModificationTime.AsUnixTimestamp())
+    if (!GetGameListEntryFromCache(ffd.FileName, ffd.Size, ffd.ModificationTime.AsUnixTimestamp(), &entry))
+    {
+      files_to_probe.push_back(&ffd);
+      continue;
+    }
+
+    m_entries.push_back(std::move(entry));
+    entry = {};
+    progress->IncrementProgressValue();
+  }
+
+  if (!files_to_probe.empty())
+    ProbeFiles(files_to_probe, progress);
+
+  progress->SetProgressValue(static_cast<u32>(files.size()));
+  progress->PopState();
+}
+
+void GameList::ProbeFiles(const std::vector<const FILESYSTEM_FIND_DATA*>& files, ProgressCallback* progress)
+{
+  // the workers only read these, so they have to be loaded up front
+  LoadDatabase();
+  LoadCompatibilityList();
+  LoadGameSettings();
+
+  const u32 file_count = static_cast<u32>(files.size());
+  const u32 worker_count = std::min(std::max(std::thread::hardware_concurrency(), 1u), file_count);
+  Log_DevPrintf("Probing %u files with %u threads", file_count, worker_count);
+
+  std::vector<GameListEntry> entries(file_count);
+  std::atomic<u32> next_index{0};
+  std::atomic_bool cancelled{false};
+
+  std::mutex mutex;
+  std::condition_variable completed_cv;
+  std::vector<std::pair<u32, bool>> completed;
+  u32 active_workers = worker_count;
+
+  auto worker_entry_point = [&]() {
+    for (;;)
+    {
+      const u32 index = next_index.fetch_add(1);
+      if (index >= file_count || cancelled.load())
+        break;
+
+      Log_DebugPrintf("Trying '%s'...", files[index]->FileName.c_str());
+      const bool result = GetGameListEntry(files[index]->FileName, &entries[index]);
+
+      std::unique_lock<std::mutex> lock(mutex);
+      completed.emplace_back(index, result);
+      completed_cv.notify_one();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    active_workers--;
+    completed_cv.notify_one();
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count);
+  for (u32 i = 0; i < worker_count; i++)
+    workers.emplace_back(worker_entry_point);
+
+  // entries are published and cached from this thread as they complete, since the progress callback isn't thread safe
+  std::vector<std::pair<u32, bool>> to_publish;
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;)
+  {
+    completed_cv.wait(lock, [&]() { return (!completed.empty() || active_workers == 0); });
+    if (completed.empty())
+      break;
+
+    to_publish.swap(completed);
+    lock.unlock();
+
+    for (const auto& [index, result] : to_publish)
     {
+      const FILESYSTEM_FIND_DATA* ffd = files[index];
+      GameListEntry& entry = entries[index];
+      progress->IncrementProgressValue();
+
       const char* file_part_slash =
-        std::max(std::strrchr(entry_path.c_str(), '/'), std::strrchr(entry_path.c_str(), '\\'));
+        std::max(std::strrchr(ffd->FileName.c_str(), '/'), std::strrchr(ffd->FileName.c_str(), '\\'));
       progress->SetFormattedStatusText("Scanning '%s'...",
-                                       file_part_slash ? (file_part_slash + 1) : entry_path.c_str());
+                                       file_part_slash ? (file_part_slash + 1) : ffd->FileName.c_str());
 
-      if (GetGameListEntry(entry_path, &entry))
-      {
-        if (m_cache_write_stream || OpenCacheForWriting())
-        {
-          if (!WriteEntryToCache(&entry, m_cache_write_stream.get()))
-            Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
-        }
-      }
-      else
-      {
+      if (!result)
         continue;
+
+      // key the cache on what we saw when listing the directory, so it matches on the next scan
+      entry.file_size = ffd->Size;
+      entry.last_modified_time = ffd->ModificationTime.AsUnixTimestamp();
+      if (m_cache_write_stream || OpenCacheForWriting())
+      {
+        if (!WriteEntryToCache(&entry, m_cache_write_stream.get()))
+          Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
       }
+
+      m_entries.push_back(std::move(entry));
     }
 
-    m_entries.push_back(std::move(entry));
-    entry = {};
+    to_publish.clear();
+    if (progress->IsCancelled())
+      cancelled.store(true);
+
+    lock.lock();
   }
+  lock.unlock();
 
-  progress->SetProgressValue(static_cast<u32>(files.size()));
-  progress->PopState();
+  for (std::thread& worker : workers)
+    worker.join();
 }
 
 class GameList::RedumpDatVisitor final : public tinyxml2::XMLVisitor
@@ -11,6 +11,7 @@
 class CDImage;
 class ByteStream;
 class ProgressCallback;
+struct FILESYSTEM_FIND_DATA;
 
 class SettingsInterface;
 
@@ -47,6 +48,7 @@ struct GameListEntry
   std::string code;
   std::string title;
   u64 total_size;
+  u64 file_size;
   u64 last_modified_time;
   DiscRegion region;
   GameListEntryType type;
@@ -130,7 +132,7 @@ private:
   enum : u32
   {
     GAME_LIST_CACHE_SIGNATURE = 0x45434C47,
-    GAME_LIST_CACHE_VERSION = 22
+    GAME_LIST_CACHE_VERSION = 23
   };
 
   using DatabaseMap = std::unordered_map<std::string, GameListDatabaseEntry>;
@@ -147,9 +149,13 @@ private:
   bool GetM3UListEntry(const char* path, GameListEntry* entry);
 
   bool GetGameListEntry(const std::string& path, GameListEntry* entry);
-  bool GetGameListEntryFromCache(const std::string& path, GameListEntry* entry);
+  bool GetGameListEntryFromCache(const std::string& path, u64 file_size, u64 last_modified_time,
+                                 GameListEntry* entry);
   void ScanDirectory(const char* path, bool recursive, ProgressCallback* progress);
 
+  /// Opens each file on a pool of worker threads, adding the entries to the list and cache as they complete.
+  void ProbeFiles(const std::vector<const FILESYSTEM_FIND_DATA*>& files, ProgressCallback* progress);
+
   void LoadCache();
   bool LoadEntriesFromCache(ByteStream* stream);
   bool OpenCacheForWriting();
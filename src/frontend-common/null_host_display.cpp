@@ -0,0 +1,166 @@
+#include "null_host_display.h"
+
+namespace FrontendCommon {
+
+NullHostDisplay::NullHostDisplay() = default;
+
+NullHostDisplay::~NullHostDisplay() = default;
+
+HostDisplay::RenderAPI NullHostDisplay::GetRenderAPI() const
+{
+  return RenderAPI::None;
+}
+
+void* NullHostDisplay::GetRenderDevice() const
+{
+  return nullptr;
+}
+
+void* NullHostDisplay::GetRenderContext() const
+{
+  return nullptr;
+}
+
+bool NullHostDisplay::HasRenderDevice() const
+{
+  return true;
+}
+
+bool NullHostDisplay::HasRenderSurface() const
+{
+  return false;
+}
+
+bool NullHostDisplay::CreateRenderDevice(const WindowInfo& wi, std::string_view adapter_name, bool debug_device,
+                                         bool threaded_presentation)
+{
+  m_window_info = wi;
+  return true;
+}
+
+bool NullHostDisplay::InitializeRenderDevice(std::string_view shader_cache_directory, bool debug_device,
+                                             bool threaded_presentation)
+{
+  return true;
+}
+
+void NullHostDisplay::DestroyRenderDevice()
+{
+  m_display_pixels = {};
+}
+
+bool NullHostDisplay::MakeRenderContextCurrent()
+{
+  return true;
+}
+
+bool NullHostDisplay::DoneRenderContextCurrent()
+{
+  return true;
+}
+
+bool NullHostDisplay::ChangeRenderWindow(const WindowInfo& new_wi)
+{
+  m_window_info = new_wi;
+  return true;
+}
+
+void NullHostDisplay::ResizeRenderWindow(s32 new_window_width, s32 new_window_height)
+{
+  m_window_info.surface_width = static_cast<u32>(new_window_width);
+  m_window_info.surface_height = static_cast<u32>(new_window_height);
+}
+
+bool NullHostDisplay::SupportsFullscreen() const
+{
+  return false;
+}
+
+bool NullHostDisplay::IsFullscreen()
+{
+  return false;
+}
+
+bool NullHostDisplay::SetFullscreen(bool fullscreen, u32 width, u32 height, float refresh_rate)
+{
+  return false;
+}
+
+void NullHostDisplay::DestroyRenderSurface() {}
+
+bool NullHostDisplay::SetPostProcessingChain(const std::string_view& config)
+{
+  return config.empty();
+}
+
+std::unique_ptr<HostDisplayTexture> NullHostDisplay::CreateTexture(u32 width, u32 height, u32 layers, u32 levels,
+                                                                   u32 samples, HostDisplayPixelFormat format,
+                                                                   const void* data, u32 data_stride,
+                                                                   bool dynamic /* = false */)
+{
+  return {};
+}
+
+void NullHostDisplay::UpdateTexture(HostDisplayTexture* texture, u32 x, u32 y, u32 width, u32 height,
+                                    const void* texture_data, u32 texture_data_stride)
+{
+}
+
+bool NullHostDisplay::DownloadTexture(const void* texture_handle, HostDisplayPixelFormat texture_format, u32 x, u32 y,
+                                      u32 width, u32 height, void* out_data, u32 out_data_stride)
+{
+  return false;
+}
+
+bool NullHostDisplay::SupportsDisplayPixelFormat(HostDisplayPixelFormat format) const
+{
+  return (format != HostDisplayPixelFormat::Unknown && format != HostDisplayPixelFormat::Count);
+}
+
+bool NullHostDisplay::BeginSetDisplayPixels(HostDisplayPixelFormat format, u32 width, u32 height, void** out_buffer,
+                                            u32* out_pitch)
+{
+  const u32 pitch = width * GetDisplayPixelFormatSize(format);
+  const size_t required_size = static_cast<size_t>(pitch) * height;
+  if (m_display_pixels.size() < required_size)
+    m_display_pixels.resize(required_size);
+
+  *out_buffer = m_display_pixels.data();
+  *out_pitch = pitch;
+  return true;
+}
+
+void NullHostDisplay::EndSetDisplayPixels() {}
+
+bool NullHostDisplay::GetHostRefreshRate(float* refresh_rate)
+{
+  return false;
+}
+
+void NullHostDisplay::SetVSync(bool enabled) {}
+
+bool NullHostDisplay::Render()
+{
+  return true;
+}
+
+bool NullHostDisplay::CreateResources()
+{
+  return true;
+}
+
+void NullHostDisplay::DestroyResources() {}
+
+bool NullHostDisplay::CreateImGuiContext()
+{
+  return true;
+}
+
+void NullHostDisplay::DestroyImGuiContext() {}
+
+bool NullHostDisplay::UpdateImGuiFontTexture()
+{
+  return true;
+}
+
+} // namespace FrontendCommon
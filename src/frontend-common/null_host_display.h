@@ -0,0 +1,71 @@
+#pragma once
+#include "core/host_display.h"
+#include <memory>
+#include <vector>
+
+namespace FrontendCommon {
+
+/// Display which accepts frames but never presents them, for running without a window or GPU.
+class NullHostDisplay final : public HostDisplay
+{
+public:
+  NullHostDisplay();
+  ~NullHostDisplay();
+
+  RenderAPI GetRenderAPI() const override;
+  void* GetRenderDevice() const override;
+  void* GetRenderContext() const override;
+
+  bool HasRenderDevice() const override;
+  bool HasRenderSurface() const override;
+
+  bool CreateRenderDevice(const WindowInfo& wi, std::string_view adapter_name, bool debug_device,
+                          bool threaded_presentation) override;
+  bool InitializeRenderDevice(std::string_view shader_cache_directory, bool debug_device,
+                              bool threaded_presentation) override;
+  void DestroyRenderDevice() override;
+
+  bool MakeRenderContextCurrent() override;
+  bool DoneRenderContextCurrent() override;
+
+  bool ChangeRenderWindow(const WindowInfo& new_wi) override;
+  void ResizeRenderWindow(s32 new_window_width, s32 new_window_height) override;
+  bool SupportsFullscreen() const override;
+  bool IsFullscreen() override;
+  bool SetFullscreen(bool fullscreen, u32 width, u32 height, float refresh_rate) override;
+  void DestroyRenderSurface() override;
+
+  bool SetPostProcessingChain(const std::string_view& config) override;
+
+  std::unique_ptr<HostDisplayTexture> CreateTexture(u32 width, u32 height, u32 layers, u32 levels, u32 samples,
+                                                    HostDisplayPixelFormat format, const void* data, u32 data_stride,
+                                                    bool dynamic = false) override;
+  void UpdateTexture(HostDisplayTexture* texture, u32 x, u32 y, u32 width, u32 height, const void* texture_data,
+                     u32 texture_data_stride) override;
+  bool DownloadTexture(const void* texture_handle, HostDisplayPixelFormat texture_format, u32 x, u32 y, u32 width,
+                       u32 height, void* out_data, u32 out_data_stride) override;
+  bool SupportsDisplayPixelFormat(HostDisplayPixelFormat format) const override;
+  bool BeginSetDisplayPixels(HostDisplayPixelFormat format, u32 width, u32 height, void** out_buffer,
+                             u32* out_pitch) override;
+  void EndSetDisplayPixels() override;
+
+  bool GetHostRefreshRate(float* refresh_rate) override;
+
+  void SetVSync(bool enabled) override;
+
+  bool Render() override;
+
+protected:
+  bool CreateResources() override;
+  void DestroyResources() override;
+
+  bool CreateImGuiContext() override;
+  void DestroyImGuiContext() override;
+  bool UpdateImGuiFontTexture() override;
+
+private:
+  // Frames are still written here, so software rendering does the same amount of work as with a real display.
+  std::vector<u8> m_display_pixels;
+};
+
+} // namespace FrontendCommon
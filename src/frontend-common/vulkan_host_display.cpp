@@ -353,6 +353,13 @@ bool VulkanHostDisplay::HasRenderSurface() const
 
 VkRenderPass VulkanHostDisplay::GetRenderPassForDisplay() const
 {
+  // Without a swap chain nothing is displayed, but the pipelines still need a render pass to be created with.
+  if (!m_swap_chain)
+  {
+    return g_vulkan_context->GetRenderPass(VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_UNDEFINED, VK_SAMPLE_COUNT_1_BIT,
+                                           VK_ATTACHMENT_LOAD_OP_CLEAR);
+  }
+
   return m_swap_chain->GetClearRenderPass();
 }
 
@@ -585,6 +592,16 @@ bool VulkanHostDisplay::Render()
     return false;
   }
 
+  // Surfaceless, e.g. headless. There's nothing to present to, but the frame's rendering still has to be submitted.
+  if (!m_swap_chain)
+  {
+    if (ImGui::GetCurrentContext())
+      ImGui::Render();
+
+    g_vulkan_context->ExecuteCommandBuffer(false);
+    return false;
+  }
+
   // Previous frame needs to be presented before we can acquire the swap chain.
   g_vulkan_context->WaitForPresentComplete();
 